@@ -25,7 +25,12 @@ public class OptimizationHelper : ModuleRules
             "BlueprintGraph",      // ← ДОБАВИТЬ для работы с BP
             "Kismet",              // ← ДОБАВИТЬ для Blueprint
             "KismetCompiler",      // ← ДОБАВИТЬ для анализа BP
-            "GraphEditor"          // ← ДОБАВИТЬ для EdGraph
+            "GraphEditor",         // ← ДОБАВИТЬ для EdGraph
+            "Json",                // Commandlet report
+            "RHI",                 // Renderer draw call counters
+            "RenderCore",          // Thread times (stat unit)
+            "Niagara",             // Particle system check
+            "MaterialEditor"       // Compiled shader statistics
         });
     }
 }
\ No newline at end of file
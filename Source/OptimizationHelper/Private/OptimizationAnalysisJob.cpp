@@ -0,0 +1,598 @@
+#include "OptimizationAnalysisJob.h"
+#include "OptimizationCheckPass.h"
+#include "OptimizationScanProfile.h"
+#include "Editor.h"
+#include "Algo/Count.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformMemory.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+#define LOCTEXT_NAMESPACE "OptimizationAnalysisJob"
+
+FOptimizationAnalysisJob::FOptimizationAnalysisJob(UOptimizationAnalyzer* InAnalyzer, TArray<TSharedRef<FOptimizationCheckPassBase>>&& InPasses)
+    : Analyzer(InAnalyzer)
+    , Passes(MoveTemp(InPasses))
+{
+    // Split every pass into chunks; each chunk is one read task and one evaluate task
+    for (int32 PassIndex = 0; PassIndex < Passes.Num(); ++PassIndex)
+    {
+        const int32 NumAssets = Passes[PassIndex]->Assets.Num();
+        TotalCount += NumAssets;
+
+        for (int32 Begin = 0; Begin < NumAssets; Begin += ChunkSize)
+        {
+            FChunk& Chunk = Chunks.AddDefaulted_GetRef();
+            Chunk.PassIndex = PassIndex;
+            Chunk.Begin = Begin;
+            Chunk.End = FMath::Min(Begin + ChunkSize, NumAssets);
+            Chunk.bLastInPass = (Chunk.End == NumAssets);
+        }
+
+        // Passes without assets still report their pass-wide issues
+        if (NumAssets == 0)
+        {
+            FChunk& Chunk = Chunks.AddDefaulted_GetRef();
+            Chunk.PassIndex = PassIndex;
+            Chunk.bLastInPass = true;
+        }
+    }
+
+    // Progress counts assets once their metrics are known; unchanged ones already are
+    for (const TSharedRef<FOptimizationCheckPassBase>& Pass : Passes)
+    {
+        ProcessedCount += (int32)Algo::CountIf(Pass->Sources, [](EOptimizationMetricsSource Source)
+            {
+                return Source != EOptimizationMetricsSource::Pending;
+            });
+    }
+
+    LoadAssetIndex = Chunks.Num() > 0 ? Chunks[0].Begin : 0;
+    BaselineMemoryUsed = FPlatformMemory::GetStats().UsedPhysical;
+
+    // The profile was reset when the passes were made (their registry queries are already in it)
+    ResolveProfileCounters();
+
+    // Registry parsing doesn't need the game thread, start it right away
+    if (Analyzer->bMetadataOnlyScan)
+    {
+        for (FChunk& Chunk : Chunks)
+        {
+            FOptimizationCheckPassBase* Pass = &Passes[Chunk.PassIndex].Get();
+            const int32 Begin = Chunk.Begin;
+            const int32 End = Chunk.End;
+
+            Chunk.ReadTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Pass, Begin, End]()
+                {
+                    OPTIMIZATION_PROFILE_SCOPE(ReadScope, *ReadCounter, End - Begin);
+
+                    for (int32 Index = Begin; Index < End && !bCancelRequested.load(std::memory_order_relaxed); ++Index)
+                    {
+                        if (Pass->Sources[Index] != EOptimizationMetricsSource::Pending) continue;
+
+                        Pass->ReadMetadata(Index);
+                        if (Pass->Sources[Index] != EOptimizationMetricsSource::Pending)
+                        {
+                            ProcessedCount.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }
+                });
+        }
+    }
+}
+
+FOptimizationAnalysisJob::FOptimizationAnalysisJob(UOptimizationAnalyzer* InAnalyzer, UWorld* InWorld)
+    : Analyzer(InAnalyzer)
+    , World(InWorld)
+{
+    LevelState = MakeUnique<FOptimizationLevelScanState>();
+
+    Analyzer->GetScanProfile().Reset();
+    ResolveProfileCounters();
+
+    if (InWorld)
+    {
+        LevelState->WorldName = InWorld->GetName();
+
+        // Snapshot the actor list, the actors themselves are visited over several frames
+        for (TActorIterator<AActor> ActorItr(InWorld); ActorItr; ++ActorItr)
+        {
+            Actors.Add(*ActorItr);
+        }
+    }
+
+    TotalCount = Actors.Num();
+}
+
+FOptimizationAnalysisJob::~FOptimizationAnalysisJob()
+{
+    // Tasks reference the passes and this job, so they must be done before we go away
+    bCancelRequested = true;
+
+    for (const FChunk& Chunk : Chunks)
+    {
+        Chunk.ReadTask.Wait();
+        Chunk.EvaluateTask.Wait();
+    }
+
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    }
+}
+
+TSharedRef<FOptimizationAnalysisJob> FOptimizationAnalysisJob::StartProjectAnalysis(UOptimizationAnalyzer* Analyzer)
+{
+    check(Analyzer);
+
+    TSharedRef<FOptimizationAnalysisJob> Job = MakeShared<FOptimizationAnalysisJob>(Analyzer, Analyzer->MakeProjectPasses());
+    Job->Start();
+    return Job;
+}
+
+TSharedRef<FOptimizationAnalysisJob> FOptimizationAnalysisJob::StartLevelAnalysis(UOptimizationAnalyzer* Analyzer)
+{
+    check(Analyzer);
+
+    UWorld* EditorWorld = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (!EditorWorld)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("No level is currently opened"));
+    }
+    else
+    {
+        UE_LOG(LogTemp, Log, TEXT("Analyzing current level: %s"), *EditorWorld->GetName());
+    }
+
+    TSharedRef<FOptimizationAnalysisJob> Job = MakeShared<FOptimizationAnalysisJob>(Analyzer, EditorWorld);
+    Job->Start();
+    return Job;
+}
+
+void FOptimizationAnalysisJob::Start()
+{
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateSP(this, &FOptimizationAnalysisJob::OnTicker)
+    );
+}
+
+bool FOptimizationAnalysisJob::OnTicker(float DeltaTime)
+{
+    const bool bDone = Step(TickBudgetSeconds, false);
+    if (bDone)
+    {
+        TickerHandle.Reset();
+    }
+    return !bDone;
+}
+
+void FOptimizationAnalysisJob::RunToCompletion()
+{
+    while (!Step(TNumericLimits<double>::Max(), true))
+    {
+    }
+}
+
+void FOptimizationAnalysisJob::Cancel()
+{
+    bCancelRequested = true;
+}
+
+float FOptimizationAnalysisJob::GetProgress() const
+{
+    if (bFinished) return 1.0f;
+    return TotalCount > 0 ? (float)GetProcessedCount() / TotalCount : 0.0f;
+}
+
+FText FOptimizationAnalysisJob::GetCurrentTask() const
+{
+    if (bCancelRequested)
+    {
+        return LOCTEXT("TaskCancelling", "Cancelling...");
+    }
+
+    if (LevelState.IsValid())
+    {
+        return FText::Format(
+            LOCTEXT("TaskLevel", "Scanning level actors {0}/{1}"),
+            FText::AsNumber(GetProcessedCount()),
+            FText::AsNumber(TotalCount)
+        );
+    }
+
+    const FString PassName = Chunks.IsValidIndex(LoadChunkIndex) ? Passes[Chunks[LoadChunkIndex].PassIndex]->Name : FString(TEXT("Project"));
+    return FText::Format(
+        LOCTEXT("TaskProject", "Analyzing assets {0}/{1} ({2})"),
+        FText::AsNumber(GetProcessedCount()),
+        FText::AsNumber(TotalCount),
+        FText::FromString(PassName)
+    );
+}
+
+void FOptimizationAnalysisJob::ConsumeNewIssues(TArray<FOptimizationIssue>& OutIssues)
+{
+    OutIssues.Append(MoveTemp(PendingIssues));
+    PendingIssues.Reset();
+}
+
+bool FOptimizationAnalysisJob::Step(double TimeBudgetSeconds, bool bBlocking)
+{
+    check(IsInGameThread());
+
+    if (bFinished)
+    {
+        return true;
+    }
+
+    const double EndTime = FPlatformTime::Seconds() + TimeBudgetSeconds;
+
+    if (LevelState.IsValid())
+    {
+        StepLevel(EndTime);
+    }
+    else
+    {
+        StepProject(EndTime, bBlocking);
+    }
+
+    if (bCancelRequested && (bBlocking || AreTasksCompleted()))
+    {
+        Finish();
+    }
+
+    return bFinished;
+}
+
+void FOptimizationAnalysisJob::StepProject(double EndTime, bool bBlocking)
+{
+    const bool bMetadataOnly = Analyzer->bMetadataOnlyScan;
+    const bool bAllowLoading = !bMetadataOnly || Analyzer->bLoadAssetsWithoutMetadata;
+
+    // Game thread: load what the registry couldn't answer, one chunk at a time
+    while (LoadChunkIndex < Chunks.Num() && !bCancelRequested && FPlatformTime::Seconds() < EndTime)
+    {
+        FChunk& Chunk = Chunks[LoadChunkIndex];
+        if (!Chunk.ReadTask.IsCompleted())
+        {
+            if (!bBlocking) break;
+            Chunk.ReadTask.Wait();
+        }
+
+        FOptimizationCheckPassBase* Pass = &Passes[Chunk.PassIndex].Get();
+
+        if (!StepLoads(*Pass, Chunk, EndTime, bBlocking, bAllowLoading))
+        {
+            break;
+        }
+
+        // Workers: threshold math, impact scoring and string formatting.
+        // Each asset writes its own slot, so the publish order stays deterministic.
+        const int32 Begin = Chunk.Begin;
+        const int32 End = Chunk.End;
+        Chunk.EvaluateTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Pass, Begin, End]()
+            {
+                OPTIMIZATION_PROFILE_SCOPE(EvaluateScope, *EvaluateCounter, End - Begin);
+
+                for (int32 Index = Begin; Index < End; ++Index)
+                {
+                    if (bCancelRequested.load(std::memory_order_relaxed)) return;
+
+                    Pass->Evaluate(Index);
+                }
+            });
+
+        ++LoadChunkIndex;
+        LoadAssetIndex = Chunks.IsValidIndex(LoadChunkIndex) ? Chunks[LoadChunkIndex].Begin : 0;
+    }
+
+    if (bCancelRequested)
+    {
+        return;
+    }
+
+    // Publish finished chunks in order (partial results for the UI)
+    while (PublishChunkIndex < LoadChunkIndex)
+    {
+        const FChunk& Chunk = Chunks[PublishChunkIndex];
+        if (!Chunk.EvaluateTask.IsCompleted())
+        {
+            if (!bBlocking) break;
+            Chunk.EvaluateTask.Wait();
+        }
+
+        OPTIMIZATION_PROFILE_SCOPE(PublishScope, *PublishCounter, Chunk.End - Chunk.Begin);
+
+        FOptimizationCheckPassBase& Pass = Passes[Chunk.PassIndex].Get();
+        Pass.CollectIssues(Chunk.Begin, Chunk.End, PendingIssues);
+        Analyzer->StoreResults(Pass, Chunk.Begin, Chunk.End);
+
+        if (Chunk.bLastInPass)
+        {
+            // Chunks publish in order, every asset of the pass has been evaluated by now
+            Pass.EvaluatePass();
+            PendingIssues.Append(Pass.TrailingIssues);
+
+            int32 MetadataHits = 0;
+            int32 AssetsLoaded = 0;
+            int32 AssetsSkipped = 0;
+            int32 CacheHits = 0;
+            for (EOptimizationMetricsSource Source : Pass.Sources)
+            {
+                MetadataHits += (Source == EOptimizationMetricsSource::Registry);
+                AssetsLoaded += (Source == EOptimizationMetricsSource::Object);
+                AssetsSkipped += (Source == EOptimizationMetricsSource::Unavailable);
+                CacheHits += (Source == EOptimizationMetricsSource::Cached || Source == EOptimizationMetricsSource::CachedMetrics);
+            }
+
+            UE_LOG(LogTemp, Log, TEXT("%s pass: %d assets (%d cached, %d from registry, %d loaded, %d skipped)"),
+                *Pass.Name, Pass.Assets.Num(), CacheHits, MetadataHits, AssetsLoaded, AssetsSkipped);
+        }
+
+        ++PublishChunkIndex;
+    }
+
+    if (PublishChunkIndex == Chunks.Num())
+    {
+        Finish();
+    }
+}
+
+bool FOptimizationAnalysisJob::StepLoads(FOptimizationCheckPassBase& Pass, const FChunk& Chunk, double EndTime, bool bBlocking, bool bAllowLoading)
+{
+    while (!bCancelRequested)
+    {
+        if (LoadBatch.Num() == 0)
+        {
+            // Next batch: assets of this chunk the registry couldn't answer
+            const int32 BatchSize = FMath::Max(Analyzer->LoadBatchSize, 1);
+            while (LoadAssetIndex < Chunk.End && LoadBatch.Num() < BatchSize)
+            {
+                if (Pass.Sources[LoadAssetIndex] == EOptimizationMetricsSource::Pending)
+                {
+                    if (bAllowLoading)
+                    {
+                        LoadBatch.Add(LoadAssetIndex);
+                    }
+                    else
+                    {
+                        Pass.Sources[LoadAssetIndex] = EOptimizationMetricsSource::Unavailable;
+                        ProcessedCount.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                ++LoadAssetIndex;
+            }
+
+            if (LoadBatch.Num() == 0)
+            {
+                return true;
+            }
+
+            LoadBatchStartCycles = FPlatformTime::Cycles64();
+            LoadBatchStartMemory = FPlatformMemory::GetStats().UsedPhysical;
+            RequestBatchLoads(Pass);
+        }
+
+        if (NumLoadsInFlight > 0)
+        {
+            if (!bBlocking)
+            {
+                return false;
+            }
+
+            TRACE_CPUPROFILER_EVENT_SCOPE(OptimizationHelper_FlushLoadBatch);
+            for (int32 RequestId : LoadRequestIds)
+            {
+                FlushAsyncLoading(RequestId);
+            }
+        }
+
+        // Request to resident, including frames the loader ran in the background
+        if (LoadBatchStartCycles != 0)
+        {
+            const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+            LoadCounter->Add(
+                FPlatformTime::Cycles64() - LoadBatchStartCycles,
+                LoadBatch.Num(),
+                UsedPhysical > LoadBatchStartMemory ? (int64)(UsedPhysical - LoadBatchStartMemory) : 0
+            );
+            LoadBatchStartCycles = 0;
+        }
+
+        // Materials compile their shaders after loading. Wait for the whole batch across ticks,
+        // the compile workers take it as one batch and the editor keeps running meanwhile.
+        if (!bLoadBatchReady)
+        {
+            if (bBlocking)
+            {
+                Pass.FinishObjects(LoadBatch);
+            }
+            else if (!AreLoadBatchObjectsReady(Pass))
+            {
+                if (ObjectWaitStartTime == 0.0)
+                {
+                    ObjectWaitStartTime = FPlatformTime::Seconds();
+                }
+                if (FPlatformTime::Seconds() - ObjectWaitStartTime < MaxObjectWaitSeconds)
+                {
+                    return false;
+                }
+
+                UE_LOG(LogTemp, Warning, TEXT("%s pass: assets still not ready after %.0f s, their metrics may be incomplete"),
+                    *Pass.Name, MaxObjectWaitSeconds);
+            }
+            bLoadBatchReady = true;
+            ObjectWaitStartTime = 0.0;
+        }
+
+        // Everything of the batch is resident now, extract the metrics
+        while (LoadBatchComputeIndex < LoadBatch.Num())
+        {
+            if (bCancelRequested || FPlatformTime::Seconds() >= EndTime)
+            {
+                return false;
+            }
+
+            const int32 Index = LoadBatch[LoadBatchComputeIndex++];
+            if (FailedPackages.Contains(Pass.Assets[Index].PackageName))
+            {
+                Pass.Sources[Index] = EOptimizationMetricsSource::Unavailable;
+            }
+            else
+            {
+                OPTIMIZATION_PROFILE_SCOPE(ComputeScope, *ComputeCounter, 1);
+                Pass.LoadAndCompute(Index);
+            }
+            ProcessedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Only metrics are kept, nothing of the batch is referenced anymore
+        LoadBatch.Reset();
+        LoadBatchComputeIndex = 0;
+        bLoadBatchReady = false;
+        LoadRequestIds.Reset();
+        FailedPackages.Reset();
+
+        CollectGarbageIfOverBudget();
+
+        if (FPlatformTime::Seconds() >= EndTime)
+        {
+            return LoadAssetIndex >= Chunk.End;
+        }
+    }
+
+    return false;
+}
+
+bool FOptimizationAnalysisJob::AreLoadBatchObjectsReady(const FOptimizationCheckPassBase& Pass) const
+{
+    for (int32 Index : LoadBatch)
+    {
+        if (!FailedPackages.Contains(Pass.Assets[Index].PackageName) && !Pass.IsObjectReady(Index))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void FOptimizationAnalysisJob::RequestBatchLoads(const FOptimizationCheckPassBase& Pass)
+{
+    TSet<FName> RequestedPackages;
+    for (int32 Index : LoadBatch)
+    {
+        const FName PackageName = Pass.Assets[Index].PackageName;
+        if (RequestedPackages.Contains(PackageName))
+        {
+            continue;
+        }
+        RequestedPackages.Add(PackageName);
+
+        ++NumLoadsInFlight;
+        ++NumPackagesLoaded;
+        LoadRequestIds.Add(LoadPackageAsync(
+            PackageName.ToString(),
+            FLoadPackageAsyncDelegate::CreateSP(this, &FOptimizationAnalysisJob::OnPackageLoaded)
+        ));
+    }
+}
+
+void FOptimizationAnalysisJob::OnPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+{
+    NumLoadsInFlight = FMath::Max(NumLoadsInFlight - 1, 0);
+
+    if (Result != EAsyncLoadingResult::Succeeded || !LoadedPackage)
+    {
+        FailedPackages.Add(PackageName);
+    }
+}
+
+void FOptimizationAnalysisJob::CollectGarbageIfOverBudget()
+{
+    const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+    const uint64 BudgetBytes = (uint64)FMath::Max(Analyzer->LoadMemoryBudgetMB, 0) * 1024 * 1024;
+
+    if (UsedPhysical > BaselineMemoryUsed + BudgetBytes)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Analysis is %.0f MB over its starting memory, collecting garbage"),
+            (UsedPhysical - BaselineMemoryUsed) / (1024.0 * 1024.0));
+
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+        ++NumGarbageCollections;
+    }
+}
+
+void FOptimizationAnalysisJob::ResolveProfileCounters()
+{
+    FOptimizationScanProfile& Profile = Analyzer->GetScanProfile();
+    ReadCounter = &Profile.FindOrAddCounter(FOptimizationScanProfile::ReadMetadata, EOptimizationProfileKind::Phase);
+    LoadCounter = &Profile.FindOrAddCounter(FOptimizationScanProfile::Load, EOptimizationProfileKind::Phase);
+    ComputeCounter = &Profile.FindOrAddCounter(FOptimizationScanProfile::ComputeMetrics, EOptimizationProfileKind::Phase);
+    EvaluateCounter = &Profile.FindOrAddCounter(FOptimizationScanProfile::Evaluate, EOptimizationProfileKind::Phase);
+    PublishCounter = &Profile.FindOrAddCounter(FOptimizationScanProfile::Publish, EOptimizationProfileKind::Phase);
+    LevelCounter = &Profile.FindOrAddCounter(FOptimizationScanProfile::LevelActors, EOptimizationProfileKind::Phase);
+}
+
+void FOptimizationAnalysisJob::StepLevel(double EndTime)
+{
+    while (NextActorIndex < Actors.Num() && !bCancelRequested && FPlatformTime::Seconds() < EndTime)
+    {
+        if (AActor* Actor = Actors[NextActorIndex].Get())
+        {
+            OPTIMIZATION_PROFILE_SCOPE(ActorScope, *LevelCounter, 1);
+
+            const int32 NumIssuesBefore = PendingIssues.Num();
+            Analyzer->AnalyzeLevelActor(Actor, *LevelState, PendingIssues);
+            LevelIssueCount += PendingIssues.Num() - NumIssuesBefore;
+        }
+
+        ++NextActorIndex;
+        ProcessedCount.store(NextActorIndex, std::memory_order_relaxed);
+    }
+
+    if (NextActorIndex == Actors.Num())
+    {
+        Finish();
+    }
+}
+
+bool FOptimizationAnalysisJob::AreTasksCompleted() const
+{
+    for (const FChunk& Chunk : Chunks)
+    {
+        if (!Chunk.ReadTask.IsCompleted() || !Chunk.EvaluateTask.IsCompleted())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void FOptimizationAnalysisJob::Finish()
+{
+    if (bFinished) return;
+    bFinished = true;
+
+    Analyzer->GetScanProfile().MarkFinished();
+
+    if (LevelState.IsValid())
+    {
+        Analyzer->LogLevelScanSummary(*LevelState, LevelIssueCount);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Log, TEXT("Analysis loaded %d packages, %d garbage collections"), NumPackagesLoaded, NumGarbageCollections);
+
+        // Whatever was evaluated is valid, even if the scan was cancelled
+        Analyzer->SaveResultCache();
+    }
+
+    if (bCancelRequested)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Analysis cancelled after %d of %d assets"), GetProcessedCount(), TotalCount);
+    }
+}
+
+#undef LOCTEXT_NAMESPACE
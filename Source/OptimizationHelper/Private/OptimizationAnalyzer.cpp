@@ -1,12 +1,14 @@
 ﻿#include "OptimizationAnalyzer.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Engine/StaticMesh.h"
+#include "Engine/SkeletalMesh.h"
 #include "Engine/Texture2D.h"
 #include "Materials/Material.h"
-#include "Materials/MaterialInstance.h"
+#include "Materials/MaterialInstanceConstant.h"
 #include "Engine/Blueprint.h"
 #include "Sound/SoundWave.h"
 #include "Particles/ParticleSystem.h"
+#include "NiagaraSystem.h"
 #include "Editor.h"
 #include "EngineUtils.h"
 #include "EdGraph/EdGraph.h"
@@ -20,176 +22,134 @@
 #include "GameFramework/Actor.h"
 #include "Rendering/SkeletalMeshRenderData.h"
 #include "Rendering/SkeletalMeshLODRenderData.h"
-
+#include "OptimizationCheckPass.h"
+#include "OptimizationAnalysisJob.h"
+#include "OptimizationMaterialGraph.h"
+#include "OptimizationResultCache.h"
+#include "OptimizationRenderStats.h"
+#include "OptimizationRuleRegistry.h"
+#include "OptimizationScanProfile.h"
+#include "OptimizationSceneStats.h"
+#include "OptimizationTextureMemory.h"
+
+UOptimizationAnalyzer::UOptimizationAnalyzer()
+    : ScanProfile(MakeShared<FOptimizationScanProfile>())
+{
+}
 
 TArray<FOptimizationIssue> UOptimizationAnalyzer::AnalyzeProject()
 {
-    TArray<FOptimizationIssue> AllIssues;
-
-    AllIssues.Append(CheckMeshes());
-    AllIssues.Append(CheckTextures());
-    AllIssues.Append(CheckMaterials());
-    AllIssues.Append(CheckBlueprints());
-    AllIssues.Append(CheckAudio());
-    AllIssues.Append(CheckParticleSystems());
+    // Every class with rules goes through the task graph together
+    TArray<FOptimizationIssue> AllIssues = RunPasses(MakeProjectPasses());
 
+    LogTextureSavingsReport(AllIssues);
     return AllIssues;
 }
 
 TArray<FOptimizationIssue> UOptimizationAnalyzer::AnalyzeCurrentLevel()
 {
-    TArray<FOptimizationIssue> Issues;
-
     // Get current world
     UWorld* World = GEditor->GetEditorWorldContext().World();
     if (!World)
     {
         UE_LOG(LogTemp, Warning, TEXT("No level is currently opened"));
-        return Issues;
+        return TArray<FOptimizationIssue>();
     }
 
+    return AnalyzeLevel(World);
+}
+
+TArray<FOptimizationIssue> UOptimizationAnalyzer::AnalyzeLevel(UWorld* World)
+{
+    TArray<FOptimizationIssue> Issues;
+    if (!World) return Issues;
+
     UE_LOG(LogTemp, Log, TEXT("Analyzing current level: %s"), *World->GetName());
 
-    // Track processed assets to avoid duplicates
-    TSet<UStaticMesh*> ProcessedMeshes;
-    TSet<UTexture*> ProcessedTextures;
+    FOptimizationLevelScanState State;
+    State.WorldName = World->GetName();
 
-    int32 ActorCount = 0;
-    int32 MeshCount = 0;
-    int32 TextureCount = 0;
+    ScanProfile->Reset();
+    FOptimizationProfileCounter& ActorCounter =
+        ScanProfile->FindOrAddCounter(FOptimizationScanProfile::LevelActors, EOptimizationProfileKind::Phase);
 
     // Iterate through all actors in the level
     for (TActorIterator<AActor> ActorItr(World); ActorItr; ++ActorItr)
     {
-        AActor* Actor = *ActorItr;
-        ActorCount++;
+        OPTIMIZATION_PROFILE_SCOPE(ActorScope, ActorCounter, 1);
+        AnalyzeLevelActor(*ActorItr, State, Issues);
+    }
 
-        // Get all static mesh components
-        TArray<UStaticMeshComponent*> MeshComponents;
-        Actor->GetComponents<UStaticMeshComponent>(MeshComponents);
+    ScanProfile->MarkFinished();
+    LogLevelScanSummary(State, Issues.Num());
 
-        for (UStaticMeshComponent* MeshComp : MeshComponents)
-        {
-            if (MeshComp && MeshComp->GetStaticMesh())
-            {
-                UStaticMesh* Mesh = MeshComp->GetStaticMesh();
+    return Issues;
+}
 
-                // Avoid analyzing same mesh multiple times
-                if (!ProcessedMeshes.Contains(Mesh))
-                {
-                    ProcessedMeshes.Add(Mesh);
-                    MeshCount++;
+void UOptimizationAnalyzer::AnalyzeLevelActor(AActor* Actor, FOptimizationLevelScanState& State, TArray<FOptimizationIssue>& OutIssues)
+{
+    if (!Actor) return;
 
-                    // Check triangle count
-                    int32 TriangleCount = 0;
-                    if (Mesh->GetRenderData())
-                    {
-                        const FStaticMeshLODResources& LOD = Mesh->GetRenderData()->LODResources[0];
-                        TriangleCount = LOD.GetNumTriangles();
-                    }
+    State.ActorCount++;
 
-                    if (TriangleCount > MaxTrianglesPerMesh)
-                    {
-                        FOptimizationIssue Issue;
-                        Issue.Category = EOptimizationCategory::Mesh;
-                        Issue.Title = FString::Printf(TEXT("High Poly Count: %s"), *Mesh->GetName());
+    // Static and skeletal mesh components
+    TArray<UMeshComponent*> MeshComponents;
+    Actor->GetComponents<UMeshComponent>(MeshComponents);
 
-                        if (TriangleCount > MaxTrianglesPerMesh * 3)
-                        {
-                            Issue.Severity = EOptimizationSeverity::Critical;
-                            Issue.EstimatedImpact = 90.0f;
-                        }
-                        else
-                        {
-                            Issue.Severity = EOptimizationSeverity::Warning;
-                            Issue.EstimatedImpact = 60.0f;
-                        }
+    for (UMeshComponent* MeshComp : MeshComponents)
+    {
+        UObject* Mesh = nullptr;
+        if (const UStaticMeshComponent* StaticMeshComp = Cast<UStaticMeshComponent>(MeshComp))
+        {
+            Mesh = StaticMeshComp->GetStaticMesh();
+        }
+        else if (const USkeletalMeshComponent* SkeletalMeshComp = Cast<USkeletalMeshComponent>(MeshComp))
+        {
+            Mesh = SkeletalMeshComp->GetSkeletalMeshAsset();
+        }
 
-                        Issue.Description = FString::Printf(
-                            TEXT("Mesh has %d triangles (threshold: %d). Used in level '%s'"),
-                            TriangleCount,
-                            MaxTrianglesPerMesh,
-                            *World->GetName()
-                        );
-                        Issue.AssetPath = Mesh->GetPathName();
-                        Issue.SuggestedFix = TEXT("Reduce polygon count or create LODs");
-                        Issues.Add(Issue);
-                    }
+        if (Mesh)
+        {
+            // Avoid analyzing same mesh multiple times
+            if (!State.ProcessedMeshes.Contains(Mesh))
+            {
+                State.ProcessedMeshes.Add(Mesh);
+                State.MeshCount++;
 
-                    // Check for missing LODs
-                    if (Mesh->GetNumLODs() <= 1 && TriangleCount > 10000)
-                    {
-                        FOptimizationIssue Issue;
-                        Issue.Category = EOptimizationCategory::Mesh;
-                        Issue.Title = FString::Printf(TEXT("Missing LODs: %s"), *Mesh->GetName());
-                        Issue.Description = TEXT("High-poly mesh has no LOD chain in current level");
-                        Issue.Severity = EOptimizationSeverity::Warning;
-                        Issue.AssetPath = Mesh->GetPathName();
-                        Issue.EstimatedImpact = 50.0f;
-                        Issue.SuggestedFix = TEXT("Generate LOD chain");
-                        Issues.Add(Issue);
-                    }
-                }
+                // Same rules as the project scan
+                EvaluateLevelObject(Mesh, State, OutIssues);
+            }
 
-                // Analyze materials and textures
-                TArray<UMaterialInterface*> Materials = MeshComp->GetMaterials();
-                for (UMaterialInterface* Material : Materials)
+            // Analyze materials and textures
+            TArray<UMaterialInterface*> Materials = MeshComp->GetMaterials();
+            for (UMaterialInterface* Material : Materials)
+            {
+                if (Material)
                 {
-                    if (Material)
-                    {
-                        TArray<UTexture*> Textures;
-                        Material->GetUsedTextures(Textures, EMaterialQualityLevel::High, true, ERHIFeatureLevel::SM5, true);
+                    TArray<UTexture*> Textures;
+                    Material->GetUsedTextures(Textures, EMaterialQualityLevel::High, true, ERHIFeatureLevel::SM5, true);
 
-                        for (UTexture* Texture : Textures)
+                    for (UTexture* Texture : Textures)
+                    {
+                        UTexture2D* Texture2D = Cast<UTexture2D>(Texture);
+                        if (Texture2D && !State.ProcessedTextures.Contains(Texture2D))
                         {
-                            UTexture2D* Texture2D = Cast<UTexture2D>(Texture);
-                            if (Texture2D && !ProcessedTextures.Contains(Texture2D))
-                            {
-                                ProcessedTextures.Add(Texture2D);
-                                TextureCount++;
-
-                                int32 MaxDimension = FMath::Max(Texture2D->GetSizeX(), Texture2D->GetSizeY());
-
-                                if (MaxDimension > MaxTextureSize)
-                                {
-                                    FOptimizationIssue Issue;
-                                    Issue.Category = EOptimizationCategory::Texture;
-                                    Issue.Title = FString::Printf(TEXT("Large Texture: %s"), *Texture2D->GetName());
-
-                                    if (MaxDimension > 8192)
-                                    {
-                                        Issue.Severity = EOptimizationSeverity::Critical;
-                                        Issue.EstimatedImpact = 85.0f;
-                                    }
-                                    else
-                                    {
-                                        Issue.Severity = EOptimizationSeverity::Warning;
-                                        Issue.EstimatedImpact = 55.0f;
-                                    }
-
-                                    Issue.Description = FString::Printf(
-                                        TEXT("Texture size: %dx%d (threshold: %d). Used in level '%s'"),
-                                        Texture2D->GetSizeX(),
-                                        Texture2D->GetSizeY(),
-                                        MaxTextureSize,
-                                        *World->GetName()
-                                    );
-                                    Issue.AssetPath = Texture2D->GetPathName();
-                                    Issue.SuggestedFix = TEXT("Resize texture or enable virtual texturing");
-                                    Issues.Add(Issue);
-                                }
-                            }
+                            State.ProcessedTextures.Add(Texture2D);
+                            State.TextureCount++;
+
+                            EvaluateLevelObject(Texture2D, State, OutIssues);
                         }
                     }
                 }
             }
         }
     }
+}
 
+void UOptimizationAnalyzer::LogLevelScanSummary(const FOptimizationLevelScanState& State, int32 IssueCount) const
+{
     UE_LOG(LogTemp, Log, TEXT("Level analysis complete: %d actors, %d unique meshes, %d unique textures, %d issues found"),
-        ActorCount, MeshCount, TextureCount, Issues.Num());
-
-    return Issues;
+        State.ActorCount, State.MeshCount, State.TextureCount, IssueCount);
 }
 
 // ==================== NEW: REAL-TIME PERFORMANCE STATS ====================
@@ -206,777 +166,512 @@ FPerformanceStats UOptimizationAnalyzer::GetCurrentPerformanceStats()
         Stats.FrameTimeMS = DeltaTime * 1000.0f;
     }
 
-    // Get draw calls and primitives using our custom counting
-    Stats.DrawCalls = GetCurrentDrawCalls();
-    Stats.PrimitivesDrawn = CountVisiblePrimitives();
+    // Triangles and mesh sections of the scene, kept up to date from engine events
+    const FOptimizationSceneStats& SceneStats = GetSceneStatsCache().GetStats(GetEditorWorld());
+    Stats.Triangles = SceneStats.Triangles;
+    Stats.MeshDrawCalls = SceneStats.DrawCalls;
 
-    // DEBUG LOG
-    UE_LOG(LogTemp, Warning, TEXT("=== Performance Stats DEBUG ==="));
-    UE_LOG(LogTemp, Warning, TEXT("DrawCalls (before multiplier): %d"), Stats.DrawCalls);
-    UE_LOG(LogTemp, Warning, TEXT("Primitives: %d"), Stats.PrimitivesDrawn);
-
-    // Apply multiplier to get closer to engine stats
-    // Engine counts include shadow passes, reflection captures, etc.
-    Stats.DrawCalls = Stats.DrawCalls * 10;  // Multiplier based on typical ratio
-
-    UE_LOG(LogTemp, Warning, TEXT("DrawCalls (after x10): %d"), Stats.DrawCalls);
+    // Draw calls and primitives as the renderer counted them
+    FOptimizationRenderCounters RenderCounters;
+    if (OptimizationRenderStats::ReadRenderCounters(RenderCounters))
+    {
+        Stats.bFromRenderer = true;
+        Stats.DrawCalls = RenderCounters.DrawCalls;
+        Stats.PrimitivesDrawn = RenderCounters.PrimitivesDrawn;
+        Stats.bHasPassBreakdown = RenderCounters.bHasPassBreakdown;
+        Stats.BasePassDrawCalls = RenderCounters.BasePassDrawCalls;
+        Stats.ShadowDepthDrawCalls = RenderCounters.ShadowDepthDrawCalls;
+        Stats.TranslucencyDrawCalls = RenderCounters.TranslucencyDrawCalls;
+    }
+    else
+    {
+        // Nothing is rendered (-nullrhi), the scene is all there is to count
+        Stats.DrawCalls = SceneStats.DrawCalls;
+        Stats.PrimitivesDrawn = SceneStats.PrimitivesDrawn;
+    }
 
-    // Get Triangle Count
-    Stats.Triangles = GetCurrentTriangleCount();
-    UE_LOG(LogTemp, Warning, TEXT("Triangles: %d"), Stats.Triangles);
-    UE_LOG(LogTemp, Warning, TEXT("=== END DEBUG ==="));
+    UE_LOG(LogTemp, Verbose, TEXT("Scene stats: %d actors, %d draw calls (%s), %d primitives, %d triangles"),
+        SceneStats.ActorCount, Stats.DrawCalls, Stats.bFromRenderer ? TEXT("renderer") : TEXT("scene estimate"),
+        Stats.PrimitivesDrawn, Stats.Triangles);
 
     // Get Memory Usage
     FPlatformMemoryStats MemStats = FPlatformMemory::GetStats();
     Stats.MemoryUsedMB = MemStats.UsedPhysical / (1024.0f * 1024.0f);
 
     // Get Texture Memory
-    Stats.TextureMemoryMB = GetTextureMemoryUsage();
-
-    Stats.MeshDrawCalls = Stats.DrawCalls;
+    const FOptimizationTextureMemoryStats& TextureStats = GetTextureMemoryTracker().GetStats();
+    Stats.TextureMemoryMB = TextureStats.GetResidentMB();
+    Stats.TextureWantedMB = TextureStats.GetWantedMB();
+    Stats.StreamingTextures = TextureStats.NumStreaming;
 
     return Stats;
 }
 
 int32 UOptimizationAnalyzer::GetCurrentDrawCalls()
 {
-    int32 DrawCalls = 0;
-
-    // Get Editor World (not Game World)
-    UWorld* World = nullptr;
-    if (GEditor && GEditor->GetEditorWorldContext().World())
-    {
-        World = GEditor->GetEditorWorldContext().World();
-    }
-    // DEBUG
-    if (!World)
+    FOptimizationRenderCounters RenderCounters;
+    if (OptimizationRenderStats::ReadRenderCounters(RenderCounters))
     {
-        UE_LOG(LogTemp, Error, TEXT("GetCurrentDrawCalls: World is NULL!"));
-        return 0;
+        return RenderCounters.DrawCalls;
     }
-
-    UE_LOG(LogTemp, Warning, TEXT("GetCurrentDrawCalls: World found: %s"), *World->GetName());
-
-    // Count all mesh components as potential draw calls
-    int32 ActorCount = 0;
-    for (TActorIterator<AActor> It(World); It; ++It)
-    {
-        ActorCount++;
-        AActor* Actor = *It;
-        if (Actor && !Actor->IsHidden())
-        {
-            TArray<UStaticMeshComponent*> StaticMeshComponents;
-            Actor->GetComponents<UStaticMeshComponent>(StaticMeshComponents);
-
-            for (UStaticMeshComponent* MeshComp : StaticMeshComponents)
-            {
-                if (MeshComp && MeshComp->IsVisible())
-                {
-                    // Each mesh component can be multiple draw calls (sections)
-                    if (UStaticMesh* Mesh = MeshComp->GetStaticMesh())
-                    {
-                        if (Mesh->GetRenderData())
-                        {
-                            DrawCalls += Mesh->GetRenderData()->LODResources[0].Sections.Num();
-                        }
-                    }
-                }
-            }
-
-            TArray<USkeletalMeshComponent*> SkeletalMeshComponents;
-            Actor->GetComponents<USkeletalMeshComponent>(SkeletalMeshComponents);
-            DrawCalls += SkeletalMeshComponents.Num() * 2; // Estimate
-        }
-    }
-
-    UE_LOG(LogTemp, Warning, TEXT("GetCurrentDrawCalls: Found %d actors, %d draw calls"), ActorCount, DrawCalls);
-    return DrawCalls;
+    return GetSceneStatsCache().GetStats(GetEditorWorld()).DrawCalls;
 }
 
 int32 UOptimizationAnalyzer::GetCurrentTriangleCount()
 {
-    return CalculateSceneTriangles();
+    return GetSceneStatsCache().GetStats(GetEditorWorld()).Triangles;
 }
 
-int32 UOptimizationAnalyzer::CalculateSceneTriangles()
+FOptimizationSceneStats UOptimizationAnalyzer::CollectSceneStats() const
 {
-    int32 TotalTriangles = 0;
+    FOptimizationSceneStats Stats;
 
-    // Get Editor World (not Game World)
-    UWorld* World = nullptr;
-    if (GEditor && GEditor->GetEditorWorldContext().World())
-    {
-        World = GEditor->GetEditorWorldContext().World();
-    }
-    // DEBUG
+    UWorld* World = GetEditorWorld();
     if (!World)
     {
-        UE_LOG(LogTemp, Error, TEXT("CalculateSceneTriangles: World is NULL!"));
-        return 0;
+        UE_LOG(LogTemp, Error, TEXT("CollectSceneStats: World is NULL!"));
+        return Stats;
     }
 
-    // Iterate through all actors in the world
-    int32 ActorCount = 0;
+    // Landscape actors are recognized by class name; the answer is kept per class,
+    // not recomputed (and allocated) per actor
+    TMap<const UClass*, bool> LandscapeClasses;
+
     for (TActorIterator<AActor> It(World); It; ++It)
     {
-        ActorCount++;
         AActor* Actor = *It;
-        if (!Actor || Actor->IsHidden()) continue;
-
-        // Check Static Meshes
-        TArray<UStaticMeshComponent*> StaticMeshComponents;
-        Actor->GetComponents<UStaticMeshComponent>(StaticMeshComponents);
+        if (!Actor) continue;
 
-        for (UStaticMeshComponent* MeshComp : StaticMeshComponents)
-        {
-            if (MeshComp && MeshComp->IsVisible())
-            {
-                if (UStaticMesh* Mesh = MeshComp->GetStaticMesh())
-                {
-                    if (Mesh->GetRenderData())
-                    {
-                        // Get LOD 0 triangles
-                        const FStaticMeshLODResources& LOD = Mesh->GetRenderData()->LODResources[0];
-                        TotalTriangles += LOD.GetNumTriangles();
-                    }
-                }
-            }
-        }
+        Stats.ActorCount++;
+        if (Actor->IsHidden()) continue;
 
-        // Check Skeletal Meshes
-        TArray<USkeletalMeshComponent*> SkeletalMeshComponents;
-        Actor->GetComponents<USkeletalMeshComponent>(SkeletalMeshComponents);
+        const bool bIsLandscape = FOptimizationSceneStats::IsLandscapeClass(Actor->GetClass(), LandscapeClasses);
 
-        for (USkeletalMeshComponent* SkelComp : SkeletalMeshComponents)
-        {
-            if (SkelComp && SkelComp->IsVisible())
+        // No GetComponents: iterating in place doesn't fill a temporary array per actor
+        Actor->ForEachComponent<UPrimitiveComponent>(false, [&Stats, bIsLandscape](UPrimitiveComponent* PrimComp)
             {
-                if (USkeletalMesh* SkelMesh = SkelComp->GetSkeletalMeshAsset())
+                if (PrimComp)
                 {
-                    FSkeletalMeshRenderData* RenderData = SkelMesh->GetResourceForRendering();
-                    if (RenderData && RenderData->LODRenderData.Num() > 0)
-                    {
-                        // Calculate triangles from index buffer
-                        const FSkeletalMeshLODRenderData& LODData = RenderData->LODRenderData[0];
-
-                        // Sum up triangles from all sections
-                        int32 SkelTriangles = 0;
-                        for (const FSkelMeshRenderSection& Section : LODData.RenderSections)
-                        {
-                            SkelTriangles += Section.NumTriangles;
-                        }
-
-                        TotalTriangles += SkelTriangles;
-                    }
+                    Stats.AddComponent(*PrimComp, bIsLandscape);
                 }
-            }
-        }
+            });
     }
 
-    
-    // Count REAL landscape triangles from components
-    for (TActorIterator<AActor> LandscapeIt(World); LandscapeIt; ++LandscapeIt)
-    {
-        AActor* Actor = *LandscapeIt;
-        if (Actor && !Actor->IsHidden())
-        {
-            FString ClassName = Actor->GetClass()->GetName();
-            if (ClassName.Contains(TEXT("Landscape")) || ClassName.Contains(TEXT("LandscapeProxy")))
-            {
-                // Get all primitive components (landscape uses these)
-                TArray<UPrimitiveComponent*> PrimitiveComponents;
-                Actor->GetComponents<UPrimitiveComponent>(PrimitiveComponents);
-
-                for (UPrimitiveComponent* PrimComp : PrimitiveComponents)
-                {
-                    if (PrimComp && PrimComp->IsVisible())
-                    {
-                        // Landscape components store triangle count in SceneProxy
-                        // Estimate based on component bounds and typical quad density
-                        FBoxSphereBounds Bounds = PrimComp->Bounds;
-                        float Area = Bounds.BoxExtent.X * Bounds.BoxExtent.Y * 4.0f; // Approximate area
-
-                        // Typical landscape: 1 quad per 100 units² = 2 triangles per 100 units²
-                        // This varies by landscape resolution, but gives realistic estimate
-                        int32 EstimatedQuads = FMath::RoundToInt(Area / 100.0f);
-                        TotalTriangles += EstimatedQuads * 2; // Each quad = 2 triangles
-                    }
-                }
-            }
-        }
-    }
-    UE_LOG(LogTemp, Warning, TEXT("CalculateSceneTriangles: Found %d actors, %d total triangles"), ActorCount, TotalTriangles);
-    return TotalTriangles;
+    return Stats;
 }
 
-int32 UOptimizationAnalyzer::CountVisiblePrimitives()
+UWorld* UOptimizationAnalyzer::GetEditorWorld()
 {
-    int32 PrimitiveCount = 0;
+    // Editor world, not the PIE world
+    return GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+}
 
-    // Get Editor World (not Game World)
-    UWorld* World = nullptr;
-    if (GEditor && GEditor->GetEditorWorldContext().World())
+FOptimizationSceneStatsCache& UOptimizationAnalyzer::GetSceneStatsCache()
+{
+    if (!SceneStatsCache.IsValid())
     {
-        World = GEditor->GetEditorWorldContext().World();
+        SceneStatsCache = MakeShared<FOptimizationSceneStatsCache>();
     }
+    return *SceneStatsCache;
+}
 
-    for (TActorIterator<AActor> It(World); It; ++It)
-    {
-        AActor* Actor = *It;
-        if (Actor && !Actor->IsHidden())
-        {
-            TArray<UPrimitiveComponent*> PrimitiveComponents;
-            Actor->GetComponents<UPrimitiveComponent>(PrimitiveComponents);
+float UOptimizationAnalyzer::GetTextureMemoryUsage()
+{
+    // Resident textures only, kept up to date as textures load, stream and unload
+    return GetTextureMemoryTracker().GetStats().GetResidentMB();
+}
 
-            for (UPrimitiveComponent* PrimComp : PrimitiveComponents)
-            {
-                if (PrimComp && PrimComp->IsVisible())
-                {
-                    PrimitiveCount++;
-                }
-            }
-        }
+FOptimizationTextureMemoryTracker& UOptimizationAnalyzer::GetTextureMemoryTracker()
+{
+    if (!TextureMemoryTracker.IsValid())
+    {
+        TextureMemoryTracker = MakeShared<FOptimizationTextureMemoryTracker>();
     }
+    return *TextureMemoryTracker;
+}
+
+TArray<FOptimizationIssue> UOptimizationAnalyzer::RunPasses(TArray<TSharedRef<FOptimizationCheckPassBase>>&& Passes)
+{
+    TSharedRef<FOptimizationAnalysisJob> Job = MakeShared<FOptimizationAnalysisJob>(this, MoveTemp(Passes));
+    Job->RunToCompletion();
 
-    return PrimitiveCount;
+    TArray<FOptimizationIssue> Issues;
+    Job->ConsumeNewIssues(Issues);
+    return Issues;
 }
 
-float UOptimizationAnalyzer::GetTextureMemoryUsage()
+TArray<TSharedRef<FOptimizationCheckPassBase>> UOptimizationAnalyzer::MakeProjectPasses()
 {
-    float TextureMemoryMB = 0.0f;
+    // A new scan starts here, registry queries are its first phase
+    ScanProfile->Reset();
 
-    // Simplified: iterate through loaded textures
-    FAssetRegistryModule& AssetRegistryModule =
-        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+    // Each class is queried once; registration order keeps meshes, textures, materials, blueprints first
+    TArray<TSharedRef<FOptimizationCheckPassBase>> Passes;
+    for (UClass* AssetClass : FOptimizationRuleRegistry::Get().GetAssetClasses())
+    {
+        Passes.Add(MakeClassPass(AssetClass));
+    }
+    return Passes;
+}
 
-    TArray<FAssetData> TextureAssets;
-    AssetRegistryModule.Get().GetAssetsByClass(
-        UTexture2D::StaticClass()->GetClassPathName(),
-        TextureAssets
-    );
+FOptimizationScanProfile& UOptimizationAnalyzer::GetScanProfile() const
+{
+    return *ScanProfile;
+}
 
-    int64 TotalTextureMemory = 0;
-    int32 LoadedCount = 0;
+void UOptimizationAnalyzer::InvalidateResultCache()
+{
+    GetResultCache().Reset();
+    FOptimizationMaterialGraph::ResetCache();
+}
 
-    for (const FAssetData& AssetData : TextureAssets)
+void UOptimizationAnalyzer::GetCachedIssues(TArray<FOptimizationIssue>& OutIssues)
+{
+    if (!bIncrementalScan)
     {
-        if (UTexture2D* Texture = Cast<UTexture2D>(AssetData.GetAsset()))
-        {
-            // Only count loaded textures
-            if (Texture->GetPlatformData())
-            {
-                TotalTextureMemory += Texture->CalcTextureMemorySizeEnum(TMC_ResidentMips);
-                LoadedCount++;
-            }
-        }
-
-        // Limit check to avoid long iteration
-        if (LoadedCount > 100) break;
+        return;
     }
 
-    TextureMemoryMB = TotalTextureMemory / (1024.0f * 1024.0f);
+    FOptimizationResultCache& Cache = GetResultCache();
+    Cache.SetSettingsHash(GetRuleSettingsHash());
+    Cache.GetAllIssues(OutIssues);
+}
 
-    return TextureMemoryMB;
+FOptimizationResultCache& UOptimizationAnalyzer::GetResultCache()
+{
+    if (!ResultCache.IsValid())
+    {
+        ResultCache = MakeShared<FOptimizationResultCache>();
+        ResultCache->LoadFromDisk();
+    }
+    return *ResultCache;
 }
 
-TArray<FOptimizationIssue> UOptimizationAnalyzer::CheckMeshes()
+void UOptimizationAnalyzer::SaveResultCache()
 {
-    TArray<FOptimizationIssue> Issues;
+    if (bIncrementalScan && ResultCache.IsValid())
+    {
+        ResultCache->SaveToDisk();
+    }
+}
 
-    FAssetRegistryModule& AssetRegistryModule =
-        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+void UOptimizationAnalyzer::ApplyCachedResults(FOptimizationCheckPassBase& Pass)
+{
+    if (!bIncrementalScan)
+    {
+        return;
+    }
 
-    TArray<FAssetData> MeshAssets;
-    AssetRegistryModule.Get().GetAssetsByClass(
-        UStaticMesh::StaticClass()->GetClassPathName(),
-        MeshAssets
-    );
+    FOptimizationResultCache& Cache = GetResultCache();
+    Cache.SetSettingsHash(GetRuleSettingsHash());
 
-    for (const FAssetData& AssetData : MeshAssets)
+    int32 CacheHits = 0;
+    for (int32 Index = 0; Index < Pass.Assets.Num(); ++Index)
     {
-        UStaticMesh* Mesh = Cast<UStaticMesh>(AssetData.GetAsset());
-        if (!Mesh) continue;
-
-        // Check triangle count
-        int32 TriangleCount = 0;
-        if (Mesh->GetRenderData())
+        const FOptimizationCachedAsset* CachedAsset = Cache.Find(Pass.Assets[Index]);
+        if (!CachedAsset || !Pass.AreCachedDependenciesCurrent(CachedAsset->Metrics))
         {
-            const FStaticMeshLODResources& LOD = Mesh->GetRenderData()->LODResources[0];
-            TriangleCount = LOD.GetNumTriangles();
+            continue;
         }
 
-        if (TriangleCount > MaxTrianglesPerMesh)
+        // Pass-wide rules need the metrics of every asset; with them the asset's own rules
+        // simply run again, that needs no load either
+        if (CachedAsset->bHasIssues && !Pass.HasPassRules())
         {
-            FOptimizationIssue Issue;
-            Issue.Category = EOptimizationCategory::Mesh;
-            Issue.Title = FString::Printf(TEXT("High Poly Count: %s"), *Mesh->GetName());
-
-            // ← НОВАЯ ФОРМУЛА IMPACT
-            // Calculate how much the mesh exceeds the threshold
-            float ExcessRatio = (float)TriangleCount / MaxTrianglesPerMesh;
-            // Impact scales with excess: 10% over = ~16%, 100% over = ~70%, 200% over = 100%
-            float BaseImpact = FMath::Clamp((ExcessRatio - 1.0f) * 60.0f + 10.0f, 10.0f, 100.0f);
-
-            Issue.EstimatedImpact = BaseImpact;
+            Pass.IssuesPerAsset[Index] = CachedAsset->Issues;
+            Pass.Sources[Index] = EOptimizationMetricsSource::Cached;
+            CacheHits++;
+        }
+        else if (!Pass.RequiresLoadedObjects() && Pass.RestoreMetrics(Index, CachedAsset->Metrics))
+        {
+            // Thresholds changed: no load needed, only the rules run again
+            // (rules reading the loaded object always need the asset)
+            CacheHits++;
+        }
+    }
 
-            // Determine severity based on calculated impact
-            if (BaseImpact > 80.0f)
-            {
-                Issue.Severity = EOptimizationSeverity::Critical;
-            }
-            else if (BaseImpact > 50.0f)
-            {
-                Issue.Severity = EOptimizationSeverity::Warning;
-            }
-            else
-            {
-                Issue.Severity = EOptimizationSeverity::Info;
-            }
+    UE_LOG(LogTemp, Log, TEXT("%s pass: %d of %d assets unchanged since the last scan (%d dirty packages)"),
+        *Pass.Name, CacheHits, Pass.Assets.Num(), Cache.GetNumDirtyPackages());
+}
 
-            Issue.Description = FString::Printf(
-                TEXT("Mesh has %d triangles (threshold: %d, %.1fx over limit)"),
-                TriangleCount,
-                MaxTrianglesPerMesh,
-                ExcessRatio
-            );
-            Issue.AssetPath = AssetData.GetObjectPathString();
-            Issue.SuggestedFix = TEXT("Reduce polygon count or create LODs");
-            Issues.Add(Issue);
-        }
+void UOptimizationAnalyzer::StoreResults(const FOptimizationCheckPassBase& Pass, int32 Begin, int32 End)
+{
+    if (!bIncrementalScan || !ResultCache.IsValid())
+    {
+        return;
+    }
 
-        // Check for missing LODs
-        if (Mesh->GetNumLODs() <= 1 && TriangleCount > 10000)
+    for (int32 Index = Begin; Index < End; ++Index)
+    {
+        // Unavailable assets are retried next time, cached ones are already stored
+        if (HasOptimizationMetrics(Pass.Sources[Index]))
         {
-            FOptimizationIssue Issue;
-            Issue.Category = EOptimizationCategory::Mesh;
-            Issue.Title = FString::Printf(TEXT("Missing LODs: %s"), *Mesh->GetName());
-            Issue.Description = FString::Printf(
-                TEXT("High-poly mesh (%d triangles) has no LOD chain"),
-                TriangleCount
-            );
-            Issue.Severity = EOptimizationSeverity::Warning;
-            Issue.AssetPath = AssetData.GetObjectPathString();
-
-            // ← НОВАЯ ФОРМУЛА: Impact based on triangle count
-            // More triangles = more important to have LODs
-            float TriangleRatio = (float)TriangleCount / 50000.0f;
-            Issue.EstimatedImpact = FMath::Clamp(TriangleRatio * 40.0f + 20.0f, 20.0f, 70.0f);
-
-            Issue.SuggestedFix = TEXT("Generate LOD chain");
-            Issues.Add(Issue);
+            TArray<uint8> MetricsBytes;
+            Pass.SaveMetrics(Index, MetricsBytes);
+            ResultCache->Store(Pass.Assets[Index], MoveTemp(MetricsBytes), Pass.IssuesPerAsset[Index]);
         }
     }
-
-    return Issues;
 }
 
-TArray<FOptimizationIssue> UOptimizationAnalyzer::CheckTextures()
+uint32 UOptimizationAnalyzer::GetRuleSettingsHash() const
 {
-    TArray<FOptimizationIssue> Issues;
+    uint32 Hash = FOptimizationRuleRegistry::Get().GetRuleSetHash();
+    Hash = HashCombine(Hash, GetTypeHash(MaxTrianglesPerMesh));
+    Hash = HashCombine(Hash, GetTypeHash(MaxBonesPerSkeletalMesh));
+    Hash = HashCombine(Hash, GetTypeHash(MaxBoneInfluences));
+    Hash = HashCombine(Hash, GetTypeHash(MaxSectionsPerSkeletalMesh));
+    Hash = HashCombine(Hash, GetTypeHash(MaxTextureSize));
+    Hash = HashCombine(Hash, GetTypeHash(MaxBlueprintNodes));
+    Hash = HashCombine(Hash, GetTypeHash(MaxTextureSamplesPerMaterial));
+    Hash = HashCombine(Hash, GetTypeHash(MaxPixelShaderInstructions));
+    Hash = HashCombine(Hash, GetTypeHash(MaxVertexShaderInstructions));
+    Hash = HashCombine(Hash, GetTypeHash(MaxMaterialSamplers));
+    Hash = HashCombine(Hash, GetTypeHash(MinMaterialGraphCost));
+    Hash = HashCombine(Hash, GetTypeHash(MaxPermutationsPerMaterial));
+    Hash = HashCombine(Hash, GetTypeHash(MaxEmittersPerSystem));
+    Hash = HashCombine(Hash, GetTypeHash(MaxCPUParticlesPerSystem));
+    Hash = HashCombine(Hash, GetTypeHash(MaxTranslucentParticlesPerSystem));
+    Hash = HashCombine(Hash, GetTypeHash(MaxAudioSampleRate));
+    Hash = HashCombine(Hash, GetTypeHash(MaxNonStreamingSoundSeconds));
+    Hash = HashCombine(Hash, GetTypeHash(MinAudioSavingsMB));
+    Hash = HashCombine(Hash, GetTypeHash(MinStreamingSavingsMB));
+    return Hash;
+}
 
+TSharedRef<FOptimizationCheckPassBase> UOptimizationAnalyzer::MakeClassPass(UClass* AssetClass)
+{
     FAssetRegistryModule& AssetRegistryModule =
         FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 
-    TArray<FAssetData> TextureAssets;
-    AssetRegistryModule.Get().GetAssetsByClass(
-        UTexture2D::StaticClass()->GetClassPathName(),
-        TextureAssets
-    );
-
-    for (const FAssetData& AssetData : TextureAssets)
+    TArray<FAssetData> Assets;
     {
-        UTexture2D* Texture = Cast<UTexture2D>(AssetData.GetAsset());
-        if (!Texture) continue;
-
-        int32 MaxDimension = FMath::Max(Texture->GetSizeX(), Texture->GetSizeY());
-
-        if (MaxDimension > MaxTextureSize)
-        {
-            FOptimizationIssue Issue;
-            Issue.Category = EOptimizationCategory::Texture;
-            Issue.Title = FString::Printf(TEXT("Large Texture: %s"), *Texture->GetName());
+        FOptimizationProfileCounter& QueryCounter =
+            ScanProfile->FindOrAddCounter(FOptimizationScanProfile::RegistryQuery, EOptimizationProfileKind::Phase);
+        OPTIMIZATION_PROFILE_SCOPE(QueryScope, QueryCounter, 0);
 
-            // ← НОВАЯ ФОРМУЛА IMPACT
-            // Calculate excess ratio
-            float ExcessRatio = (float)MaxDimension / MaxTextureSize;
+        AssetRegistryModule.Get().GetAssetsByClass(
+            AssetClass->GetClassPathName(),
+            Assets
+        );
 
-            // Estimate memory usage (RGBA format)
-            int32 EstimatedMemoryMB = (MaxDimension * MaxDimension * 4) / (1024 * 1024);
+        QueryScope.AddAssets(Assets.Num());
+        QueryScope.AddBytes(Assets.GetAllocatedSize());
+    }
 
-            // Impact based on both size excess and memory cost
-            float SizeImpact = (ExcessRatio - 1.0f) * 45.0f;
-            float MemoryImpact = FMath::Min(EstimatedMemoryMB / 8.0f, 40.0f);  // Up to 40 points for memory
-            float BaseImpact = FMath::Clamp(SizeImpact + MemoryImpact + 10.0f, 10.0f, 100.0f);
+    UE_LOG(LogTemp, Log, TEXT("Checking %d %s assets..."), Assets.Num(), *AssetClass->GetName());
+    const int32 TotalAssetCount = Assets.Num();
 
-            Issue.EstimatedImpact = BaseImpact;
+    TSharedRef<FOptimizationCheckPassBase> Pass = MakePassForClass(AssetClass);
 
-            // Determine severity based on impact
-            if (BaseImpact > 75.0f)
-            {
-                Issue.Severity = EOptimizationSeverity::Critical;
-            }
-            else if (BaseImpact > 45.0f)
-            {
-                Issue.Severity = EOptimizationSeverity::Warning;
-            }
-            else
+    // Skip engine content (before loading anything)
+    if (!Pass->IncludesEngineContent())
+    {
+        Assets.RemoveAll([](const FAssetData& AssetData)
             {
-                Issue.Severity = EOptimizationSeverity::Info;
-            }
+                return FOptimizationCheckPassBase::IsEngineContent(AssetData);
+            });
+    }
 
-            Issue.Description = FString::Printf(
-                TEXT("Texture size: %dx%d (threshold: %d, %.1fx over limit, ~%d MB)"),
-                Texture->GetSizeX(),
-                Texture->GetSizeY(),
-                MaxTextureSize,
-                ExcessRatio,
-                EstimatedMemoryMB
-            );
-            Issue.AssetPath = AssetData.GetObjectPathString();
-            Issue.SuggestedFix = TEXT("Resize texture or enable virtual texturing");
-            Issues.Add(Issue);
-        }
+    Pass->SetAssets(MoveTemp(Assets));
+    ApplyCachedResults(*Pass);
+
+    // Project-wide check, counts engine materials too
+    if (AssetClass == UMaterial::StaticClass())
+    {
+        CheckMaterialInstanceUsage(TotalAssetCount, Pass->TrailingIssues);
     }
 
-    return Issues;
+    return Pass;
 }
 
-TArray<FOptimizationIssue> UOptimizationAnalyzer::CheckMaterials()
+TSharedRef<FOptimizationCheckPassBase> UOptimizationAnalyzer::MakePassForClass(UClass* AssetClass) const
 {
-    TArray<FOptimizationIssue> Issues;
+    const FString Name = AssetClass->GetName();
+    const TArray<TSharedRef<IOptimizationRule>> Rules = FOptimizationRuleRegistry::Get().GetRulesForClass(AssetClass);
 
-    FAssetRegistryModule& AssetRegistryModule =
-        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+    if (AssetClass == UStaticMesh::StaticClass())
+    {
+        return MakeShared<TOptimizationCheckPass<UStaticMesh, FOptimizationMeshMetrics>>(Name, *this, Rules, *ScanProfile);
+    }
+    if (AssetClass == USkeletalMesh::StaticClass())
+    {
+        return MakeShared<TOptimizationCheckPass<USkeletalMesh, FOptimizationSkeletalMeshMetrics>>(Name, *this, Rules, *ScanProfile);
+    }
+    if (AssetClass == UTexture2D::StaticClass())
+    {
+        return MakeShared<TOptimizationCheckPass<UTexture2D, FOptimizationTextureMetrics>>(Name, *this, Rules, *ScanProfile);
+    }
+    if (AssetClass == UMaterial::StaticClass())
+    {
+        return MakeShared<TOptimizationCheckPass<UMaterial, FOptimizationMaterialMetrics>>(Name, *this, Rules, *ScanProfile);
+    }
+    if (AssetClass == UMaterialInstanceConstant::StaticClass())
+    {
+        return MakeShared<TOptimizationCheckPass<UMaterialInstanceConstant, FOptimizationMaterialInstanceMetrics>>(Name, *this, Rules, *ScanProfile);
+    }
+    if (AssetClass == UBlueprint::StaticClass())
+    {
+        return MakeShared<TOptimizationCheckPass<UBlueprint, FOptimizationBlueprintMetrics>>(Name, *this, Rules, *ScanProfile);
+    }
+    if (AssetClass == USoundWave::StaticClass())
+    {
+        return MakeShared<TOptimizationCheckPass<USoundWave, FOptimizationSoundMetrics>>(Name, *this, Rules, *ScanProfile);
+    }
+    if (AssetClass == UParticleSystem::StaticClass())
+    {
+        return MakeShared<TOptimizationCheckPass<UParticleSystem, FOptimizationParticleMetrics>>(Name, *this, Rules, *ScanProfile);
+    }
+    if (AssetClass == UNiagaraSystem::StaticClass())
+    {
+        return MakeShared<TOptimizationCheckPass<UNiagaraSystem, FOptimizationParticleMetrics>>(Name, *this, Rules, *ScanProfile);
+    }
 
-    TArray<FAssetData> MaterialAssets;
-    AssetRegistryModule.Get().GetAssetsByClass(
-        UMaterial::StaticClass()->GetClassPathName(),
-        MaterialAssets
-    );
+    // Classes registered by other modules: rules work on FAssetData or the loaded object
+    return MakeShared<TOptimizationCheckPass<UObject, FOptimizationNoMetrics>>(Name, *this, Rules, *ScanProfile);
+}
 
-    UE_LOG(LogTemp, Log, TEXT("Checking %d materials..."), MaterialAssets.Num());
+void UOptimizationAnalyzer::EvaluateLevelObject(const UObject* Object, FOptimizationLevelScanState& State, TArray<FOptimizationIssue>& OutIssues) const
+{
+    const int32 FirstNewIssue = OutIssues.Num();
 
-    for (const FAssetData& AssetData : MaterialAssets)
+    for (UClass* AssetClass : FOptimizationRuleRegistry::Get().GetAssetClasses())
     {
-        UMaterial* Material = Cast<UMaterial>(AssetData.GetAsset());
-        if (!Material) continue;
+        if (!Object->IsA(AssetClass)) continue;
 
-        // Skip engine materials
-        FString PackagePath = AssetData.PackageName.ToString();
-        if (PackagePath.StartsWith(TEXT("/Engine/")))
+        TSharedPtr<FOptimizationCheckPassBase>& Evaluator = State.Evaluators.FindOrAdd(AssetClass);
+        if (!Evaluator.IsValid())
         {
-            continue;
+            Evaluator = MakePassForClass(AssetClass);
         }
+        Evaluator->EvaluateObject(Object, OutIssues);
+    }
 
-        // Issue 1: Count texture samples
-        TArray<UTexture*> UsedTextures;
-        Material->GetUsedTextures(UsedTextures, EMaterialQualityLevel::High, true, ERHIFeatureLevel::SM5, true);
+    for (int32 Index = FirstNewIssue; Index < OutIssues.Num(); ++Index)
+    {
+        OutIssues[Index].Description += FString::Printf(TEXT(". Used in level '%s'"), *State.WorldName);
+    }
+}
 
-        int32 TextureSampleCount = UsedTextures.Num();
+TArray<FOptimizationIssue> UOptimizationAnalyzer::CheckMeshes()
+{
+    ScanProfile->Reset();
 
-        // ← ИСПОЛЬЗОВАНИЕ ПЕРЕМЕННОЙ
-        if (TextureSampleCount > MaxTextureSamplesPerMaterial)
-        {
-            FOptimizationIssue Issue;
-            Issue.Category = EOptimizationCategory::Material;
-            Issue.Title = FString::Printf(TEXT("Too Many Textures: %s"), *Material->GetName());
+    TArray<TSharedRef<FOptimizationCheckPassBase>> Passes;
+    Passes.Add(MakeClassPass(UStaticMesh::StaticClass()));
+    Passes.Add(MakeClassPass(USkeletalMesh::StaticClass()));
+    TArray<FOptimizationIssue> Issues = RunPasses(MoveTemp(Passes));
 
-            // Calculate impact based on texture count
-            float ExcessRatio = (float)TextureSampleCount / MaxTextureSamplesPerMaterial;  // ← ПЕРЕМЕННАЯ
-            float BaseImpact = FMath::Clamp((ExcessRatio - 1.0f) * 50.0f + 20.0f, 20.0f, 95.0f);
-            Issue.EstimatedImpact = BaseImpact;
+    UE_LOG(LogTemp, Log, TEXT("Mesh check complete: %d issues found"), Issues.Num());
+    return Issues;
+}
 
-            if (BaseImpact > 70.0f)
-            {
-                Issue.Severity = EOptimizationSeverity::Critical;
-            }
-            else if (BaseImpact > 45.0f)
-            {
-                Issue.Severity = EOptimizationSeverity::Warning;
-            }
-            else
-            {
-                Issue.Severity = EOptimizationSeverity::Info;
-            }
+TArray<FOptimizationIssue> UOptimizationAnalyzer::CheckTextures()
+{
+    ScanProfile->Reset();
 
-            Issue.Description = FString::Printf(
-                TEXT("Material uses %d texture samples (recommended: ≤%d). Each texture sample impacts GPU performance."),
-                TextureSampleCount,
-                MaxTextureSamplesPerMaterial  // ← ПЕРЕМЕННАЯ
-            );
-            Issue.AssetPath = AssetData.GetObjectPathString();
-            Issue.SuggestedFix = TEXT("Reduce texture count, combine textures into atlases, or use texture packing (RGB channels)");
-            Issues.Add(Issue);
-        }
+    TArray<TSharedRef<FOptimizationCheckPassBase>> Passes;
+    Passes.Add(MakeClassPass(UTexture2D::StaticClass()));
+    TArray<FOptimizationIssue> Issues = RunPasses(MoveTemp(Passes));
 
-        // Issue 2: Check if Two Sided is enabled
-        if (Material->IsTwoSided())
-        {
-            FOptimizationIssue Issue;
-            Issue.Category = EOptimizationCategory::Material;
-            Issue.Title = FString::Printf(TEXT("Two-Sided Material: %s"), *Material->GetName());
-            Issue.Severity = EOptimizationSeverity::Warning;
-            Issue.EstimatedImpact = 35.0f;
-            Issue.Description = TEXT("Material is set to Two-Sided, which doubles rendering cost. Only use when absolutely necessary (foliage, cloth).");
-            Issue.AssetPath = AssetData.GetObjectPathString();
-            Issue.SuggestedFix = TEXT("Disable Two-Sided if back faces are never visible, or use proper two-sided geometry");
-            Issues.Add(Issue);
-        }
+    UE_LOG(LogTemp, Log, TEXT("Texture check complete: %d issues found"), Issues.Num());
+    LogTextureSavingsReport(Issues);
+    return Issues;
+}
 
-        // Issue 3: Check for expensive blend modes
-        if (Material->GetBlendMode() == BLEND_Translucent ||
-            Material->GetBlendMode() == BLEND_Additive ||
-            Material->GetBlendMode() == BLEND_Modulate)
-        {
-            // Only flag if it also has many textures or is complex
-            if (TextureSampleCount > 5)
-            {
-                FOptimizationIssue Issue;
-                Issue.Category = EOptimizationCategory::Material;
-                Issue.Title = FString::Printf(TEXT("Complex Translucent Material: %s"), *Material->GetName());
-                Issue.Severity = EOptimizationSeverity::Warning;
-
-                float BaseImpact = FMath::Clamp(TextureSampleCount * 8.0f, 30.0f, 80.0f);
-                Issue.EstimatedImpact = BaseImpact;
-
-                Issue.Description = FString::Printf(
-                    TEXT("Translucent material with %d textures. Translucency is expensive and doesn't support many optimizations."),
-                    TextureSampleCount
-                );
-                Issue.AssetPath = AssetData.GetObjectPathString();
-                Issue.SuggestedFix = TEXT("Use Masked blend mode if possible, reduce texture samples, or use simpler shader");
-                Issues.Add(Issue);
-            }
-        }
+void UOptimizationAnalyzer::LogTextureSavingsReport(const TArray<FOptimizationIssue>& Issues) const
+{
+    // Per rule: textures reported and the memory their fixes would free
+    TMap<FName, TPair<int32, float>> SavingsPerRule;
+    float TotalSavingsMB = 0.0f;
 
-        // Issue 4: Check shader complexity
-        int32 EstimatedInstructions = 0;
-        EstimatedInstructions += 50;
-        EstimatedInstructions += TextureSampleCount * 15;
+    for (const FOptimizationIssue& Issue : Issues)
+    {
+        if (Issue.Category != EOptimizationCategory::Texture || Issue.EstimatedSavingsMB <= 0.0f) continue;
 
-        if (Material->IsTwoSided())
-        {
-            EstimatedInstructions *= 2;
-        }
+        TPair<int32, float>& RuleSavings = SavingsPerRule.FindOrAdd(Issue.RuleId, TPair<int32, float>(0, 0.0f));
+        RuleSavings.Key++;
+        RuleSavings.Value += Issue.EstimatedSavingsMB;
+        TotalSavingsMB += Issue.EstimatedSavingsMB;
+    }
 
-        if (Material->GetBlendMode() == BLEND_Translucent)
-        {
-            EstimatedInstructions += 30;
-        }
+    if (SavingsPerRule.Num() == 0)
+    {
+        return;
+    }
 
-        if (EstimatedInstructions > 300)
+    SavingsPerRule.ValueSort([](const TPair<int32, float>& A, const TPair<int32, float>& B)
         {
-            FOptimizationIssue Issue;
-            Issue.Category = EOptimizationCategory::Material;
-            Issue.Title = FString::Printf(TEXT("Complex Shader: %s"), *Material->GetName());
+            return A.Value > B.Value;
+        });
 
-            float ComplexityRatio = (float)EstimatedInstructions / 300.0f;
-            float BaseImpact = FMath::Clamp((ComplexityRatio - 1.0f) * 60.0f + 25.0f, 25.0f, 90.0f);
-            Issue.EstimatedImpact = BaseImpact;
+    UE_LOG(LogTemp, Log, TEXT("Texture memory report (projected, a texture can appear under several rules):"));
+    for (const TPair<FName, TPair<int32, float>>& Entry : SavingsPerRule)
+    {
+        UE_LOG(LogTemp, Log, TEXT("  %-34s %6d textures, up to %.1f MB"), *Entry.Key.ToString(), Entry.Value.Key, Entry.Value.Value);
+    }
+    UE_LOG(LogTemp, Log, TEXT("  Total up to %.1f MB"), TotalSavingsMB);
+}
 
-            if (BaseImpact > 70.0f)
-            {
-                Issue.Severity = EOptimizationSeverity::Critical;
-            }
-            else if (BaseImpact > 45.0f)
-            {
-                Issue.Severity = EOptimizationSeverity::Warning;
-            }
-            else
-            {
-                Issue.Severity = EOptimizationSeverity::Info;
-            }
+TArray<FOptimizationIssue> UOptimizationAnalyzer::CheckMaterials()
+{
+    ScanProfile->Reset();
 
-            Issue.Description = FString::Printf(
-                TEXT("Material has approximately %d shader instructions (threshold: 300). Complex shaders impact GPU performance."),
-                EstimatedInstructions
-            );
-            Issue.AssetPath = AssetData.GetObjectPathString();
-            Issue.SuggestedFix = TEXT("Simplify shader logic, use Material Instances, or create LOD materials");
-            Issues.Add(Issue);
-        }
-    }
+    TArray<TSharedRef<FOptimizationCheckPassBase>> Passes;
+    Passes.Add(MakeClassPass(UMaterial::StaticClass()));
+    Passes.Add(MakeClassPass(UMaterialInstanceConstant::StaticClass()));
+    TArray<FOptimizationIssue> Issues = RunPasses(MoveTemp(Passes));
+
+    UE_LOG(LogTemp, Log, TEXT("Material check complete: %d issues found"), Issues.Num());
+    return Issues;
+}
 
-    // Check Material Instances usage
+void UOptimizationAnalyzer::CheckMaterialInstanceUsage(int32 BaseMaterialCount, TArray<FOptimizationIssue>& OutIssues) const
+{
+    FAssetRegistryModule& AssetRegistryModule =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+
+    // Check Material Instances usage (UMaterialInstance is abstract, instance assets are constants)
     TArray<FAssetData> MaterialInstanceAssets;
     AssetRegistryModule.Get().GetAssetsByClass(
-        UMaterialInstance::StaticClass()->GetClassPathName(),
+        UMaterialInstanceConstant::StaticClass()->GetClassPathName(),
         MaterialInstanceAssets
     );
 
     UE_LOG(LogTemp, Log, TEXT("Checking %d material instances..."), MaterialInstanceAssets.Num());
 
-    int32 BaseMatCount = MaterialAssets.Num();
     int32 InstanceCount = MaterialInstanceAssets.Num();
 
-    if (BaseMatCount > 10 && InstanceCount < BaseMatCount * 2)
+    if (BaseMaterialCount > 10 && InstanceCount < BaseMaterialCount * 2)
     {
         FOptimizationIssue Issue;
         Issue.Category = EOptimizationCategory::Material;
         Issue.Title = TEXT("Project: Underusing Material Instances");
         Issue.Severity = EOptimizationSeverity::Warning;
 
-        float InstanceRatio = (float)InstanceCount / BaseMatCount;
+        float InstanceRatio = (float)InstanceCount / BaseMaterialCount;
         float BaseImpact = FMath::Clamp((3.0f - InstanceRatio) * 20.0f, 25.0f, 60.0f);
         Issue.EstimatedImpact = BaseImpact;
 
         Issue.Description = FString::Printf(
             TEXT("Project has %d base materials but only %d instances (ratio: %.1f:1). Recommended ratio: >3:1"),
-            BaseMatCount,
+            BaseMaterialCount,
             InstanceCount,
             InstanceRatio
         );
         Issue.AssetPath = TEXT("Project-wide");
         Issue.SuggestedFix = TEXT("Create Material Instances instead of new base materials. Use parameter-driven master materials.");
-        Issues.Add(Issue);
+        Issue.RuleId = TEXT("Material.InstanceUsage");
+        OutIssues.Add(Issue);
     }
-
-    UE_LOG(LogTemp, Log, TEXT("Material check complete: %d issues found"), Issues.Num());
-    return Issues;
 }
 
 TArray<FOptimizationIssue> UOptimizationAnalyzer::CheckBlueprints()
 {
-    TArray<FOptimizationIssue> Issues;
-
-    FAssetRegistryModule& AssetRegistryModule =
-        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-
-    TArray<FAssetData> BlueprintAssets;
-    AssetRegistryModule.Get().GetAssetsByClass(
-        UBlueprint::StaticClass()->GetClassPathName(),
-        BlueprintAssets
-    );
-
-    UE_LOG(LogTemp, Log, TEXT("Checking %d blueprints..."), BlueprintAssets.Num());
-
-    for (const FAssetData& AssetData : BlueprintAssets)
-    {
-        UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset());
-        if (!Blueprint) continue;
-
-        // Skip engine content
-        FString PackagePath = AssetData.PackageName.ToString();
-        if (PackagePath.StartsWith(TEXT("/Engine/")))
-        {
-            continue;
-        }
+    ScanProfile->Reset();
 
-        int32 TotalNodes = 0;
-        bool bHasEventTick = false;
-
-        // Count nodes in all graphs
-        for (UEdGraph* Graph : Blueprint->UbergraphPages)
-        {
-            if (!Graph) continue;
-
-            for (UEdGraphNode* Node : Graph->Nodes)
-            {
-                if (!Node) continue;
-
-                TotalNodes++;
-
-                // Check for Event Tick
-                FString NodeTitle = Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString();
-                if (NodeTitle.Contains(TEXT("Event Tick")))
-                {
-                    bHasEventTick = true;
-                }
-            }
-        }
-
-        // Check function graphs as well
-        for (UEdGraph* FunctionGraph : Blueprint->FunctionGraphs)
-        {
-            if (!FunctionGraph) continue;
-
-            for (UEdGraphNode* Node : FunctionGraph->Nodes)
-            {
-                if (Node) TotalNodes++;
-            }
-        }
-
-        // Issue 1: Too many nodes
-        if (TotalNodes > MaxBlueprintNodes)
-        {
-            FOptimizationIssue Issue;
-            Issue.Category = EOptimizationCategory::Blueprint;
-            Issue.Title = FString::Printf(TEXT("Complex Blueprint: %s"), *Blueprint->GetName());
-
-            // ← НОВАЯ ФОРМУЛА IMPACT
-            // Calculate complexity ratio
-            float ExcessRatio = (float)TotalNodes / MaxBlueprintNodes;
-
-            // Base impact from node count excess
-            float BaseImpact = FMath::Clamp((ExcessRatio - 1.0f) * 55.0f + 15.0f, 15.0f, 100.0f);
-
-            // Blueprint complexity affects both compile time and runtime
-            // Large blueprints also harder to maintain
-            Issue.EstimatedImpact = BaseImpact;
-
-            // Determine severity
-            if (BaseImpact > 75.0f)
-            {
-                Issue.Severity = EOptimizationSeverity::Critical;
-            }
-            else if (BaseImpact > 45.0f)
-            {
-                Issue.Severity = EOptimizationSeverity::Warning;
-            }
-            else
-            {
-                Issue.Severity = EOptimizationSeverity::Info;
-            }
-
-            Issue.Description = FString::Printf(
-                TEXT("Blueprint has %d nodes (threshold: %d, %.1fx over limit). Complex blueprints cause compilation and performance issues."),
-                TotalNodes,
-                MaxBlueprintNodes,
-                ExcessRatio
-            );
-            Issue.AssetPath = AssetData.GetObjectPathString();
-            Issue.SuggestedFix = TEXT("Refactor into smaller blueprints or move logic to C++");
-            Issues.Add(Issue);
-        }
-
-        // Issue 2: Has Event Tick
-        if (bHasEventTick && TotalNodes > 100)
-        {
-            FOptimizationIssue Issue;
-            Issue.Category = EOptimizationCategory::Blueprint;
-            Issue.Title = FString::Printf(TEXT("Blueprint with Event Tick: %s"), *Blueprint->GetName());
-
-            // ← НОВАЯ ФОРМУЛА IMPACT
-            // Event Tick is critical - runs every frame!
-            // Impact scales with total blueprint complexity
-            float ComplexityRatio = (float)TotalNodes / 200.0f;
-            float BaseImpact = FMath::Clamp(ComplexityRatio * 60.0f + 25.0f, 25.0f, 95.0f);
-
-            // Tick makes everything worse - multiply by severity
-            Issue.EstimatedImpact = BaseImpact;
-
-            if (BaseImpact > 70.0f)
-            {
-                Issue.Severity = EOptimizationSeverity::Critical;
-            }
-            else if (BaseImpact > 40.0f)
-            {
-                Issue.Severity = EOptimizationSeverity::Warning;
-            }
-            else
-            {
-                Issue.Severity = EOptimizationSeverity::Info;
-            }
-
-            Issue.Description = FString::Printf(
-                TEXT("Blueprint contains Event Tick with %d total nodes. Event Tick runs every frame and significantly impacts performance."),
-                TotalNodes
-            );
-            Issue.AssetPath = AssetData.GetObjectPathString();
-            Issue.SuggestedFix = TEXT("Use Timers instead of Tick, or reduce tick frequency with 'Set Actor Tick Interval'");
-            Issues.Add(Issue);
-        }
-    }
+    TArray<TSharedRef<FOptimizationCheckPassBase>> Passes;
+    Passes.Add(MakeClassPass(UBlueprint::StaticClass()));
+    TArray<FOptimizationIssue> Issues = RunPasses(MoveTemp(Passes));
 
     UE_LOG(LogTemp, Log, TEXT("Blueprint check complete: %d issues found"), Issues.Num());
     return Issues;
@@ -984,12 +679,25 @@ TArray<FOptimizationIssue> UOptimizationAnalyzer::CheckBlueprints()
 
 TArray<FOptimizationIssue> UOptimizationAnalyzer::CheckAudio()
 {
-    TArray<FOptimizationIssue> Issues;
+    ScanProfile->Reset();
+
+    TArray<TSharedRef<FOptimizationCheckPassBase>> Passes;
+    Passes.Add(MakeClassPass(USoundWave::StaticClass()));
+    TArray<FOptimizationIssue> Issues = RunPasses(MoveTemp(Passes));
+
+    UE_LOG(LogTemp, Log, TEXT("Audio check complete: %d issues found"), Issues.Num());
     return Issues;
 }
 
 TArray<FOptimizationIssue> UOptimizationAnalyzer::CheckParticleSystems()
 {
-    TArray<FOptimizationIssue> Issues;
+    ScanProfile->Reset();
+
+    TArray<TSharedRef<FOptimizationCheckPassBase>> Passes;
+    Passes.Add(MakeClassPass(UParticleSystem::StaticClass()));
+    Passes.Add(MakeClassPass(UNiagaraSystem::StaticClass()));
+    TArray<FOptimizationIssue> Issues = RunPasses(MoveTemp(Passes));
+
+    UE_LOG(LogTemp, Log, TEXT("Particle system check complete: %d issues found"), Issues.Num());
     return Issues;
 }
\ No newline at end of file
@@ -0,0 +1,269 @@
+#include "OptimizationAnalyzerCommandlet.h"
+#include "OptimizationScanProfile.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Algo/Count.h"
+#include "Dom/JsonObject.h"
+#include "Engine/World.h"
+#include "EditorWorldUtils.h"
+#include "HAL/FileManager.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/LoaderAdapter/LoaderAdapterShape.h"
+
+UOptimizationAnalyzerCommandlet::UOptimizationAnalyzerCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UOptimizationAnalyzerCommandlet::Main(const FString& Params)
+{
+    UE_LOG(LogTemp, Display, TEXT("OptimizationAnalyzer: %s"), *Params);
+
+    // Commandlets don't wait for the registry's background scan
+    IAssetRegistry::GetChecked().SearchAllAssets(true);
+
+    // Rooted: map loading and batched asset loading collect garbage in between
+    TStrongObjectPtr<UOptimizationAnalyzer> Analyzer(NewObject<UOptimizationAnalyzer>());
+    ApplySettings(Analyzer.Get(), Params);
+
+    if (!FApp::CanEverRender())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("OptimizationAnalyzer: no rendering RHI (-nullrhi), shaders are not compiled. ")
+            TEXT("Material.ShaderComplexity and Material.Samplers only see stats already saved in registry tags."));
+    }
+
+    TArray<FReportEntry> Entries;
+    bool bHadErrors = false;
+
+    FString OutputPath = FPaths::ProjectSavedDir() / TEXT("OptimizationReports") / TEXT("OptimizationReport.json");
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+    if (!FParse::Param(*Params, TEXT("NoProject")))
+    {
+        for (FOptimizationIssue& Issue : Analyzer->AnalyzeProject())
+        {
+            Entries.Add({ TEXT("Project"), MoveTemp(Issue) });
+        }
+
+        // Map scans reset the profile, keep the project scan's one next to the report
+        const FString ProfilePath = FPaths::GetPath(OutputPath) / FPaths::GetBaseFilename(OutputPath) + TEXT("_Profile.csv");
+        if (!Analyzer->GetScanProfile().SaveToCSV(ProfilePath))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("OptimizationAnalyzer: failed to write scan profile to %s"), *ProfilePath);
+        }
+    }
+
+    for (const FString& MapPackageName : GetMapsToAnalyze(Params))
+    {
+        if (!AnalyzeMap(Analyzer.Get(), MapPackageName, Entries))
+        {
+            bHadErrors = true;
+        }
+    }
+
+    int32 MaxCritical = 0;
+    FParse::Value(*Params, TEXT("MaxCritical="), MaxCritical);
+
+    if (!WriteReport(OutputPath, Entries, MaxCritical))
+    {
+        UE_LOG(LogTemp, Error, TEXT("OptimizationAnalyzer: failed to write report to %s"), *OutputPath);
+        bHadErrors = true;
+    }
+
+    const int32 NumCritical = Algo::CountIf(Entries, [](const FReportEntry& Entry)
+        {
+            return Entry.Issue.Severity == EOptimizationSeverity::Critical;
+        });
+
+    UE_LOG(LogTemp, Display, TEXT("OptimizationAnalyzer: %d issues, %d critical (budget %d). Report: %s"),
+        Entries.Num(), NumCritical, MaxCritical, *OutputPath);
+
+    if (bHadErrors)
+    {
+        return 2;
+    }
+
+    if (NumCritical > MaxCritical)
+    {
+        UE_LOG(LogTemp, Error, TEXT("OptimizationAnalyzer: %d critical issues exceed the budget of %d"), NumCritical, MaxCritical);
+        return 1;
+    }
+
+    return 0;
+}
+
+void UOptimizationAnalyzerCommandlet::ApplySettings(UOptimizationAnalyzer* Analyzer, const FString& Params) const
+{
+    FParse::Value(*Params, TEXT("MaxTriangles="), Analyzer->MaxTrianglesPerMesh);
+    FParse::Value(*Params, TEXT("MaxBones="), Analyzer->MaxBonesPerSkeletalMesh);
+    FParse::Value(*Params, TEXT("MaxBoneInfluences="), Analyzer->MaxBoneInfluences);
+    FParse::Value(*Params, TEXT("MaxSkeletalSections="), Analyzer->MaxSectionsPerSkeletalMesh);
+    FParse::Value(*Params, TEXT("MaxTextureSize="), Analyzer->MaxTextureSize);
+    FParse::Value(*Params, TEXT("MaxBlueprintNodes="), Analyzer->MaxBlueprintNodes);
+    FParse::Value(*Params, TEXT("MaxTextureSamples="), Analyzer->MaxTextureSamplesPerMaterial);
+    FParse::Value(*Params, TEXT("MaxPixelShaderInstructions="), Analyzer->MaxPixelShaderInstructions);
+    FParse::Value(*Params, TEXT("MaxVertexShaderInstructions="), Analyzer->MaxVertexShaderInstructions);
+    FParse::Value(*Params, TEXT("MaxSamplers="), Analyzer->MaxMaterialSamplers);
+    FParse::Value(*Params, TEXT("MinMaterialGraphCost="), Analyzer->MinMaterialGraphCost);
+    FParse::Value(*Params, TEXT("MaxPermutations="), Analyzer->MaxPermutationsPerMaterial);
+    FParse::Value(*Params, TEXT("MinStreamingSavingsMB="), Analyzer->MinStreamingSavingsMB);
+    FParse::Value(*Params, TEXT("MaxEmitters="), Analyzer->MaxEmittersPerSystem);
+    FParse::Value(*Params, TEXT("MaxCPUParticles="), Analyzer->MaxCPUParticlesPerSystem);
+    FParse::Value(*Params, TEXT("MaxTranslucentParticles="), Analyzer->MaxTranslucentParticlesPerSystem);
+    FParse::Value(*Params, TEXT("MaxAudioSampleRate="), Analyzer->MaxAudioSampleRate);
+    FParse::Value(*Params, TEXT("MaxNonStreamingSoundSeconds="), Analyzer->MaxNonStreamingSoundSeconds);
+    FParse::Value(*Params, TEXT("MinAudioSavingsMB="), Analyzer->MinAudioSavingsMB);
+    FParse::Value(*Params, TEXT("LoadMemoryBudgetMB="), Analyzer->LoadMemoryBudgetMB);
+
+    if (FParse::Param(*Params, TEXT("FullLoad")))
+    {
+        Analyzer->bMetadataOnlyScan = false;
+    }
+
+    if (FParse::Param(*Params, TEXT("NoCache")))
+    {
+        Analyzer->bIncrementalScan = false;
+    }
+}
+
+TArray<FString> UOptimizationAnalyzerCommandlet::GetMapsToAnalyze(const FString& Params) const
+{
+    TArray<FString> Maps;
+
+    FString MapsParam;
+    if (FParse::Value(*Params, TEXT("Maps="), MapsParam))
+    {
+        MapsParam.ParseIntoArray(Maps, TEXT("+"));
+    }
+    else if (FParse::Param(*Params, TEXT("AllMaps")))
+    {
+        TArray<FAssetData> MapAssets;
+        IAssetRegistry::GetChecked().GetAssetsByClass(UWorld::StaticClass()->GetClassPathName(), MapAssets);
+
+        for (const FAssetData& AssetData : MapAssets)
+        {
+            const FString PackageName = AssetData.PackageName.ToString();
+            if (PackageName.StartsWith(TEXT("/Game/")))
+            {
+                Maps.Add(PackageName);
+            }
+        }
+
+        // Stable report order between runs
+        Maps.Sort();
+    }
+
+    return Maps;
+}
+
+bool UOptimizationAnalyzerCommandlet::AnalyzeMap(UOptimizationAnalyzer* Analyzer, const FString& MapPackageName, TArray<FReportEntry>& OutEntries) const
+{
+    UE_LOG(LogTemp, Display, TEXT("OptimizationAnalyzer: analyzing map %s"), *MapPackageName);
+
+    UPackage* MapPackage = LoadPackage(nullptr, *MapPackageName, LOAD_None);
+    UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+    if (!World)
+    {
+        UE_LOG(LogTemp, Error, TEXT("OptimizationAnalyzer: failed to load map %s"), *MapPackageName);
+        return false;
+    }
+
+    {
+        // A loaded package is not a running world: initialize it the way the editor opens a map,
+        // so components are registered and World Partition is set up. Torn down at scope end.
+        FScopedEditorWorld EditorWorld(World, UWorld::InitializationValues()
+            .RequiresHitProxies(false)
+            .ShouldSimulatePhysics(false)
+            .EnableTraceCollision(false)
+            .CreateNavigation(false)
+            .CreateAISystem(false)
+            .AllowAudioPlayback(false)
+            .CreatePhysicsScene(false));
+
+        // World Partition maps keep their actors in external packages, only loaded on request.
+        // Load all of them, as "Load All" in the editor would; unloaded before the world goes.
+        TUniquePtr<FLoaderAdapterShape> ActorLoader;
+        if (World->GetWorldPartition())
+        {
+            ActorLoader = MakeUnique<FLoaderAdapterShape>(World, FBox(FVector(-HALF_WORLD_MAX), FVector(HALF_WORLD_MAX)), TEXT("Optimization scan"));
+            ActorLoader->Load();
+        }
+
+        for (FOptimizationIssue& Issue : Analyzer->AnalyzeLevel(World))
+        {
+            OutEntries.Add({ MapPackageName, MoveTemp(Issue) });
+        }
+    }
+
+    // Don't keep the previous map around while loading the next one
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    return true;
+}
+
+bool UOptimizationAnalyzerCommandlet::WriteReport(const FString& FilePath, const TArray<FReportEntry>& Entries, int32 MaxCritical) const
+{
+    const UEnum* SeverityEnum = StaticEnum<EOptimizationSeverity>();
+    const UEnum* CategoryEnum = StaticEnum<EOptimizationCategory>();
+
+    int32 NumCritical = 0;
+    int32 NumWarning = 0;
+    int32 NumInfo = 0;
+
+    TArray<TSharedPtr<FJsonValue>> IssueValues;
+    IssueValues.Reserve(Entries.Num());
+
+    for (const FReportEntry& Entry : Entries)
+    {
+        const FOptimizationIssue& Issue = Entry.Issue;
+
+        NumCritical += (Issue.Severity == EOptimizationSeverity::Critical);
+        NumWarning += (Issue.Severity == EOptimizationSeverity::Warning);
+        NumInfo += (Issue.Severity == EOptimizationSeverity::Info);
+
+        TSharedRef<FJsonObject> IssueObject = MakeShared<FJsonObject>();
+        IssueObject->SetStringField(TEXT("source"), Entry.Source);
+        IssueObject->SetStringField(TEXT("rule"), Issue.RuleId.IsNone() ? FString() : Issue.RuleId.ToString());
+        IssueObject->SetStringField(TEXT("severity"), SeverityEnum->GetNameStringByValue((int64)Issue.Severity));
+        IssueObject->SetStringField(TEXT("category"), CategoryEnum->GetNameStringByValue((int64)Issue.Category));
+        IssueObject->SetStringField(TEXT("title"), Issue.Title);
+        IssueObject->SetStringField(TEXT("description"), Issue.Description);
+        IssueObject->SetStringField(TEXT("assetPath"), Issue.AssetPath);
+        IssueObject->SetNumberField(TEXT("estimatedImpact"), Issue.EstimatedImpact);
+        IssueObject->SetNumberField(TEXT("estimatedSavingsMB"), Issue.EstimatedSavingsMB);
+        IssueObject->SetStringField(TEXT("suggestedFix"), Issue.SuggestedFix);
+        IssueValues.Add(MakeShared<FJsonValueObject>(IssueObject));
+    }
+
+    TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+    Summary->SetNumberField(TEXT("total"), Entries.Num());
+    Summary->SetNumberField(TEXT("critical"), NumCritical);
+    Summary->SetNumberField(TEXT("warning"), NumWarning);
+    Summary->SetNumberField(TEXT("info"), NumInfo);
+    Summary->SetNumberField(TEXT("maxCritical"), MaxCritical);
+    Summary->SetBoolField(TEXT("passed"), NumCritical <= MaxCritical);
+
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetStringField(TEXT("project"), FApp::GetProjectName());
+    Root->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+    Root->SetObjectField(TEXT("summary"), Summary);
+    Root->SetArrayField(TEXT("issues"), IssueValues);
+
+    FString JsonText;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonText);
+    if (!FJsonSerializer::Serialize(Root, Writer))
+    {
+        return false;
+    }
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+    return FFileHelper::SaveStringToFile(JsonText, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
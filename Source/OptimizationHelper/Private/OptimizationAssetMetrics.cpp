@@ -0,0 +1,896 @@
+#include "OptimizationAssetMetrics.h"
+#include "OptimizationTextureCost.h"
+#include "OptimizationShaderStats.h"
+#include "AssetRegistry/AssetData.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/SkeletalMesh.h"
+#include "Rendering/SkeletalMeshRenderData.h"
+#include "Rendering/SkeletalMeshLODRenderData.h"
+#include "Engine/Texture2D.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Engine/Blueprint.h"
+#include "Sound/SoundWave.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleEmitter.h"
+#include "Particles/ParticleLODLevel.h"
+#include "Particles/ParticleModuleRequired.h"
+#include "Particles/TypeData/ParticleModuleTypeDataGpu.h"
+#include "NiagaraSystem.h"
+#include "NiagaraEmitter.h"
+#include "NiagaraEmitterHandle.h"
+#include "NiagaraRendererProperties.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Misc/EngineVersionComparison.h"
+#include "UObject/Object.h"
+
+const FName FOptimizationAssetMetrics::TagVersion(TEXT("OptimizationHelper.TagVersion"));
+const FName FOptimizationAssetMetrics::TagTextureSamples(TEXT("OptimizationHelper.TextureSamples"));
+const FName FOptimizationAssetMetrics::TagTwoSided(TEXT("OptimizationHelper.TwoSided"));
+const FName FOptimizationAssetMetrics::TagShaderStats(TEXT("OptimizationHelper.ShaderStats"));
+const FName FOptimizationAssetMetrics::TagMaterialGraph(TEXT("OptimizationHelper.MaterialGraph"));
+const FName FOptimizationAssetMetrics::TagMaterialFunctions(TEXT("OptimizationHelper.MaterialFunctions"));
+const FName FOptimizationAssetMetrics::TagInstanceParent(TEXT("OptimizationHelper.InstanceParent"));
+const FName FOptimizationAssetMetrics::TagInstanceOverrides(TEXT("OptimizationHelper.InstanceOverrides"));
+const FName FOptimizationAssetMetrics::TagStaticDefaults(TEXT("OptimizationHelper.StaticDefaults"));
+const FName FOptimizationAssetMetrics::TagSkeletalLODTriangles(TEXT("OptimizationHelper.SkeletalLODTriangles"));
+const FName FOptimizationAssetMetrics::TagSkeletalBones(TEXT("OptimizationHelper.SkeletalBones"));
+const FName FOptimizationAssetMetrics::TagSkeletalMaxInfluences(TEXT("OptimizationHelper.SkeletalMaxInfluences"));
+const FName FOptimizationAssetMetrics::TagSkeletalSections(TEXT("OptimizationHelper.SkeletalSections"));
+const FName FOptimizationAssetMetrics::TagSkeletalMaterials(TEXT("OptimizationHelper.SkeletalMaterials"));
+const FName FOptimizationAssetMetrics::TagSkeletalSkinWeightBytes(TEXT("OptimizationHelper.SkeletalSkinWeightBytes"));
+const FName FOptimizationAssetMetrics::TagTexturePixelFormat(TEXT("OptimizationHelper.TexturePixelFormat"));
+const FName FOptimizationAssetMetrics::TagTextureMips(TEXT("OptimizationHelper.TextureMips"));
+const FName FOptimizationAssetMetrics::TagTextureLODBias(TEXT("OptimizationHelper.TextureLODBias"));
+const FName FOptimizationAssetMetrics::TagTextureLODGroup(TEXT("OptimizationHelper.TextureLODGroup"));
+const FName FOptimizationAssetMetrics::TagTextureNeverStream(TEXT("OptimizationHelper.TextureNeverStream"));
+const FName FOptimizationAssetMetrics::TagTextureVirtual(TEXT("OptimizationHelper.TextureVirtual"));
+const FName FOptimizationAssetMetrics::TagTexturePadded(TEXT("OptimizationHelper.TexturePadded"));
+const FName FOptimizationAssetMetrics::TagBlueprintNodes(TEXT("OptimizationHelper.BlueprintNodes"));
+const FName FOptimizationAssetMetrics::TagBlueprintEventTick(TEXT("OptimizationHelper.BlueprintEventTick"));
+const FName FOptimizationAssetMetrics::TagSoundDuration(TEXT("OptimizationHelper.SoundDuration"));
+const FName FOptimizationAssetMetrics::TagSoundSampleRate(TEXT("OptimizationHelper.SoundSampleRate"));
+const FName FOptimizationAssetMetrics::TagSoundChannels(TEXT("OptimizationHelper.SoundChannels"));
+const FName FOptimizationAssetMetrics::TagSoundQuality(TEXT("OptimizationHelper.SoundQuality"));
+const FName FOptimizationAssetMetrics::TagSoundCompression(TEXT("OptimizationHelper.SoundCompression"));
+const FName FOptimizationAssetMetrics::TagSoundLoading(TEXT("OptimizationHelper.SoundLoading"));
+const FName FOptimizationAssetMetrics::TagSoundStreaming(TEXT("OptimizationHelper.SoundStreaming"));
+const FName FOptimizationAssetMetrics::TagParticleEmitters(TEXT("OptimizationHelper.ParticleEmitters"));
+const FName FOptimizationAssetMetrics::TagParticleMaxParticles(TEXT("OptimizationHelper.ParticleMaxParticles"));
+const FName FOptimizationAssetMetrics::TagParticleLODs(TEXT("OptimizationHelper.ParticleLODs"));
+const FName FOptimizationAssetMetrics::TagParticleFixedBounds(TEXT("OptimizationHelper.ParticleFixedBounds"));
+const FName FOptimizationAssetMetrics::TagParticleScalability(TEXT("OptimizationHelper.ParticleScalability"));
+
+namespace
+{
+    // Engine tags (written by UStaticMesh / UTexture2D / UMaterial themselves)
+    const FName EngineTagTriangles(TEXT("Triangles"));
+    const FName EngineTagLODs(TEXT("LODs"));
+    const FName EngineTagDimensions(TEXT("Dimensions"));
+    const FName EngineTagBlendMode(TEXT("BlendMode"));
+
+    FDelegateHandle ExtraTagsHandle;
+
+    bool HasCurrentTagVersion(const FAssetData& AssetData)
+    {
+        int32 Version = 0;
+        return AssetData.GetTagValue(FOptimizationAssetMetrics::TagVersion, Version)
+            && Version == FOptimizationAssetMetrics::CurrentTagVersion;
+    }
+
+    void AddParticleTags(const FOptimizationParticleMetrics& Metrics, TFunctionRef<void(FName, const FString&)> AddTag)
+    {
+        // Emitters as "Total,GPU,Translucent"
+        AddTag(FOptimizationAssetMetrics::TagVersion, FString::FromInt(FOptimizationAssetMetrics::CurrentTagVersion));
+        AddTag(FOptimizationAssetMetrics::TagParticleEmitters,
+            FString::Printf(TEXT("%d,%d,%d"), Metrics.NumEmitters, Metrics.NumGPUEmitters, Metrics.NumTranslucentEmitters));
+        AddTag(FOptimizationAssetMetrics::TagParticleMaxParticles,
+            FString::Printf(TEXT("%d,%d,%d"), Metrics.MaxCPUParticles, Metrics.MaxGPUParticles, Metrics.MaxTranslucentParticles));
+        AddTag(FOptimizationAssetMetrics::TagParticleLODs, FString::FromInt(Metrics.NumLODs));
+        AddTag(FOptimizationAssetMetrics::TagParticleFixedBounds, Metrics.bFixedBounds ? TEXT("1") : TEXT("0"));
+        AddTag(FOptimizationAssetMetrics::TagParticleScalability, Metrics.bHasScalability ? TEXT("1") : TEXT("0"));
+    }
+
+    // "12,3,4" into three ints
+    bool ParseIntTriple(const FString& Value, int32& OutA, int32& OutB, int32& OutC)
+    {
+        TArray<FString> Parts;
+        Value.ParseIntoArray(Parts, TEXT(","));
+        return Parts.Num() == 3
+            && LexTryParseString(OutA, *Parts[0])
+            && LexTryParseString(OutB, *Parts[1])
+            && LexTryParseString(OutC, *Parts[2]);
+    }
+
+    // "412,96,5,0" into four ints
+    bool ParseIntQuad(const FString& Value, int32& OutA, int32& OutB, int32& OutC, int32& OutD)
+    {
+        TArray<FString> Parts;
+        Value.ParseIntoArray(Parts, TEXT(","));
+        return Parts.Num() == 4
+            && LexTryParseString(OutA, *Parts[0])
+            && LexTryParseString(OutB, *Parts[1])
+            && LexTryParseString(OutC, *Parts[2])
+            && LexTryParseString(OutD, *Parts[3]);
+    }
+
+    FString MaterialGraphToTag(const FOptimizationMaterialGraphCost& Graph)
+    {
+        FString Value = LexToString(Graph.GraphHash);
+        for (const FOptimizationMaterialPatternCost& PatternCost : Graph.Patterns)
+        {
+            Value += FString::Printf(TEXT(",%d,%d"), PatternCost.Count, PatternCost.Cost);
+        }
+        return Value;
+    }
+
+    bool ParseMaterialGraphTag(const FString& Value, FOptimizationMaterialGraphCost& OutGraph)
+    {
+        TArray<FString> Parts;
+        Value.ParseIntoArray(Parts, TEXT(","));
+        if (Parts.Num() != 1 + 2 * (int32)EOptimizationMaterialPattern::Num
+            || !LexTryParseString(OutGraph.GraphHash, *Parts[0]))
+        {
+            return false;
+        }
+
+        for (int32 Pattern = 0; Pattern < (int32)EOptimizationMaterialPattern::Num; ++Pattern)
+        {
+            if (!LexTryParseString(OutGraph.Patterns[Pattern].Count, *Parts[1 + 2 * Pattern])
+                || !LexTryParseString(OutGraph.Patterns[Pattern].Cost, *Parts[2 + 2 * Pattern]))
+            {
+                return false;
+            }
+        }
+        return OutGraph.GraphHash != 0;
+    }
+
+    FString MaterialFunctionsToTag(const TMap<FName, FIoHash>& FunctionPackages)
+    {
+        FString Value;
+        for (const TPair<FName, FIoHash>& Function : FunctionPackages)
+        {
+            if (!Value.IsEmpty()) Value += TEXT(";");
+            Value += FString::Printf(TEXT("%s=%s"), *Function.Key.ToString(), *LexToString(Function.Value));
+        }
+        return Value.IsEmpty() ? FString(TEXT("-")) : Value;
+    }
+
+    bool ParseMaterialFunctionsTag(const FString& Value, TMap<FName, FIoHash>& OutFunctionPackages)
+    {
+        if (Value == TEXT("-"))
+        {
+            return true;
+        }
+
+        TArray<FString> Entries;
+        Value.ParseIntoArray(Entries, TEXT(";"));
+        for (const FString& Entry : Entries)
+        {
+            FString PackageName;
+            FString SavedHash;
+            if (!Entry.Split(TEXT("="), &PackageName, &SavedHash, ESearchCase::CaseSensitive, ESearchDir::FromEnd)
+                || SavedHash.Len() != 2 * sizeof(FIoHash::ByteArray))
+            {
+                return false;
+            }
+
+            FIoHash Hash;
+            LexFromString(Hash, *SavedHash);
+            OutFunctionPackages.Add(FName(*PackageName), Hash);
+        }
+        return true;
+    }
+
+    FString StaticOverridesToTag(const TMap<FName, int32>& Overrides)
+    {
+        FString Value;
+        for (const TPair<FName, int32>& Override : Overrides)
+        {
+            if (!Value.IsEmpty()) Value += TEXT(";");
+            Value += FString::Printf(TEXT("%s=%d"), *Override.Key.ToString(), Override.Value);
+        }
+        return Value.IsEmpty() ? FString(TEXT("-")) : Value;
+    }
+
+    bool ParseStaticOverridesTag(const FString& Value, TMap<FName, int32>& OutOverrides)
+    {
+        if (Value == TEXT("-"))
+        {
+            return true;
+        }
+
+        TArray<FString> Entries;
+        Value.ParseIntoArray(Entries, TEXT(";"));
+        for (const FString& Entry : Entries)
+        {
+            // Split at the last '=', parameter names may contain one
+            FString Name;
+            FString OverrideValue;
+            int32 OverrideInt = 0;
+            if (!Entry.Split(TEXT("="), &Name, &OverrideValue, ESearchCase::CaseSensitive, ESearchDir::FromEnd)
+                || !LexTryParseString(OverrideInt, *OverrideValue))
+            {
+                return false;
+            }
+            OutOverrides.Add(FName(*Name), OverrideInt);
+        }
+        return true;
+    }
+
+    void CollectExtraTags(const UObject* Object, TFunctionRef<void(FName, const FString&)> AddTag)
+    {
+        if (const UMaterial* Material = Cast<UMaterial>(Object))
+        {
+            FOptimizationMaterialMetrics Metrics;
+            FOptimizationAssetMetrics::ComputeFromObject(Material, Metrics);
+
+            AddTag(FOptimizationAssetMetrics::TagVersion, FString::FromInt(FOptimizationAssetMetrics::CurrentTagVersion));
+            AddTag(FOptimizationAssetMetrics::TagTextureSamples, FString::FromInt(Metrics.TextureSamples));
+            AddTag(FOptimizationAssetMetrics::TagTwoSided, Metrics.bTwoSided ? TEXT("1") : TEXT("0"));
+            AddTag(FOptimizationAssetMetrics::TagMaterialGraph, MaterialGraphToTag(Metrics.Graph));
+            AddTag(FOptimizationAssetMetrics::TagMaterialFunctions, MaterialFunctionsToTag(Metrics.Graph.FunctionPackages));
+
+            TMap<FName, int32> StaticDefaults;
+            FOptimizationAssetMetrics::ComputeStaticDefaults(Material, StaticDefaults);
+            AddTag(FOptimizationAssetMetrics::TagStaticDefaults, StaticOverridesToTag(StaticDefaults));
+
+            // Only once the shaders compiled; without the tag the scan loads the material
+            if (Metrics.bHasShaderStats)
+            {
+                AddTag(FOptimizationAssetMetrics::TagShaderStats, FString::Printf(TEXT("%d,%d,%d,%d"),
+                    Metrics.PixelShaderInstructions, Metrics.VertexShaderInstructions,
+                    Metrics.NumSamplers, Metrics.VirtualTextureLookups));
+            }
+        }
+        else if (const UMaterialInstanceConstant* Instance = Cast<UMaterialInstanceConstant>(Object))
+        {
+            FOptimizationMaterialInstanceMetrics Metrics;
+            FOptimizationAssetMetrics::ComputeFromObject(Instance, Metrics);
+
+            AddTag(FOptimizationAssetMetrics::TagVersion, FString::FromInt(FOptimizationAssetMetrics::CurrentTagVersion));
+            AddTag(FOptimizationAssetMetrics::TagInstanceParent, Metrics.Parent);
+            AddTag(FOptimizationAssetMetrics::TagInstanceOverrides, StaticOverridesToTag(Metrics.StaticOverrides));
+        }
+        else if (const USkeletalMesh* Mesh = Cast<USkeletalMesh>(Object))
+        {
+            FOptimizationSkeletalMeshMetrics Metrics;
+            FOptimizationAssetMetrics::ComputeFromObject(Mesh, Metrics);
+
+            // LOD triangles as "12000,6000,3000"
+            FString LODTriangles;
+            for (int32 Triangles : Metrics.LODTriangles)
+            {
+                if (!LODTriangles.IsEmpty()) LODTriangles += TEXT(",");
+                LODTriangles += FString::FromInt(Triangles);
+            }
+
+            AddTag(FOptimizationAssetMetrics::TagVersion, FString::FromInt(FOptimizationAssetMetrics::CurrentTagVersion));
+            AddTag(FOptimizationAssetMetrics::TagSkeletalLODTriangles, LODTriangles);
+            AddTag(FOptimizationAssetMetrics::TagSkeletalBones, FString::FromInt(Metrics.NumBones));
+            AddTag(FOptimizationAssetMetrics::TagSkeletalMaxInfluences, FString::FromInt(Metrics.MaxBoneInfluences));
+            AddTag(FOptimizationAssetMetrics::TagSkeletalSections, FString::FromInt(Metrics.NumSections));
+            AddTag(FOptimizationAssetMetrics::TagSkeletalMaterials, FString::FromInt(Metrics.NumMaterials));
+            AddTag(FOptimizationAssetMetrics::TagSkeletalSkinWeightBytes, LexToString(Metrics.SkinWeightBytes));
+        }
+        else if (const UTexture2D* Texture = Cast<UTexture2D>(Object))
+        {
+            FOptimizationTextureMetrics Metrics;
+            FOptimizationAssetMetrics::ComputeFromObject(Texture, Metrics);
+
+            AddTag(FOptimizationAssetMetrics::TagVersion, FString::FromInt(FOptimizationAssetMetrics::CurrentTagVersion));
+            AddTag(FOptimizationAssetMetrics::TagTexturePixelFormat, FOptimizationTextureCost::GetPixelFormatName(Metrics.PixelFormat));
+            AddTag(FOptimizationAssetMetrics::TagTextureMips, FString::FromInt(Metrics.NumMips));
+            AddTag(FOptimizationAssetMetrics::TagTextureLODBias, FString::FromInt(Metrics.LODBias));
+            AddTag(FOptimizationAssetMetrics::TagTextureLODGroup, FString::FromInt(Metrics.LODGroup));
+            AddTag(FOptimizationAssetMetrics::TagTextureNeverStream, Metrics.bNeverStream ? TEXT("1") : TEXT("0"));
+            AddTag(FOptimizationAssetMetrics::TagTextureVirtual, Metrics.bVirtualTextureStreaming ? TEXT("1") : TEXT("0"));
+            AddTag(FOptimizationAssetMetrics::TagTexturePadded, Metrics.bPaddedToPowerOfTwo ? TEXT("1") : TEXT("0"));
+        }
+        else if (const UBlueprint* Blueprint = Cast<UBlueprint>(Object))
+        {
+            FOptimizationBlueprintMetrics Metrics;
+            FOptimizationAssetMetrics::ComputeFromObject(Blueprint, Metrics);
+
+            AddTag(FOptimizationAssetMetrics::TagVersion, FString::FromInt(FOptimizationAssetMetrics::CurrentTagVersion));
+            AddTag(FOptimizationAssetMetrics::TagBlueprintNodes, FString::FromInt(Metrics.TotalNodes));
+            AddTag(FOptimizationAssetMetrics::TagBlueprintEventTick, Metrics.bHasEventTick ? TEXT("1") : TEXT("0"));
+        }
+        else if (const UParticleSystem* ParticleSystem = Cast<UParticleSystem>(Object))
+        {
+            FOptimizationParticleMetrics Metrics;
+            FOptimizationAssetMetrics::ComputeFromObject(ParticleSystem, Metrics);
+            AddParticleTags(Metrics, AddTag);
+        }
+        else if (const UNiagaraSystem* NiagaraSystem = Cast<UNiagaraSystem>(Object))
+        {
+            FOptimizationParticleMetrics Metrics;
+            FOptimizationAssetMetrics::ComputeFromObject(NiagaraSystem, Metrics);
+            AddParticleTags(Metrics, AddTag);
+        }
+        else if (const USoundWave* Wave = Cast<USoundWave>(Object))
+        {
+            FOptimizationSoundMetrics Metrics;
+            FOptimizationAssetMetrics::ComputeFromObject(Wave, Metrics);
+
+            AddTag(FOptimizationAssetMetrics::TagVersion, FString::FromInt(FOptimizationAssetMetrics::CurrentTagVersion));
+            AddTag(FOptimizationAssetMetrics::TagSoundDuration, LexToString(Metrics.Duration));
+            AddTag(FOptimizationAssetMetrics::TagSoundSampleRate, FString::FromInt(Metrics.SampleRate));
+            AddTag(FOptimizationAssetMetrics::TagSoundChannels, FString::FromInt(Metrics.NumChannels));
+            AddTag(FOptimizationAssetMetrics::TagSoundQuality, FString::FromInt(Metrics.CompressionQuality));
+            AddTag(FOptimizationAssetMetrics::TagSoundCompression, FString::FromInt((int32)Metrics.CompressionType));
+            AddTag(FOptimizationAssetMetrics::TagSoundLoading, FString::FromInt((int32)Metrics.LoadingBehavior));
+            AddTag(FOptimizationAssetMetrics::TagSoundStreaming, Metrics.bStreaming ? TEXT("1") : TEXT("0"));
+        }
+    }
+
+#if UE_VERSION_OLDER_THAN(5, 4, 0)
+    void OnGetExtraObjectTags(const UObject* Object, TArray<UObject::FAssetRegistryTag>& InOutTags)
+    {
+        CollectExtraTags(Object, [&InOutTags](FName Name, const FString& Value)
+            {
+                InOutTags.Add(UObject::FAssetRegistryTag(Name, Value, UObject::FAssetRegistryTag::TT_Hidden));
+            });
+    }
+#else
+    void OnGetExtraObjectTags(FAssetRegistryTagsContext Context)
+    {
+        CollectExtraTags(Context.GetObject(), [&Context](FName Name, const FString& Value)
+            {
+                Context.AddTag(UObject::FAssetRegistryTag(Name, Value, UObject::FAssetRegistryTag::TT_Hidden));
+            });
+    }
+#endif
+}
+
+void FOptimizationAssetMetrics::RegisterRegistryTags()
+{
+#if UE_VERSION_OLDER_THAN(5, 4, 0)
+    ExtraTagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTags.AddStatic(&OnGetExtraObjectTags);
+#else
+    ExtraTagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.AddStatic(&OnGetExtraObjectTags);
+#endif
+}
+
+void FOptimizationAssetMetrics::UnregisterRegistryTags()
+{
+#if UE_VERSION_OLDER_THAN(5, 4, 0)
+    UObject::FAssetRegistryTag::OnGetExtraObjectTags.Remove(ExtraTagsHandle);
+#else
+    UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.Remove(ExtraTagsHandle);
+#endif
+    ExtraTagsHandle.Reset();
+}
+
+// ==================== REGISTRY (NO LOAD) ====================
+
+bool FOptimizationAssetMetrics::ReadFromRegistry(const FAssetData& AssetData, FOptimizationMeshMetrics& OutMetrics)
+{
+    return AssetData.GetTagValue(EngineTagTriangles, OutMetrics.Triangles)
+        && AssetData.GetTagValue(EngineTagLODs, OutMetrics.NumLODs);
+}
+
+bool FOptimizationAssetMetrics::ReadFromRegistry(const FAssetData& AssetData, FOptimizationSkeletalMeshMetrics& OutMetrics)
+{
+    if (!HasCurrentTagVersion(AssetData))
+    {
+        return false;
+    }
+
+    FString LODTrianglesStr;
+    if (!AssetData.GetTagValue(TagSkeletalLODTriangles, LODTrianglesStr)
+        || !AssetData.GetTagValue(TagSkeletalBones, OutMetrics.NumBones)
+        || !AssetData.GetTagValue(TagSkeletalMaxInfluences, OutMetrics.MaxBoneInfluences)
+        || !AssetData.GetTagValue(TagSkeletalSections, OutMetrics.NumSections)
+        || !AssetData.GetTagValue(TagSkeletalMaterials, OutMetrics.NumMaterials)
+        || !AssetData.GetTagValue(TagSkeletalSkinWeightBytes, OutMetrics.SkinWeightBytes))
+    {
+        return false;
+    }
+
+    TArray<FString> LODTriangles;
+    LODTrianglesStr.ParseIntoArray(LODTriangles, TEXT(","));
+
+    OutMetrics.LODTriangles.Reset(LODTriangles.Num());
+    for (const FString& Triangles : LODTriangles)
+    {
+        if (!LexTryParseString(OutMetrics.LODTriangles.AddDefaulted_GetRef(), *Triangles))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FOptimizationAssetMetrics::ReadFromRegistry(const FAssetData& AssetData, FOptimizationTextureMetrics& OutMetrics)
+{
+    // Stored as "2048x1024"
+    FString Dimensions;
+    if (!AssetData.GetTagValue(EngineTagDimensions, Dimensions))
+    {
+        return false;
+    }
+
+    FString SizeXStr, SizeYStr;
+    if (!Dimensions.Split(TEXT("x"), &SizeXStr, &SizeYStr))
+    {
+        return false;
+    }
+
+    if (!LexTryParseString(OutMetrics.SizeX, *SizeXStr)
+        || !LexTryParseString(OutMetrics.SizeY, *SizeYStr))
+    {
+        return false;
+    }
+
+    // Format, mips and LOD settings come from our own tags; assets saved before them are loaded
+    if (!HasCurrentTagVersion(AssetData))
+    {
+        return false;
+    }
+
+    FString PixelFormatStr;
+    int32 LODGroup = 0;
+    if (!AssetData.GetTagValue(TagTexturePixelFormat, PixelFormatStr)
+        || !AssetData.GetTagValue(TagTextureMips, OutMetrics.NumMips)
+        || !AssetData.GetTagValue(TagTextureLODBias, OutMetrics.LODBias)
+        || !AssetData.GetTagValue(TagTextureLODGroup, LODGroup)
+        || !AssetData.GetTagValue(TagTextureNeverStream, OutMetrics.bNeverStream)
+        || !AssetData.GetTagValue(TagTextureVirtual, OutMetrics.bVirtualTextureStreaming)
+        || !AssetData.GetTagValue(TagTexturePadded, OutMetrics.bPaddedToPowerOfTwo))
+    {
+        return false;
+    }
+
+    OutMetrics.PixelFormat = FOptimizationTextureCost::FindPixelFormat(PixelFormatStr);
+    OutMetrics.LODGroup = (TextureGroup)FMath::Clamp(LODGroup, 0, TEXTUREGROUP_MAX - 1);
+    OutMetrics.NumSlices = 1;
+    return OutMetrics.PixelFormat != PF_Unknown;
+}
+
+bool FOptimizationAssetMetrics::ReadFromRegistry(const FAssetData& AssetData, FOptimizationMaterialMetrics& OutMetrics)
+{
+    if (!HasCurrentTagVersion(AssetData))
+    {
+        return false;
+    }
+
+    FString BlendModeStr;
+    if (!AssetData.GetTagValue(EngineTagBlendMode, BlendModeStr))
+    {
+        return false;
+    }
+
+    const int64 BlendModeValue = StaticEnum<EBlendMode>()->GetValueByNameString(BlendModeStr);
+    if (BlendModeValue == INDEX_NONE)
+    {
+        return false;
+    }
+    OutMetrics.BlendMode = static_cast<EBlendMode>(BlendModeValue);
+
+    // Optional: only written once the shaders compiled, which never happens without a
+    // rendering RHI. The other tags are still enough to skip the load.
+    FString ShaderStats;
+    OutMetrics.bHasShaderStats = AssetData.GetTagValue(TagShaderStats, ShaderStats)
+        && ParseIntQuad(ShaderStats, OutMetrics.PixelShaderInstructions, OutMetrics.VertexShaderInstructions,
+            OutMetrics.NumSamplers, OutMetrics.VirtualTextureLookups);
+    if (!OutMetrics.bHasShaderStats)
+    {
+        OutMetrics.PixelShaderInstructions = 0;
+        OutMetrics.VertexShaderInstructions = 0;
+        OutMetrics.NumSamplers = 0;
+        OutMetrics.VirtualTextureLookups = 0;
+    }
+
+    FString MaterialGraph;
+    if (!AssetData.GetTagValue(TagMaterialGraph, MaterialGraph) || !ParseMaterialGraphTag(MaterialGraph, OutMetrics.Graph))
+    {
+        return false;
+    }
+
+    // A material function saved after the material makes the graph tag stale
+    FString MaterialFunctions;
+    if (!AssetData.GetTagValue(TagMaterialFunctions, MaterialFunctions)
+        || !ParseMaterialFunctionsTag(MaterialFunctions, OutMetrics.Graph.FunctionPackages)
+        || !AreDependenciesCurrent(OutMetrics))
+    {
+        return false;
+    }
+
+    return AssetData.GetTagValue(TagTextureSamples, OutMetrics.TextureSamples)
+        && AssetData.GetTagValue(TagTwoSided, OutMetrics.bTwoSided);
+}
+
+bool FOptimizationAssetMetrics::ReadFromRegistry(const FAssetData& AssetData, FOptimizationMaterialInstanceMetrics& OutMetrics)
+{
+    if (!HasCurrentTagVersion(AssetData))
+    {
+        return false;
+    }
+
+    FString Overrides;
+    return AssetData.GetTagValue(TagInstanceParent, OutMetrics.Parent)
+        && AssetData.GetTagValue(TagInstanceOverrides, Overrides)
+        && ParseStaticOverridesTag(Overrides, OutMetrics.StaticOverrides);
+}
+
+bool FOptimizationAssetMetrics::ReadFromRegistry(const FAssetData& AssetData, FOptimizationBlueprintMetrics& OutMetrics)
+{
+    if (!HasCurrentTagVersion(AssetData))
+    {
+        return false;
+    }
+
+    return AssetData.GetTagValue(TagBlueprintNodes, OutMetrics.TotalNodes)
+        && AssetData.GetTagValue(TagBlueprintEventTick, OutMetrics.bHasEventTick);
+}
+
+bool FOptimizationAssetMetrics::ReadFromRegistry(const FAssetData& AssetData, FOptimizationSoundMetrics& OutMetrics)
+{
+    if (!HasCurrentTagVersion(AssetData))
+    {
+        return false;
+    }
+
+    int32 CompressionType = 0;
+    int32 LoadingBehavior = 0;
+    if (!AssetData.GetTagValue(TagSoundDuration, OutMetrics.Duration)
+        || !AssetData.GetTagValue(TagSoundSampleRate, OutMetrics.SampleRate)
+        || !AssetData.GetTagValue(TagSoundChannels, OutMetrics.NumChannels)
+        || !AssetData.GetTagValue(TagSoundQuality, OutMetrics.CompressionQuality)
+        || !AssetData.GetTagValue(TagSoundCompression, CompressionType)
+        || !AssetData.GetTagValue(TagSoundLoading, LoadingBehavior)
+        || !AssetData.GetTagValue(TagSoundStreaming, OutMetrics.bStreaming))
+    {
+        return false;
+    }
+
+    OutMetrics.CompressionType = (ESoundAssetCompressionType)CompressionType;
+    OutMetrics.LoadingBehavior = (ESoundWaveLoadingBehavior)LoadingBehavior;
+    return true;
+}
+
+bool FOptimizationAssetMetrics::ReadFromRegistry(const FAssetData& AssetData, FOptimizationParticleMetrics& OutMetrics)
+{
+    if (!HasCurrentTagVersion(AssetData))
+    {
+        return false;
+    }
+
+    FString Emitters, MaxParticles;
+    return AssetData.GetTagValue(TagParticleEmitters, Emitters)
+        && AssetData.GetTagValue(TagParticleMaxParticles, MaxParticles)
+        && AssetData.GetTagValue(TagParticleLODs, OutMetrics.NumLODs)
+        && AssetData.GetTagValue(TagParticleFixedBounds, OutMetrics.bFixedBounds)
+        && AssetData.GetTagValue(TagParticleScalability, OutMetrics.bHasScalability)
+        && ParseIntTriple(Emitters, OutMetrics.NumEmitters, OutMetrics.NumGPUEmitters, OutMetrics.NumTranslucentEmitters)
+        && ParseIntTriple(MaxParticles, OutMetrics.MaxCPUParticles, OutMetrics.MaxGPUParticles, OutMetrics.MaxTranslucentParticles);
+}
+
+// ==================== LOADED OBJECT ====================
+
+void FOptimizationAssetMetrics::ComputeFromObject(const UStaticMesh* Mesh, FOptimizationMeshMetrics& OutMetrics)
+{
+    OutMetrics = FOptimizationMeshMetrics();
+    if (!Mesh) return;
+
+    const FStaticMeshRenderData* RenderData = Mesh->GetRenderData();
+    if (RenderData && RenderData->LODResources.Num() > 0)
+    {
+        OutMetrics.Triangles = RenderData->LODResources[0].GetNumTriangles();
+    }
+    OutMetrics.NumLODs = Mesh->GetNumLODs();
+}
+
+void FOptimizationAssetMetrics::ComputeFromObject(const USkeletalMesh* Mesh, FOptimizationSkeletalMeshMetrics& OutMetrics)
+{
+    OutMetrics = FOptimizationSkeletalMeshMetrics();
+    if (!Mesh) return;
+
+    OutMetrics.NumBones = Mesh->GetRefSkeleton().GetRawBoneNum();
+    OutMetrics.NumMaterials = Mesh->GetMaterials().Num();
+
+    const FSkeletalMeshRenderData* RenderData = Mesh->GetResourceForRendering();
+    if (!RenderData) return;
+
+    for (const FSkeletalMeshLODRenderData& LODData : RenderData->LODRenderData)
+    {
+        int32 Triangles = 0;
+        for (const FSkelMeshRenderSection& Section : LODData.RenderSections)
+        {
+            Triangles += Section.NumTriangles;
+        }
+        OutMetrics.LODTriangles.Add(Triangles);
+
+        OutMetrics.MaxBoneInfluences = FMath::Max<int32>(OutMetrics.MaxBoneInfluences, LODData.SkinWeightVertexBuffer.GetMaxBoneInfluences());
+        OutMetrics.SkinWeightBytes += LODData.SkinWeightVertexBuffer.GetVertexDataSize();
+    }
+
+    if (RenderData->LODRenderData.Num() > 0)
+    {
+        OutMetrics.NumSections = RenderData->LODRenderData[0].RenderSections.Num();
+    }
+}
+
+void FOptimizationAssetMetrics::ComputeFromObject(const UTexture2D* Texture, FOptimizationTextureMetrics& OutMetrics)
+{
+    OutMetrics = FOptimizationTextureMetrics();
+    if (!Texture) return;
+
+    OutMetrics.SizeX = Texture->GetSizeX();
+    OutMetrics.SizeY = Texture->GetSizeY();
+    OutMetrics.PixelFormat = Texture->GetPixelFormat();
+    OutMetrics.NumMips = Texture->GetNumMips();
+    OutMetrics.NumSlices = 1;
+    OutMetrics.LODBias = Texture->LODBias;
+    OutMetrics.LODGroup = Texture->LODGroup;
+    OutMetrics.bNeverStream = Texture->NeverStream;
+    OutMetrics.bVirtualTextureStreaming = Texture->VirtualTextureStreaming;
+    OutMetrics.bPaddedToPowerOfTwo = Texture->PowerOfTwoMode != ETexturePowerOfTwoSetting::None;
+}
+
+void FOptimizationAssetMetrics::ComputeFromObject(const UMaterial* Material, FOptimizationMaterialMetrics& OutMetrics)
+{
+    OutMetrics = FOptimizationMaterialMetrics();
+    if (!Material) return;
+
+    TArray<UTexture*> UsedTextures;
+    Material->GetUsedTextures(UsedTextures, EMaterialQualityLevel::High, true, ERHIFeatureLevel::SM5, true);
+
+    OutMetrics.TextureSamples = UsedTextures.Num();
+    OutMetrics.bTwoSided = Material->IsTwoSided();
+    OutMetrics.BlendMode = Material->GetBlendMode();
+
+    FOptimizationShaderStats::Read(Material, OutMetrics);
+    FOptimizationMaterialGraph::Analyze(Material, OutMetrics.Graph);
+}
+
+bool FOptimizationAssetMetrics::IsReadyToCompute(const UMaterial* Material)
+{
+    return !FOptimizationShaderStats::IsCompiling(Material);
+}
+
+void FOptimizationAssetMetrics::FinishPendingWork(const TArray<const UMaterial*>& Materials)
+{
+    FOptimizationShaderStats::FinishCompilation(Materials);
+}
+
+bool FOptimizationAssetMetrics::AreDependenciesCurrent(const FOptimizationMaterialMetrics& Metrics)
+{
+    return FOptimizationMaterialGraph::AreFunctionsCurrent(Metrics.Graph);
+}
+
+void FOptimizationAssetMetrics::ComputeFromObject(const UMaterialInstanceConstant* Instance, FOptimizationMaterialInstanceMetrics& OutMetrics)
+{
+    OutMetrics = FOptimizationMaterialInstanceMetrics();
+    if (!Instance) return;
+
+    OutMetrics.Parent = Instance->Parent ? Instance->Parent->GetPathName() : FString();
+
+    // Only what this instance sets, not the values resolved along the parent chain
+    const FStaticParameterSet StaticParameters = Instance->GetStaticParameters();
+    for (const FStaticSwitchParameter& Switch : StaticParameters.StaticSwitchParameters)
+    {
+        if (Switch.bOverride)
+        {
+            OutMetrics.StaticOverrides.Add(Switch.ParameterInfo.Name, Switch.Value ? 1 : 0);
+        }
+    }
+    for (const FStaticComponentMaskParameter& Mask : StaticParameters.EditorOnly.StaticComponentMaskParameters)
+    {
+        if (Mask.bOverride)
+        {
+            OutMetrics.StaticOverrides.Add(Mask.ParameterInfo.Name, Mask.R | (Mask.G << 1) | (Mask.B << 2) | (Mask.A << 3));
+        }
+    }
+
+    // Base property overrides are compiled in as well
+    const FMaterialInstanceBasePropertyOverrides& Overrides = Instance->BasePropertyOverrides;
+    if (Overrides.bOverride_BlendMode)
+    {
+        OutMetrics.StaticOverrides.Add(TEXT("@BlendMode"), (int32)Overrides.BlendMode);
+    }
+    if (Overrides.bOverride_ShadingModel)
+    {
+        OutMetrics.StaticOverrides.Add(TEXT("@ShadingModel"), (int32)Overrides.ShadingModel);
+    }
+    if (Overrides.bOverride_TwoSided)
+    {
+        OutMetrics.StaticOverrides.Add(TEXT("@TwoSided"), Overrides.TwoSided ? 1 : 0);
+    }
+    if (Overrides.bOverride_DitheredLODTransition)
+    {
+        OutMetrics.StaticOverrides.Add(TEXT("@DitheredLODTransition"), Overrides.DitheredLODTransition ? 1 : 0);
+    }
+    if (Overrides.bOverride_OpacityMaskClipValue)
+    {
+        OutMetrics.StaticOverrides.Add(TEXT("@OpacityMaskClipValue"), FMath::RoundToInt(Overrides.OpacityMaskClipValue * 1000.0f));
+    }
+}
+
+bool FOptimizationAssetMetrics::IsTranslucentBlendMode(EBlendMode BlendMode)
+{
+    return BlendMode == BLEND_Translucent || BlendMode == BLEND_Additive || BlendMode == BLEND_Modulate
+        || BlendMode == BLEND_AlphaComposite || BlendMode == BLEND_AlphaHoldout;
+}
+
+void FOptimizationAssetMetrics::ComputeStaticDefaults(const UMaterial* Material, TMap<FName, int32>& OutDefaults)
+{
+    OutDefaults.Reset();
+    if (!Material) return;
+
+    // Parameters of called material functions included, encoded as in ComputeFromObject(Instance)
+    TMap<FMaterialParameterInfo, FMaterialParameterMetadata> Parameters;
+    Material->GetAllParameterInfoOfType(EMaterialParameterType::StaticSwitch, Parameters);
+    for (const TPair<FMaterialParameterInfo, FMaterialParameterMetadata>& Parameter : Parameters)
+    {
+        OutDefaults.Add(Parameter.Key.Name, Parameter.Value.Value.AsStaticSwitch() ? 1 : 0);
+    }
+
+    Parameters.Reset();
+    Material->GetAllParameterInfoOfType(EMaterialParameterType::StaticComponentMask, Parameters);
+    for (const TPair<FMaterialParameterInfo, FMaterialParameterMetadata>& Parameter : Parameters)
+    {
+        const FStaticComponentMaskValue Mask = Parameter.Value.Value.AsStaticComponentMask();
+        OutDefaults.Add(Parameter.Key.Name, Mask.R | (Mask.G << 1) | (Mask.B << 2) | (Mask.A << 3));
+    }
+
+    OutDefaults.Add(TEXT("@BlendMode"), (int32)Material->GetBlendMode());
+    OutDefaults.Add(TEXT("@ShadingModel"), (int32)Material->GetShadingModels().GetFirstShadingModel());
+    OutDefaults.Add(TEXT("@TwoSided"), Material->IsTwoSided() ? 1 : 0);
+    OutDefaults.Add(TEXT("@DitheredLODTransition"), Material->IsDitheredLODTransition() ? 1 : 0);
+    OutDefaults.Add(TEXT("@OpacityMaskClipValue"), FMath::RoundToInt(Material->GetOpacityMaskClipValue() * 1000.0f));
+}
+
+bool FOptimizationAssetMetrics::ReadStaticDefaults(const FAssetData& AssetData, TMap<FName, int32>& OutDefaults)
+{
+    OutDefaults.Reset();
+
+    FString Defaults;
+    return HasCurrentTagVersion(AssetData)
+        && AssetData.GetTagValue(TagStaticDefaults, Defaults)
+        && ParseStaticOverridesTag(Defaults, OutDefaults);
+}
+
+void FOptimizationAssetMetrics::ComputeFromObject(const UBlueprint* Blueprint, FOptimizationBlueprintMetrics& OutMetrics)
+{
+    OutMetrics = FOptimizationBlueprintMetrics();
+    if (!Blueprint) return;
+
+    // Count nodes in all graphs
+    for (const UEdGraph* Graph : Blueprint->UbergraphPages)
+    {
+        if (!Graph) continue;
+
+        for (const UEdGraphNode* Node : Graph->Nodes)
+        {
+            if (!Node) continue;
+
+            OutMetrics.TotalNodes++;
+
+            // Check for Event Tick
+            FString NodeTitle = Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString();
+            if (NodeTitle.Contains(TEXT("Event Tick")))
+            {
+                OutMetrics.bHasEventTick = true;
+            }
+        }
+    }
+
+    // Check function graphs as well
+    for (const UEdGraph* FunctionGraph : Blueprint->FunctionGraphs)
+    {
+        if (!FunctionGraph) continue;
+
+        for (const UEdGraphNode* Node : FunctionGraph->Nodes)
+        {
+            if (Node) OutMetrics.TotalNodes++;
+        }
+    }
+}
+
+void FOptimizationAssetMetrics::ComputeFromObject(const USoundWave* Wave, FOptimizationSoundMetrics& OutMetrics)
+{
+    OutMetrics = FOptimizationSoundMetrics();
+    if (!Wave) return;
+
+    OutMetrics.Duration = Wave->GetDuration();
+    OutMetrics.SampleRate = FMath::RoundToInt(Wave->GetSampleRateForCurrentPlatform());
+    OutMetrics.NumChannels = Wave->NumChannels;
+    OutMetrics.CompressionQuality = Wave->GetCompressionQuality();
+    OutMetrics.CompressionType = Wave->GetSoundAssetCompressionType();
+
+    // The wave's own setting; what sound classes add can change without the wave being saved
+    OutMetrics.LoadingBehavior = Wave->GetLoadingBehavior(false);
+    OutMetrics.bStreaming = Wave->IsStreaming();
+}
+
+void FOptimizationAssetMetrics::ComputeFromObject(const UParticleSystem* System, FOptimizationParticleMetrics& OutMetrics)
+{
+    OutMetrics = FOptimizationParticleMetrics();
+    if (!System) return;
+
+    for (const UParticleEmitter* Emitter : System->Emitters)
+    {
+        const UParticleLODLevel* LOD0 = (Emitter && Emitter->LODLevels.Num() > 0) ? Emitter->LODLevels[0] : nullptr;
+        if (!LOD0 || !LOD0->bEnabled) continue;
+
+        OutMetrics.NumEmitters++;
+        OutMetrics.NumLODs = FMath::Max(OutMetrics.NumLODs, Emitter->LODLevels.Num());
+
+        const int32 PeakParticles = LOD0->PeakActiveParticles;
+        if (LOD0->TypeDataModule && LOD0->TypeDataModule->IsA<UParticleModuleTypeDataGpu>())
+        {
+            OutMetrics.NumGPUEmitters++;
+            OutMetrics.MaxGPUParticles += PeakParticles;
+        }
+        else
+        {
+            OutMetrics.MaxCPUParticles += PeakParticles;
+        }
+
+        const UMaterialInterface* Material = LOD0->RequiredModule ? LOD0->RequiredModule->Material : nullptr;
+        if (Material && IsTranslucentBlendMode(Material->GetBlendMode()))
+        {
+            OutMetrics.NumTranslucentEmitters++;
+            OutMetrics.MaxTranslucentParticles += PeakParticles;
+        }
+    }
+
+    OutMetrics.bFixedBounds = System->bUseFixedRelativeBoundingBox;
+    OutMetrics.bHasScalability = OutMetrics.NumLODs > 1;
+}
+
+void FOptimizationAssetMetrics::ComputeFromObject(const UNiagaraSystem* System, FOptimizationParticleMetrics& OutMetrics)
+{
+    OutMetrics = FOptimizationParticleMetrics();
+    if (!System) return;
+
+    bool bAllEmittersFixedBounds = true;
+    for (const FNiagaraEmitterHandle& Handle : System->GetEmitterHandles())
+    {
+        FVersionedNiagaraEmitterData* EmitterData = Handle.GetIsEnabled() ? Handle.GetEmitterData() : nullptr;
+        if (!EmitterData) continue;
+
+        OutMetrics.NumEmitters++;
+
+        const int32 MaxParticles = EmitterData->AllocationMode == EParticleAllocationMode::ManualEstimate
+            ? EmitterData->PreAllocationCount
+            : EmitterData->GetMaxParticleCountEstimate();
+
+        if (EmitterData->SimTarget == ENiagaraSimTarget::GPUComputeSim)
+        {
+            OutMetrics.NumGPUEmitters++;
+            OutMetrics.MaxGPUParticles += MaxParticles;
+        }
+        else
+        {
+            OutMetrics.MaxCPUParticles += MaxParticles;
+        }
+
+        bool bTranslucent = false;
+        for (const UNiagaraRendererProperties* Renderer : EmitterData->GetRenderers())
+        {
+            if (!Renderer || !Renderer->GetIsEnabled()) continue;
+
+            TArray<UMaterialInterface*> Materials;
+            Renderer->GetUsedMaterials(nullptr, Materials);
+            for (const UMaterialInterface* Material : Materials)
+            {
+                bTranslucent |= Material && IsTranslucentBlendMode(Material->GetBlendMode());
+            }
+        }
+        if (bTranslucent)
+        {
+            OutMetrics.NumTranslucentEmitters++;
+            OutMetrics.MaxTranslucentParticles += MaxParticles;
+        }
+
+        bAllEmittersFixedBounds &= EmitterData->CalculateBoundsMode == ENiagaraEmitterCalculateBoundMode::Fixed;
+        OutMetrics.bHasScalability |= EmitterData->ScalabilityOverrides.Overrides.Num() > 0;
+    }
+
+    OutMetrics.bFixedBounds = System->bFixedBounds || (OutMetrics.NumEmitters > 0 && bAllEmittersFixedBounds);
+    OutMetrics.bHasScalability |= System->GetEffectType() != nullptr;
+}
@@ -0,0 +1,72 @@
+#include "OptimizationAudioCost.h"
+#include "OptimizationAssetMetrics.h"
+#include "Sound/SoundWave.h"
+
+float FOptimizationAudioCost::GetBitsPerSample(const FOptimizationSoundMetrics& Metrics)
+{
+    switch (Metrics.CompressionType)
+    {
+    case ESoundAssetCompressionType::PCM:
+        return 16.0f;
+    case ESoundAssetCompressionType::ADPCM:
+        return 4.0f;
+    default:
+        // Perceptual codecs (Bink, Opus, platform and project default): about 0.5 bits at
+        // quality 1 to 2 bits at quality 100, ~60 kbps per channel at 48 kHz and the default 40
+        return 0.5f + 1.5f * FMath::Clamp(Metrics.CompressionQuality, 1, 100) / 100.0f;
+    }
+}
+
+int64 FOptimizationAudioCost::CalcCompressedBytes(const FOptimizationSoundMetrics& Metrics)
+{
+    const double Samples = (double)Metrics.Duration * Metrics.SampleRate * FMath::Max(Metrics.NumChannels, 1);
+    return (int64)(Samples * GetBitsPerSample(Metrics) / 8.0);
+}
+
+int64 FOptimizationAudioCost::CalcResidentBytes(const FOptimizationSoundMetrics& Metrics)
+{
+    const int64 CompressedBytes = CalcCompressedBytes(Metrics);
+
+    // Force Inline turns streaming off
+    if (!Metrics.bStreaming || Metrics.LoadingBehavior == ESoundWaveLoadingBehavior::ForceInline)
+    {
+        return CompressedBytes;
+    }
+
+    // Inherited depends on the sound class and project default; counted as the costlier Retain On Load
+    switch (Metrics.LoadingBehavior)
+    {
+    case ESoundWaveLoadingBehavior::PrimeOnLoad:
+    case ESoundWaveLoadingBehavior::LoadOnDemand:
+        return 0;
+    default:
+        return FMath::Min(CompressedBytes, StreamingChunkBytes);
+    }
+}
+
+const TCHAR* FOptimizationAudioCost::GetCompressionTypeName(ESoundAssetCompressionType Type)
+{
+    switch (Type)
+    {
+    case ESoundAssetCompressionType::BinkAudio: return TEXT("Bink Audio");
+    case ESoundAssetCompressionType::ADPCM: return TEXT("ADPCM");
+    case ESoundAssetCompressionType::PCM: return TEXT("PCM");
+    case ESoundAssetCompressionType::Opus: return TEXT("Opus");
+    case ESoundAssetCompressionType::PlatformSpecific: return TEXT("Platform Specific");
+    case ESoundAssetCompressionType::ProjectDefined: return TEXT("Project Defined");
+    default: return TEXT("Unknown");
+    }
+}
+
+const TCHAR* FOptimizationAudioCost::GetLoadingBehaviorName(ESoundWaveLoadingBehavior Behavior)
+{
+    switch (Behavior)
+    {
+    case ESoundWaveLoadingBehavior::Inherited: return TEXT("Inherited");
+    case ESoundWaveLoadingBehavior::RetainOnLoad: return TEXT("Retain On Load");
+    case ESoundWaveLoadingBehavior::PrimeOnLoad: return TEXT("Prime On Load");
+    case ESoundWaveLoadingBehavior::LoadOnDemand: return TEXT("Load On Demand");
+    case ESoundWaveLoadingBehavior::ForceInline: return TEXT("Force Inline");
+    default: return TEXT("Unknown");
+    }
+}
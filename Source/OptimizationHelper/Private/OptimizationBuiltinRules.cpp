@@ -0,0 +1,1631 @@
+﻿#include "OptimizationRuleRegistry.h"
+#include "OptimizationAssetMetrics.h"
+#include "OptimizationTextureCost.h"
+#include "OptimizationMaterialGraph.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/Texture2D.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Misc/PackageName.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "Sound/SoundWave.h"
+#include "OptimizationAudioCost.h"
+#include "Particles/ParticleSystem.h"
+#include "NiagaraSystem.h"
+
+// Rules shipped with the plugin. Registration order is the report order:
+// meshes, skeletal meshes, textures, materials, blueprints, audio, particles.
+
+namespace
+{
+    // ==================== MESH ====================
+
+    class FHighPolyMeshRule : public TOptimizationMetricsRule<FOptimizationMeshMetrics>
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Mesh.HighPoly"); }
+        virtual UClass* GetAssetClass() const override { return UStaticMesh::StaticClass(); }
+        virtual bool IncludesEngineContent() const override { return true; }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationMeshMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            const int32 TriangleCount = Metrics.Triangles;
+            const int32 MaxTrianglesPerMesh = Context.Analyzer.MaxTrianglesPerMesh;
+
+            if (TriangleCount > MaxTrianglesPerMesh)
+            {
+                FOptimizationIssue Issue;
+                Issue.Category = EOptimizationCategory::Mesh;
+                Issue.Title = FString::Printf(TEXT("High Poly Count: %s"), *Context.AssetData.AssetName.ToString());
+
+                // ← НОВАЯ ФОРМУЛА IMPACT
+                // Calculate how much the mesh exceeds the threshold
+                float ExcessRatio = (float)TriangleCount / MaxTrianglesPerMesh;
+                // Impact scales with excess: 10% over = ~16%, 100% over = ~70%, 200% over = 100%
+                float BaseImpact = FMath::Clamp((ExcessRatio - 1.0f) * 60.0f + 10.0f, 10.0f, 100.0f);
+
+                Issue.EstimatedImpact = BaseImpact;
+
+                // Determine severity based on calculated impact
+                if (BaseImpact > 80.0f)
+                {
+                    Issue.Severity = EOptimizationSeverity::Critical;
+                }
+                else if (BaseImpact > 50.0f)
+                {
+                    Issue.Severity = EOptimizationSeverity::Warning;
+                }
+                else
+                {
+                    Issue.Severity = EOptimizationSeverity::Info;
+                }
+
+                Issue.Description = FString::Printf(
+                    TEXT("Mesh has %d triangles (threshold: %d, %.1fx over limit)"),
+                    TriangleCount,
+                    MaxTrianglesPerMesh,
+                    ExcessRatio
+                );
+                Issue.AssetPath = Context.AssetData.GetObjectPathString();
+                Issue.SuggestedFix = TEXT("Reduce polygon count or create LODs");
+                OutIssues.Add(Issue);
+            }
+        }
+    };
+
+    class FMissingLODsRule : public TOptimizationMetricsRule<FOptimizationMeshMetrics>
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Mesh.MissingLODs"); }
+        virtual UClass* GetAssetClass() const override { return UStaticMesh::StaticClass(); }
+        virtual bool IncludesEngineContent() const override { return true; }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationMeshMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            const int32 TriangleCount = Metrics.Triangles;
+
+            if (Metrics.NumLODs <= 1 && TriangleCount > 10000)
+            {
+                FOptimizationIssue Issue;
+                Issue.Category = EOptimizationCategory::Mesh;
+                Issue.Title = FString::Printf(TEXT("Missing LODs: %s"), *Context.AssetData.AssetName.ToString());
+                Issue.Description = FString::Printf(
+                    TEXT("High-poly mesh (%d triangles) has no LOD chain"),
+                    TriangleCount
+                );
+                Issue.Severity = EOptimizationSeverity::Warning;
+                Issue.AssetPath = Context.AssetData.GetObjectPathString();
+
+                // ← НОВАЯ ФОРМУЛА: Impact based on triangle count
+                // More triangles = more important to have LODs
+                float TriangleRatio = (float)TriangleCount / 50000.0f;
+                Issue.EstimatedImpact = FMath::Clamp(TriangleRatio * 40.0f + 20.0f, 20.0f, 70.0f);
+
+                Issue.SuggestedFix = TEXT("Generate LOD chain");
+                OutIssues.Add(Issue);
+            }
+        }
+    };
+
+    // ==================== SKELETAL MESH ====================
+
+    // Same scale as the static mesh rules
+    EOptimizationSeverity GetMeshSeverity(float Impact)
+    {
+        if (Impact > 80.0f)
+        {
+            return EOptimizationSeverity::Critical;
+        }
+        if (Impact > 50.0f)
+        {
+            return EOptimizationSeverity::Warning;
+        }
+        return EOptimizationSeverity::Info;
+    }
+
+    // "LOD0 60000, LOD1 30000, LOD2 15000"
+    FString FormatLODTriangles(const FOptimizationSkeletalMeshMetrics& Metrics)
+    {
+        FString Result;
+        for (int32 LODIndex = 0; LODIndex < Metrics.LODTriangles.Num(); ++LODIndex)
+        {
+            if (LODIndex > 0) Result += TEXT(", ");
+            Result += FString::Printf(TEXT("LOD%d %d"), LODIndex, Metrics.LODTriangles[LODIndex]);
+        }
+        return Result;
+    }
+
+    class FHighPolySkeletalMeshRule : public TOptimizationMetricsRule<FOptimizationSkeletalMeshMetrics>
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("SkeletalMesh.HighPoly"); }
+        virtual UClass* GetAssetClass() const override { return USkeletalMesh::StaticClass(); }
+        virtual bool IncludesEngineContent() const override { return true; }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationSkeletalMeshMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            const int32 TriangleCount = Metrics.GetTriangles();
+            const int32 MaxTrianglesPerMesh = Context.Analyzer.MaxTrianglesPerMesh;
+
+            if (TriangleCount <= MaxTrianglesPerMesh)
+            {
+                return;
+            }
+
+            FOptimizationIssue Issue;
+            Issue.Category = EOptimizationCategory::Mesh;
+            Issue.Title = FString::Printf(TEXT("High Poly Skeletal Mesh: %s"), *Context.AssetData.AssetName.ToString());
+
+            // Every vertex is skinned every frame, so the same excess weighs more than on a static mesh
+            const float ExcessRatio = (float)TriangleCount / MaxTrianglesPerMesh;
+            Issue.EstimatedImpact = FMath::Clamp((ExcessRatio - 1.0f) * 70.0f + 15.0f, 15.0f, 100.0f);
+            Issue.Severity = GetMeshSeverity(Issue.EstimatedImpact);
+
+            Issue.Description = FString::Printf(
+                TEXT("Skeletal mesh has %d triangles (threshold: %d, %.1fx over limit). Triangles per LOD: %s"),
+                TriangleCount,
+                MaxTrianglesPerMesh,
+                ExcessRatio,
+                *FormatLODTriangles(Metrics)
+            );
+            Issue.AssetPath = Context.AssetData.GetObjectPathString();
+            Issue.SuggestedFix = TEXT("Reduce polygon count or add LODs with Skeletal Mesh Reduction");
+            OutIssues.Add(Issue);
+        }
+    };
+
+    class FMissingSkeletalLODsRule : public TOptimizationMetricsRule<FOptimizationSkeletalMeshMetrics>
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("SkeletalMesh.MissingLODs"); }
+        virtual UClass* GetAssetClass() const override { return USkeletalMesh::StaticClass(); }
+        virtual bool IncludesEngineContent() const override { return true; }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationSkeletalMeshMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            const int32 TriangleCount = Metrics.GetTriangles();
+
+            // Same cutoff as Mesh.MissingLODs
+            if (Metrics.GetNumLODs() > 1 || TriangleCount <= 10000)
+            {
+                return;
+            }
+
+            FOptimizationIssue Issue;
+            Issue.Category = EOptimizationCategory::Mesh;
+            Issue.Title = FString::Printf(TEXT("Missing LODs: %s"), *Context.AssetData.AssetName.ToString());
+            Issue.Description = FString::Printf(
+                TEXT("Skeletal mesh with %d triangles and %d bones has no LOD chain, distant characters skin every vertex"),
+                TriangleCount,
+                Metrics.NumBones
+            );
+            Issue.Severity = EOptimizationSeverity::Warning;
+            Issue.AssetPath = Context.AssetData.GetObjectPathString();
+
+            const float TriangleRatio = (float)TriangleCount / 50000.0f;
+            Issue.EstimatedImpact = FMath::Clamp(TriangleRatio * 40.0f + 25.0f, 25.0f, 75.0f);
+
+            Issue.SuggestedFix = TEXT("Generate LODs and remove bones in lower LODs (LOD Settings > Bones to Remove)");
+            OutIssues.Add(Issue);
+        }
+    };
+
+    class FSkeletalBoneCountRule : public TOptimizationMetricsRule<FOptimizationSkeletalMeshMetrics>
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("SkeletalMesh.Bones"); }
+        virtual UClass* GetAssetClass() const override { return USkeletalMesh::StaticClass(); }
+        virtual bool IncludesEngineContent() const override { return true; }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationSkeletalMeshMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            const int32 MaxBones = Context.Analyzer.MaxBonesPerSkeletalMesh;
+
+            if (Metrics.NumBones <= MaxBones)
+            {
+                return;
+            }
+
+            FOptimizationIssue Issue;
+            Issue.Category = EOptimizationCategory::Mesh;
+            Issue.Title = FString::Printf(TEXT("Too Many Bones: %s"), *Context.AssetData.AssetName.ToString());
+
+            // Bone transforms are evaluated on the game thread and uploaded every frame
+            const float ExcessRatio = (float)Metrics.NumBones / MaxBones;
+            Issue.EstimatedImpact = FMath::Clamp((ExcessRatio - 1.0f) * 60.0f + 10.0f, 10.0f, 100.0f);
+            Issue.Severity = GetMeshSeverity(Issue.EstimatedImpact);
+
+            Issue.Description = FString::Printf(
+                TEXT("Skeletal mesh uses %d bones (threshold: %d, %.1fx over limit)"),
+                Metrics.NumBones,
+                MaxBones,
+                ExcessRatio
+            );
+            Issue.AssetPath = Context.AssetData.GetObjectPathString();
+            Issue.SuggestedFix = TEXT("Remove helper and twist bones that don't deform, at least in lower LODs");
+            OutIssues.Add(Issue);
+        }
+    };
+
+    class FSkeletalBoneInfluencesRule : public TOptimizationMetricsRule<FOptimizationSkeletalMeshMetrics>
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("SkeletalMesh.BoneInfluences"); }
+        virtual UClass* GetAssetClass() const override { return USkeletalMesh::StaticClass(); }
+        virtual bool IncludesEngineContent() const override { return true; }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationSkeletalMeshMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            const int32 MaxInfluences = FMath::Max(Context.Analyzer.MaxBoneInfluences, 1);
+
+            if (Metrics.MaxBoneInfluences <= MaxInfluences)
+            {
+                return;
+            }
+
+            // Skin weights are stored per influence, the buffers shrink in proportion
+            const float SkinWeightMB = Metrics.SkinWeightBytes / (1024.0f * 1024.0f);
+            const float SavedMB = SkinWeightMB * (1.0f - (float)MaxInfluences / Metrics.MaxBoneInfluences);
+
+            FOptimizationIssue Issue;
+            Issue.Category = EOptimizationCategory::Mesh;
+            Issue.Title = FString::Printf(TEXT("Too Many Bone Influences: %s"), *Context.AssetData.AssetName.ToString());
+
+            // Vertex shader cost grows with the influences read per vertex
+            const float ExcessRatio = (float)Metrics.MaxBoneInfluences / MaxInfluences;
+            const float TriangleWeight = FMath::Clamp((float)Metrics.GetTriangles() / Context.Analyzer.MaxTrianglesPerMesh, 0.25f, 1.0f);
+            Issue.EstimatedImpact = FMath::Clamp(((ExcessRatio - 1.0f) * 50.0f + 20.0f) * TriangleWeight, 10.0f, 100.0f);
+            Issue.Severity = GetMeshSeverity(Issue.EstimatedImpact);
+            Issue.EstimatedSavingsMB = SavedMB;
+
+            Issue.Description = FString::Printf(
+                TEXT("Up to %d bone influences per vertex (threshold: %d). Skin weight buffers %.1f MB, %.1f MB at threshold"),
+                Metrics.MaxBoneInfluences,
+                MaxInfluences,
+                SkinWeightMB,
+                SkinWeightMB - SavedMB
+            );
+            Issue.AssetPath = Context.AssetData.GetObjectPathString();
+            Issue.SuggestedFix = TEXT("Set Max Bone Influences in the LOD build settings");
+            OutIssues.Add(Issue);
+        }
+    };
+
+    class FSkeletalSectionsRule : public TOptimizationMetricsRule<FOptimizationSkeletalMeshMetrics>
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("SkeletalMesh.Sections"); }
+        virtual UClass* GetAssetClass() const override { return USkeletalMesh::StaticClass(); }
+        virtual bool IncludesEngineContent() const override { return true; }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationSkeletalMeshMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            const int32 MaxSections = Context.Analyzer.MaxSectionsPerSkeletalMesh;
+
+            if (Metrics.NumSections <= MaxSections)
+            {
+                return;
+            }
+
+            FOptimizationIssue Issue;
+            Issue.Category = EOptimizationCategory::Mesh;
+            Issue.Title = FString::Printf(TEXT("Too Many Sections: %s"), *Context.AssetData.AssetName.ToString());
+
+            // Each section is a skinned draw call in every pass the mesh renders in
+            const float ExcessRatio = (float)Metrics.NumSections / MaxSections;
+            Issue.EstimatedImpact = FMath::Clamp((ExcessRatio - 1.0f) * 50.0f + 15.0f, 15.0f, 100.0f);
+            Issue.Severity = GetMeshSeverity(Issue.EstimatedImpact);
+
+            Issue.Description = FString::Printf(
+                TEXT("LOD 0 has %d sections with %d materials (threshold: %d sections). Each section is a separate draw call"),
+                Metrics.NumSections,
+                Metrics.NumMaterials,
+                MaxSections
+            );
+            Issue.AssetPath = Context.AssetData.GetObjectPathString();
+            Issue.SuggestedFix = TEXT("Merge materials into an atlas or combine sections that share a material");
+            OutIssues.Add(Issue);
+        }
+    };
+
+    // ==================== TEXTURE ====================
+
+    // Impact follows the memory freed: 1 MB ~ 22, 16 MB ~ 61, 64 MB ~ 85, 256 MB and up 100
+    float GetTextureMemoryImpact(float SavedMB)
+    {
+        return FMath::Clamp(12.5f * FMath::Log2(1.0f + SavedMB) + 10.0f, 10.0f, 100.0f);
+    }
+
+    EOptimizationSeverity GetTextureMemorySeverity(float Impact)
+    {
+        if (Impact > 75.0f)
+        {
+            return EOptimizationSeverity::Critical;
+        }
+        if (Impact > 45.0f)
+        {
+            return EOptimizationSeverity::Warning;
+        }
+        return EOptimizationSeverity::Info;
+    }
+
+    // Metrics with a format the cost model can size. Unknown format (no platform data): assume uncompressed 8 bit RGBA
+    FOptimizationTextureMetrics GetCostMetrics(const FOptimizationTextureMetrics& Metrics)
+    {
+        FOptimizationTextureMetrics Cost = Metrics;
+        if (Cost.PixelFormat == PF_Unknown)
+        {
+            Cost.PixelFormat = PF_B8G8R8A8;
+        }
+        return Cost;
+    }
+
+    class FLargeTextureRule : public TOptimizationMetricsRule<FOptimizationTextureMetrics>
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Texture.Large"); }
+        virtual UClass* GetAssetClass() const override { return UTexture2D::StaticClass(); }
+        virtual bool IncludesEngineContent() const override { return true; }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationTextureMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            const int32 MaxTextureSize = Context.Analyzer.MaxTextureSize;
+            const int32 MaxDimension = FMath::Max(Metrics.SizeX, Metrics.SizeY);
+
+            if (MaxDimension <= MaxTextureSize)
+            {
+                return;
+            }
+
+            const FOptimizationTextureMetrics Cost = GetCostMetrics(Metrics);
+
+            // What the texture takes on the GPU after LOD bias, and what it would at the threshold
+            const int64 ResidentBytes = FOptimizationTextureCost::CalcResidentBytes(Cost);
+            const int64 CappedBytes = FOptimizationTextureCost::CalcResidentBytesAtMaxSize(Cost, MaxTextureSize);
+            const int64 SavedBytes = ResidentBytes - CappedBytes;
+
+            // LOD bias already keeps it at or under the threshold
+            if (SavedBytes <= 0)
+            {
+                return;
+            }
+
+            const float ResidentMB = ResidentBytes / (1024.0f * 1024.0f);
+            const float CappedMB = CappedBytes / (1024.0f * 1024.0f);
+            const float SavedMB = SavedBytes / (1024.0f * 1024.0f);
+
+            FOptimizationIssue Issue;
+            Issue.Category = EOptimizationCategory::Texture;
+            Issue.Title = FString::Printf(TEXT("Large Texture: %s"), *Context.AssetData.AssetName.ToString());
+
+            Issue.EstimatedImpact = GetTextureMemoryImpact(SavedMB);
+            Issue.Severity = GetTextureMemorySeverity(Issue.EstimatedImpact);
+            Issue.EstimatedSavingsMB = SavedMB;
+
+            Issue.Description = FString::Printf(
+                TEXT("Texture size: %dx%d %s, %d mips (threshold: %d). GPU memory %.1f MB, %.1f MB at threshold, saves %.1f MB"),
+                Metrics.SizeX,
+                Metrics.SizeY,
+                FOptimizationTextureCost::GetPixelFormatName(Cost.PixelFormat),
+                Metrics.NumMips > 0 ? Metrics.NumMips : FOptimizationTextureCost::GetFullMipCount(Metrics.SizeX, Metrics.SizeY),
+                MaxTextureSize,
+                ResidentMB,
+                CappedMB,
+                SavedMB
+            );
+            Issue.AssetPath = Context.AssetData.GetObjectPathString();
+            Issue.SuggestedFix = TEXT("Set Maximum Texture Size or LOD Bias, or enable virtual texturing");
+            OutIssues.Add(Issue);
+        }
+    };
+
+    // Why a texture stays fully resident instead of streaming. Only the first reason found is
+    // reported, so one texture gets one streaming issue.
+    enum class ETextureStreamingBlocker : uint8
+    {
+        None,
+        NeverStream,
+        NonStreamingGroup,
+        NonPowerOfTwo,
+        NoMips
+    };
+
+    ETextureStreamingBlocker GetStreamingBlocker(const FOptimizationTextureMetrics& Metrics)
+    {
+        // Virtual textures stream by tiles whatever the settings below
+        if (Metrics.bVirtualTextureStreaming)
+        {
+            return ETextureStreamingBlocker::None;
+        }
+        if (Metrics.bNeverStream)
+        {
+            return ETextureStreamingBlocker::NeverStream;
+        }
+        if (Metrics.LODGroup == TEXTUREGROUP_UI)
+        {
+            return ETextureStreamingBlocker::NonStreamingGroup;
+        }
+        if (!Metrics.bPaddedToPowerOfTwo && (!FMath::IsPowerOfTwo(Metrics.SizeX) || !FMath::IsPowerOfTwo(Metrics.SizeY)))
+        {
+            return ETextureStreamingBlocker::NonPowerOfTwo;
+        }
+        if (Metrics.NumMips == 1 && FMath::Max(Metrics.SizeX, Metrics.SizeY) > 1)
+        {
+            return ETextureStreamingBlocker::NoMips;
+        }
+        return ETextureStreamingBlocker::None;
+    }
+
+    // One rule per blocker. The projection is the pool memory the texture would give back
+    // at most once it streams: everything above the mips the streamer always keeps.
+    class FTextureStreamingRuleBase : public TOptimizationMetricsRule<FOptimizationTextureMetrics>
+    {
+    public:
+        virtual UClass* GetAssetClass() const override { return UTexture2D::StaticClass(); }
+        virtual bool IncludesEngineContent() const override { return true; }
+
+    protected:
+        virtual ETextureStreamingBlocker GetBlocker() const = 0;
+        virtual const TCHAR* GetTitle() const = 0;
+        virtual const TCHAR* GetReason() const = 0;
+        virtual const TCHAR* GetFix() const = 0;
+
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationTextureMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            if (GetStreamingBlocker(Metrics) != GetBlocker())
+            {
+                return;
+            }
+
+            const FOptimizationTextureMetrics Cost = GetCostMetrics(Metrics);
+            const float ResidentMB = FOptimizationTextureCost::CalcResidentBytes(Cost) / (1024.0f * 1024.0f);
+            const float SavedMB = FOptimizationTextureCost::CalcStreamingSavings(Cost) / (1024.0f * 1024.0f);
+
+            if (SavedMB <= 0.0f || SavedMB < Context.Analyzer.MinStreamingSavingsMB)
+            {
+                return;
+            }
+
+            FOptimizationIssue Issue;
+            Issue.Category = EOptimizationCategory::Texture;
+            Issue.Title = FString::Printf(TEXT("%s: %s"), GetTitle(), *Context.AssetData.AssetName.ToString());
+            Issue.EstimatedImpact = GetTextureMemoryImpact(SavedMB);
+            Issue.Severity = GetTextureMemorySeverity(Issue.EstimatedImpact);
+            Issue.EstimatedSavingsMB = SavedMB;
+            Issue.Description = FString::Printf(
+                TEXT("%s. Texture size: %dx%d %s, %.1f MB always resident. Streaming would return up to %.1f MB to the pool"),
+                GetReason(),
+                Metrics.SizeX,
+                Metrics.SizeY,
+                FOptimizationTextureCost::GetPixelFormatName(Cost.PixelFormat),
+                ResidentMB,
+                SavedMB
+            );
+            Issue.AssetPath = Context.AssetData.GetObjectPathString();
+            Issue.SuggestedFix = GetFix();
+            OutIssues.Add(Issue);
+        }
+    };
+
+    class FNeverStreamTextureRule : public FTextureStreamingRuleBase
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Texture.NeverStream"); }
+
+    protected:
+        virtual ETextureStreamingBlocker GetBlocker() const override { return ETextureStreamingBlocker::NeverStream; }
+        virtual const TCHAR* GetTitle() const override { return TEXT("Never Streamed Texture"); }
+        virtual const TCHAR* GetReason() const override { return TEXT("Never Stream is set"); }
+        virtual const TCHAR* GetFix() const override { return TEXT("Clear Never Stream unless the texture is read on the CPU or must never blur"); }
+    };
+
+    class FNonStreamingGroupTextureRule : public FTextureStreamingRuleBase
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Texture.NonStreamingGroup"); }
+
+    protected:
+        virtual ETextureStreamingBlocker GetBlocker() const override { return ETextureStreamingBlocker::NonStreamingGroup; }
+        virtual const TCHAR* GetTitle() const override { return TEXT("Large UI Texture"); }
+        virtual const TCHAR* GetReason() const override { return TEXT("Texture group UI is not streamed"); }
+        virtual const TCHAR* GetFix() const override { return TEXT("Use a world texture group if the texture isn't shown in UI, otherwise reduce its size or pack it into an atlas"); }
+    };
+
+    class FNonPowerOfTwoTextureRule : public FTextureStreamingRuleBase
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Texture.NonPowerOfTwo"); }
+
+    protected:
+        virtual ETextureStreamingBlocker GetBlocker() const override { return ETextureStreamingBlocker::NonPowerOfTwo; }
+        virtual const TCHAR* GetTitle() const override { return TEXT("Non Power Of Two Texture"); }
+        virtual const TCHAR* GetReason() const override { return TEXT("Dimensions are not powers of two, so the texture has no mips and can't stream"); }
+        virtual const TCHAR* GetFix() const override { return TEXT("Resize the source to powers of two or set Power Of Two Mode to pad it"); }
+    };
+
+    class FNoMipsTextureRule : public FTextureStreamingRuleBase
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Texture.NoMips"); }
+
+    protected:
+        virtual ETextureStreamingBlocker GetBlocker() const override { return ETextureStreamingBlocker::NoMips; }
+        virtual const TCHAR* GetTitle() const override { return TEXT("Texture Without Mips"); }
+        virtual const TCHAR* GetReason() const override { return TEXT("Mip Gen Settings produce no mips, so the texture can't stream"); }
+        virtual const TCHAR* GetFix() const override { return TEXT("Set Mip Gen Settings to From Texture Group"); }
+    };
+
+    class FVirtualTextureCandidateRule : public TOptimizationMetricsRule<FOptimizationTextureMetrics>
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Texture.VirtualTextureCandidate"); }
+        virtual UClass* GetAssetClass() const override { return UTexture2D::StaticClass(); }
+        virtual bool IncludesEngineContent() const override { return true; }
+
+        // Below this, whole mips are small enough for regular streaming
+        static constexpr int32 MinVirtualTextureSize = 4096;
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationTextureMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            if (Metrics.bVirtualTextureStreaming
+                || Metrics.LODGroup == TEXTUREGROUP_UI
+                || FMath::Max(Metrics.SizeX, Metrics.SizeY) < MinVirtualTextureSize)
+            {
+                return;
+            }
+
+            // Streaming loads a whole mip when any part of it is needed, virtual texturing only the visible tiles
+            const FOptimizationTextureMetrics Cost = GetCostMetrics(Metrics);
+            const float SavedMB = FOptimizationTextureCost::CalcVirtualTextureSavings(Cost) / (1024.0f * 1024.0f);
+
+            if (SavedMB <= 0.0f || SavedMB < Context.Analyzer.MinStreamingSavingsMB)
+            {
+                return;
+            }
+
+            FOptimizationIssue Issue;
+            Issue.Category = EOptimizationCategory::Texture;
+            Issue.Title = FString::Printf(TEXT("Virtual Texture Candidate: %s"), *Context.AssetData.AssetName.ToString());
+            Issue.EstimatedImpact = GetTextureMemoryImpact(SavedMB);
+            Issue.Severity = GetTextureMemorySeverity(Issue.EstimatedImpact);
+            Issue.EstimatedSavingsMB = SavedMB;
+            Issue.Description = FString::Printf(
+                TEXT("Texture size: %dx%d %s. Virtual texturing would keep only the visible tiles of the top mip, up to %.1f MB less in the pool"),
+                Metrics.SizeX,
+                Metrics.SizeY,
+                FOptimizationTextureCost::GetPixelFormatName(Cost.PixelFormat),
+                SavedMB
+            );
+            Issue.AssetPath = Context.AssetData.GetObjectPathString();
+            Issue.SuggestedFix = TEXT("Enable Virtual Texture Streaming on the texture (needs Virtual Texture support in the project settings)");
+            OutIssues.Add(Issue);
+        }
+    };
+
+    // ==================== MATERIAL ====================
+
+    class FTooManyTexturesRule : public TOptimizationMetricsRule<FOptimizationMaterialMetrics>
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Material.TooManyTextures"); }
+        virtual UClass* GetAssetClass() const override { return UMaterial::StaticClass(); }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationMaterialMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            const int32 TextureSampleCount = Metrics.TextureSamples;
+            const int32 MaxTextureSamplesPerMaterial = Context.Analyzer.MaxTextureSamplesPerMaterial;
+
+            // ← ИСПОЛЬЗОВАНИЕ ПЕРЕМЕННОЙ
+            if (TextureSampleCount > MaxTextureSamplesPerMaterial)
+            {
+                FOptimizationIssue Issue;
+                Issue.Category = EOptimizationCategory::Material;
+                Issue.Title = FString::Printf(TEXT("Too Many Textures: %s"), *Context.AssetData.AssetName.ToString());
+
+                // Calculate impact based on texture count
+                float ExcessRatio = (float)TextureSampleCount / MaxTextureSamplesPerMaterial;  // ← ПЕРЕМЕННАЯ
+                float BaseImpact = FMath::Clamp((ExcessRatio - 1.0f) * 50.0f + 20.0f, 20.0f, 95.0f);
+                Issue.EstimatedImpact = BaseImpact;
+
+                if (BaseImpact > 70.0f)
+                {
+                    Issue.Severity = EOptimizationSeverity::Critical;
+                }
+                else if (BaseImpact > 45.0f)
+                {
+                    Issue.Severity = EOptimizationSeverity::Warning;
+                }
+                else
+                {
+                    Issue.Severity = EOptimizationSeverity::Info;
+                }
+
+                Issue.Description = FString::Printf(
+                    TEXT("Material uses %d texture samples (recommended: ≤%d). Each texture sample impacts GPU performance."),
+                    TextureSampleCount,
+                    MaxTextureSamplesPerMaterial  // ← ПЕРЕМЕННАЯ
+                );
+                Issue.AssetPath = Context.AssetData.GetObjectPathString();
+                Issue.SuggestedFix = TEXT("Reduce texture count, combine textures into atlases, or use texture packing (RGB channels)");
+                OutIssues.Add(Issue);
+            }
+        }
+    };
+
+    class FTwoSidedMaterialRule : public TOptimizationMetricsRule<FOptimizationMaterialMetrics>
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Material.TwoSided"); }
+        virtual UClass* GetAssetClass() const override { return UMaterial::StaticClass(); }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationMaterialMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            if (Metrics.bTwoSided)
+            {
+                FOptimizationIssue Issue;
+                Issue.Category = EOptimizationCategory::Material;
+                Issue.Title = FString::Printf(TEXT("Two-Sided Material: %s"), *Context.AssetData.AssetName.ToString());
+                Issue.Severity = EOptimizationSeverity::Warning;
+                Issue.EstimatedImpact = 35.0f;
+                Issue.Description = TEXT("Material is set to Two-Sided, which doubles rendering cost. Only use when absolutely necessary (foliage, cloth).");
+                Issue.AssetPath = Context.AssetData.GetObjectPathString();
+                Issue.SuggestedFix = TEXT("Disable Two-Sided if back faces are never visible, or use proper two-sided geometry");
+                OutIssues.Add(Issue);
+            }
+        }
+    };
+
+    class FComplexTranslucentMaterialRule : public TOptimizationMetricsRule<FOptimizationMaterialMetrics>
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Material.ComplexTranslucent"); }
+        virtual UClass* GetAssetClass() const override { return UMaterial::StaticClass(); }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationMaterialMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            const int32 TextureSampleCount = Metrics.TextureSamples;
+
+            if (FOptimizationAssetMetrics::IsTranslucentBlendMode(Metrics.BlendMode))
+            {
+                // Only flag if it also has many textures or is complex
+                if (TextureSampleCount > 5)
+                {
+                    FOptimizationIssue Issue;
+                    Issue.Category = EOptimizationCategory::Material;
+                    Issue.Title = FString::Printf(TEXT("Complex Translucent Material: %s"), *Context.AssetData.AssetName.ToString());
+                    Issue.Severity = EOptimizationSeverity::Warning;
+
+                    float BaseImpact = FMath::Clamp(TextureSampleCount * 8.0f, 30.0f, 80.0f);
+                    Issue.EstimatedImpact = BaseImpact;
+
+                    Issue.Description = FString::Printf(
+                        TEXT("Translucent material with %d textures. Translucency is expensive and doesn't support many optimizations."),
+                        TextureSampleCount
+                    );
+                    Issue.AssetPath = Context.AssetData.GetObjectPathString();
+                    Issue.SuggestedFix = TEXT("Use Masked blend mode if possible, reduce texture samples, or use simpler shader");
+                    OutIssues.Add(Issue);
+                }
+            }
+        }
+    };
+
+    // Instruction counts of the compiled shaders, not an estimate. Materials whose shaders
+    // never compiled (or failed to) have no stats and are left alone.
+    class FShaderComplexityRule : public TOptimizationMetricsRule<FOptimizationMaterialMetrics>
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Material.ShaderComplexity"); }
+        virtual UClass* GetAssetClass() const override { return UMaterial::StaticClass(); }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationMaterialMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            if (!Metrics.bHasShaderStats) return;
+
+            const int32 MaxPixelShaderInstructions = FMath::Max(Context.Analyzer.MaxPixelShaderInstructions, 1);
+            const int32 MaxVertexShaderInstructions = FMath::Max(Context.Analyzer.MaxVertexShaderInstructions, 1);
+
+            const float PixelRatio = (float)Metrics.PixelShaderInstructions / MaxPixelShaderInstructions;
+            const float VertexRatio = (float)Metrics.VertexShaderInstructions / MaxVertexShaderInstructions;
+            const float ComplexityRatio = FMath::Max(PixelRatio, VertexRatio);
+
+            if (ComplexityRatio > 1.0f)
+            {
+                FOptimizationIssue Issue;
+                Issue.Category = EOptimizationCategory::Material;
+                Issue.Title = FString::Printf(TEXT("Complex Shader: %s"), *Context.AssetData.AssetName.ToString());
+
+                float BaseImpact = FMath::Clamp((ComplexityRatio - 1.0f) * 60.0f + 25.0f, 25.0f, 90.0f);
+                Issue.EstimatedImpact = BaseImpact;
+
+                if (BaseImpact > 70.0f)
+                {
+                    Issue.Severity = EOptimizationSeverity::Critical;
+                }
+                else if (BaseImpact > 45.0f)
+                {
+                    Issue.Severity = EOptimizationSeverity::Warning;
+                }
+                else
+                {
+                    Issue.Severity = EOptimizationSeverity::Info;
+                }
+
+                Issue.Description = FString::Printf(
+                    TEXT("Compiled pixel shader has %d instructions (threshold: %d), vertex shader %d (threshold: %d). ")
+                    TEXT("It uses %d samplers and %d virtual texture lookups."),
+                    Metrics.PixelShaderInstructions, MaxPixelShaderInstructions,
+                    Metrics.VertexShaderInstructions, MaxVertexShaderInstructions,
+                    Metrics.NumSamplers, Metrics.VirtualTextureLookups
+                );
+                Issue.AssetPath = Context.AssetData.GetObjectPathString();
+                Issue.SuggestedFix = PixelRatio >= VertexRatio
+                    ? TEXT("Simplify the pixel shader: move math to the vertex shader or customized UVs, use Material Instances, or create LOD materials")
+                    : TEXT("Simplify World Position Offset and other vertex logic, or turn it off for distant LODs");
+                OutIssues.Add(Issue);
+            }
+        }
+    };
+
+    // Sampler slots of the compiled pixel shader. Shader Model 5 has 16, shared wrap samplers
+    // and Virtual Texture lookups count against them too.
+    class FMaterialSamplersRule : public TOptimizationMetricsRule<FOptimizationMaterialMetrics>
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Material.Samplers"); }
+        virtual UClass* GetAssetClass() const override { return UMaterial::StaticClass(); }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationMaterialMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            const int32 MaxMaterialSamplers = Context.Analyzer.MaxMaterialSamplers;
+            if (!Metrics.bHasShaderStats || Metrics.NumSamplers <= MaxMaterialSamplers) return;
+
+            FOptimizationIssue Issue;
+            Issue.Category = EOptimizationCategory::Material;
+            Issue.Severity = Metrics.NumSamplers >= 16 ? EOptimizationSeverity::Critical : EOptimizationSeverity::Warning;
+            Issue.EstimatedImpact = Metrics.NumSamplers >= 16 ? 75.0f : 50.0f;
+            Issue.Title = FString::Printf(TEXT("Too Many Samplers: %s"), *Context.AssetData.AssetName.ToString());
+            Issue.Description = FString::Printf(
+                TEXT("Compiled shader uses %d samplers (threshold: %d) and %d virtual texture lookups. At 16 the material no longer compiles on some platforms."),
+                Metrics.NumSamplers, MaxMaterialSamplers, Metrics.VirtualTextureLookups
+            );
+            Issue.AssetPath = Context.AssetData.GetObjectPathString();
+            Issue.SuggestedFix = TEXT("Set Sampler Source to Shared: Wrap / Shared: Clamp on texture samples, or pack textures into fewer channels");
+            OutIssues.Add(Issue);
+        }
+    };
+
+    // Costly patterns of the expression graph, weighted by an estimate of the instructions each adds
+    class FExpensiveMaterialGraphRule : public TOptimizationMetricsRule<FOptimizationMaterialMetrics>
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Material.ExpensiveGraph"); }
+        virtual UClass* GetAssetClass() const override { return UMaterial::StaticClass(); }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationMaterialMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            const int32 TotalCost = Metrics.Graph.GetTotalCost();
+            if (TotalCost <= 0 || TotalCost < Context.Analyzer.MinMaterialGraphCost) return;
+
+            // Patterns most expensive first
+            TArray<EOptimizationMaterialPattern, TInlineAllocator<(int32)EOptimizationMaterialPattern::Num>> Patterns;
+            for (int32 Pattern = 0; Pattern < (int32)EOptimizationMaterialPattern::Num; ++Pattern)
+            {
+                if (Metrics.Graph.Patterns[Pattern].Count > 0)
+                {
+                    Patterns.Add((EOptimizationMaterialPattern)Pattern);
+                }
+            }
+            Patterns.StableSort([&Metrics](EOptimizationMaterialPattern A, EOptimizationMaterialPattern B)
+            {
+                return Metrics.Graph.Get(A).Cost > Metrics.Graph.Get(B).Cost;
+            });
+
+            FString Found;
+            for (EOptimizationMaterialPattern Pattern : Patterns)
+            {
+                const FOptimizationMaterialPatternCost& PatternCost = Metrics.Graph.Get(Pattern);
+                if (!Found.IsEmpty()) Found += TEXT(", ");
+                Found += FString::Printf(TEXT("%d %s (~%d)"), PatternCost.Count, FOptimizationMaterialGraph::GetPatternName(Pattern), PatternCost.Cost);
+            }
+
+            FOptimizationIssue Issue;
+            Issue.Category = EOptimizationCategory::Material;
+            Issue.Title = FString::Printf(TEXT("Expensive Material Graph: %s"), *Context.AssetData.AssetName.ToString());
+            Issue.EstimatedImpact = FMath::Clamp(15.0f + TotalCost * 0.4f, 15.0f, 90.0f);
+
+            if (Issue.EstimatedImpact > 70.0f)
+            {
+                Issue.Severity = EOptimizationSeverity::Critical;
+            }
+            else if (Issue.EstimatedImpact > 45.0f)
+            {
+                Issue.Severity = EOptimizationSeverity::Warning;
+            }
+            else
+            {
+                Issue.Severity = EOptimizationSeverity::Info;
+            }
+
+            Issue.Description = FString::Printf(
+                TEXT("Expression graph adds an estimated %d instructions (threshold: %d): %s."),
+                TotalCost, Context.Analyzer.MinMaterialGraphCost, *Found
+            );
+            Issue.AssetPath = Context.AssetData.GetObjectPathString();
+            Issue.SuggestedFix = GetFix(Patterns[0]);
+            OutIssues.Add(Issue);
+        }
+
+    private:
+        static const TCHAR* GetFix(EOptimizationMaterialPattern Pattern)
+        {
+            switch (Pattern)
+            {
+            case EOptimizationMaterialPattern::DependentTextureRead:
+                return TEXT("Compute UV offsets in the vertex shader (Customized UVs) or bake the distortion into one texture");
+            case EOptimizationMaterialPattern::Noise:
+                return TEXT("Replace Noise nodes with a tiling noise texture, or lower their Levels");
+            case EOptimizationMaterialPattern::SceneTexture:
+                return TEXT("Avoid Scene Texture / Scene Depth lookups in surface materials, use Depth Fade only where needed");
+            case EOptimizationMaterialPattern::SceneColor:
+                return TEXT("Use Refraction or a post process material instead of sampling Scene Color");
+            case EOptimizationMaterialPattern::CustomHLSL:
+                return TEXT("Split large Custom nodes into material functions so the compiler can optimize them, and avoid loops");
+            case EOptimizationMaterialPattern::PixelDepthOffset:
+                return TEXT("Disconnect Pixel Depth Offset or use it only on LOD 0 / close-up materials");
+            default:
+                return TEXT("Simplify the material graph");
+            }
+        }
+    };
+
+    // Every unique static permutation of a master is compiled for each shader type, vertex factory,
+    // quality level and platform, stored in the DDC and becomes its own set of PSOs. Instances are
+    // grouped by master and by the static values resolved along their parent chain here, from each
+    // instance's own overrides; values equal to the master's defaults select the master's own
+    // shaders. Masters are reported most permutations first.
+    // Instance assets are UMaterialInstanceConstant (landscape instances derive from it); dynamic
+    // instances exist only at runtime and are not looked at.
+    class FStaticPermutationsRule : public TOptimizationPassRule<FOptimizationMaterialInstanceMetrics>
+    {
+    public:
+        // Guards against parent cycles in broken content
+        static constexpr int32 MaxParentDepth = 32;
+
+        virtual FName GetName() const override { return TEXT("Material.StaticPermutations"); }
+        virtual UClass* GetAssetClass() const override { return UMaterialInstanceConstant::StaticClass(); }
+
+    private:
+        // Loaded masters may have unsaved edits, otherwise the saved tag. Unknown defaults (a master
+        // saved before the tag existed) leave every resolved value counted.
+        static bool FindMasterDefaults(const FString& MasterPath, TMap<FName, int32>& OutDefaults)
+        {
+            if (const UMaterial* Material = FindObject<UMaterial>(nullptr, *MasterPath))
+            {
+                FOptimizationAssetMetrics::ComputeStaticDefaults(Material, OutDefaults);
+                return true;
+            }
+
+            const FAssetData MasterData = IAssetRegistry::GetChecked().GetAssetByObjectPath(FSoftObjectPath(MasterPath), true);
+            return MasterData.IsValid() && FOptimizationAssetMetrics::ReadStaticDefaults(MasterData, OutDefaults);
+        }
+
+    protected:
+        virtual void EvaluateAllMetrics(const FOptimizationPassContext& Context, TConstArrayView<FOptimizationMaterialInstanceMetrics> Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            struct FMasterPermutations
+            {
+                TSet<FString> Permutations;
+                int32 NumInstances = 0;
+                int32 NumStaticOverrides = 0;
+            };
+
+            TMap<FString, int32> InstanceIndices;
+            for (int32 Index = 0; Index < Context.Assets.Num(); ++Index)
+            {
+                InstanceIndices.Add(Context.Assets[Index].GetObjectPathString(), Index);
+            }
+
+            TMap<FString, FMasterPermutations> Masters;
+            TMap<FString, TMap<FName, int32>> MasterDefaults;
+            for (int32 Index = 0; Index < Metrics.Num(); ++Index)
+            {
+                // Walk up to the master; the value closest to the instance wins
+                TMap<FName, int32> Resolved;
+                FString MasterPath;
+                int32 Current = Index;
+                for (int32 Depth = 0; Depth < MaxParentDepth && Current != INDEX_NONE; ++Depth)
+                {
+                    for (const TPair<FName, int32>& Override : Metrics[Current].StaticOverrides)
+                    {
+                        if (!Resolved.Contains(Override.Key))
+                        {
+                            Resolved.Add(Override.Key, Override.Value);
+                        }
+                    }
+
+                    const int32* ParentIndex = InstanceIndices.Find(Metrics[Current].Parent);
+                    MasterPath = ParentIndex ? FString() : Metrics[Current].Parent;
+                    Current = ParentIndex ? *ParentIndex : INDEX_NONE;
+                }
+                if (MasterPath.IsEmpty()) continue;
+
+                FMasterPermutations& Master = Masters.FindOrAdd(MasterPath);
+                Master.NumInstances++;
+                Master.NumStaticOverrides += Metrics[Index].StaticOverrides.Num();
+
+                TMap<FName, int32>* Defaults = MasterDefaults.Find(MasterPath);
+                if (!Defaults)
+                {
+                    Defaults = &MasterDefaults.Add(MasterPath);
+                    FindMasterDefaults(MasterPath, *Defaults);
+                }
+                for (auto It = Resolved.CreateIterator(); It; ++It)
+                {
+                    const int32* Default = Defaults->Find(It.Key());
+                    if (Default && *Default == It.Value())
+                    {
+                        It.RemoveCurrent();
+                    }
+                }
+
+                // Without differing values anywhere in the chain the instance uses the master's shaders
+                if (Resolved.Num() > 0)
+                {
+                    Resolved.KeySort(FNameLexicalLess());
+
+                    FString Permutation;
+                    for (const TPair<FName, int32>& Override : Resolved)
+                    {
+                        Permutation += FString::Printf(TEXT("%s=%d;"), *Override.Key.ToString(), Override.Value);
+                    }
+                    Master.Permutations.Add(MoveTemp(Permutation));
+                }
+            }
+
+            const int32 MaxPermutations = FMath::Max(Context.Analyzer.MaxPermutationsPerMaterial, 1);
+            Masters.ValueSort([](const FMasterPermutations& A, const FMasterPermutations& B)
+                {
+                    return A.Permutations.Num() > B.Permutations.Num();
+                });
+
+            for (const TPair<FString, FMasterPermutations>& Entry : Masters)
+            {
+                // The master's own permutation comes on top
+                const int32 NumPermutations = Entry.Value.Permutations.Num() + 1;
+                if (NumPermutations <= MaxPermutations) break;
+
+                FOptimizationIssue Issue;
+                Issue.Category = EOptimizationCategory::Material;
+                Issue.Title = FString::Printf(TEXT("Static Permutations: %s"), *FPackageName::ObjectPathToObjectName(Entry.Key));
+
+                const float PermutationRatio = (float)NumPermutations / MaxPermutations;
+                Issue.EstimatedImpact = FMath::Clamp(25.0f + 20.0f * FMath::Log2(PermutationRatio), 25.0f, 90.0f);
+
+                if (Issue.EstimatedImpact > 70.0f)
+                {
+                    Issue.Severity = EOptimizationSeverity::Critical;
+                }
+                else if (Issue.EstimatedImpact > 45.0f)
+                {
+                    Issue.Severity = EOptimizationSeverity::Warning;
+                }
+                else
+                {
+                    Issue.Severity = EOptimizationSeverity::Info;
+                }
+
+                Issue.Description = FString::Printf(
+                    TEXT("Master material compiles %d unique static permutations (threshold: %d) for %d instances setting %d static parameters. ")
+                    TEXT("Each permutation multiplies shader compile time, DDC size and PSO count."),
+                    NumPermutations, MaxPermutations, Entry.Value.NumInstances, Entry.Value.NumStaticOverrides
+                );
+                Issue.AssetPath = Entry.Key;
+                Issue.SuggestedFix = TEXT("Replace static switches that only toggle cheap features with dynamic parameters (lerp), or split the master into a few masters per use case");
+                OutIssues.Add(Issue);
+            }
+        }
+    };
+
+    // ==================== BLUEPRINT ====================
+
+    class FComplexBlueprintRule : public TOptimizationMetricsRule<FOptimizationBlueprintMetrics>
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Blueprint.Complex"); }
+        virtual UClass* GetAssetClass() const override { return UBlueprint::StaticClass(); }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationBlueprintMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            const int32 TotalNodes = Metrics.TotalNodes;
+            const int32 MaxBlueprintNodes = Context.Analyzer.MaxBlueprintNodes;
+
+            if (TotalNodes > MaxBlueprintNodes)
+            {
+                FOptimizationIssue Issue;
+                Issue.Category = EOptimizationCategory::Blueprint;
+                Issue.Title = FString::Printf(TEXT("Complex Blueprint: %s"), *Context.AssetData.AssetName.ToString());
+
+                // ← НОВАЯ ФОРМУЛА IMPACT
+                // Calculate complexity ratio
+                float ExcessRatio = (float)TotalNodes / MaxBlueprintNodes;
+
+                // Base impact from node count excess
+                float BaseImpact = FMath::Clamp((ExcessRatio - 1.0f) * 55.0f + 15.0f, 15.0f, 100.0f);
+
+                // Blueprint complexity affects both compile time and runtime
+                // Large blueprints also harder to maintain
+                Issue.EstimatedImpact = BaseImpact;
+
+                // Determine severity
+                if (BaseImpact > 75.0f)
+                {
+                    Issue.Severity = EOptimizationSeverity::Critical;
+                }
+                else if (BaseImpact > 45.0f)
+                {
+                    Issue.Severity = EOptimizationSeverity::Warning;
+                }
+                else
+                {
+                    Issue.Severity = EOptimizationSeverity::Info;
+                }
+
+                Issue.Description = FString::Printf(
+                    TEXT("Blueprint has %d nodes (threshold: %d, %.1fx over limit). Complex blueprints cause compilation and performance issues."),
+                    TotalNodes,
+                    MaxBlueprintNodes,
+                    ExcessRatio
+                );
+                Issue.AssetPath = Context.AssetData.GetObjectPathString();
+                Issue.SuggestedFix = TEXT("Refactor into smaller blueprints or move logic to C++");
+                OutIssues.Add(Issue);
+            }
+        }
+    };
+
+    class FEventTickBlueprintRule : public TOptimizationMetricsRule<FOptimizationBlueprintMetrics>
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Blueprint.EventTick"); }
+        virtual UClass* GetAssetClass() const override { return UBlueprint::StaticClass(); }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationBlueprintMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            const int32 TotalNodes = Metrics.TotalNodes;
+
+            if (Metrics.bHasEventTick && TotalNodes > 100)
+            {
+                FOptimizationIssue Issue;
+                Issue.Category = EOptimizationCategory::Blueprint;
+                Issue.Title = FString::Printf(TEXT("Blueprint with Event Tick: %s"), *Context.AssetData.AssetName.ToString());
+
+                // ← НОВАЯ ФОРМУЛА IMPACT
+                // Event Tick is critical - runs every frame!
+                // Impact scales with total blueprint complexity
+                float ComplexityRatio = (float)TotalNodes / 200.0f;
+                float BaseImpact = FMath::Clamp(ComplexityRatio * 60.0f + 25.0f, 25.0f, 95.0f);
+
+                // Tick makes everything worse - multiply by severity
+                Issue.EstimatedImpact = BaseImpact;
+
+                if (BaseImpact > 70.0f)
+                {
+                    Issue.Severity = EOptimizationSeverity::Critical;
+                }
+                else if (BaseImpact > 40.0f)
+                {
+                    Issue.Severity = EOptimizationSeverity::Warning;
+                }
+                else
+                {
+                    Issue.Severity = EOptimizationSeverity::Info;
+                }
+
+                Issue.Description = FString::Printf(
+                    TEXT("Blueprint contains Event Tick with %d total nodes. Event Tick runs every frame and significantly impacts performance."),
+                    TotalNodes
+                );
+                Issue.AssetPath = Context.AssetData.GetObjectPathString();
+                Issue.SuggestedFix = TEXT("Use Timers instead of Tick, or reduce tick frequency with 'Set Actor Tick Interval'");
+                OutIssues.Add(Issue);
+            }
+        }
+    };
+
+    // ==================== AUDIO ====================
+
+    // Sound memory is counted in smaller units than textures: 1 MB ~ 45, 4 MB ~ 71, 16 MB and up 100
+    float GetAudioMemoryImpact(float SavedMB)
+    {
+        return FMath::Clamp(15.0f * FMath::Log2(1.0f + 4.0f * SavedMB) + 10.0f, 10.0f, 100.0f);
+    }
+
+    bool IsPerceptualCodec(ESoundAssetCompressionType Type)
+    {
+        return Type != ESoundAssetCompressionType::PCM && Type != ESoundAssetCompressionType::ADPCM;
+    }
+
+    // Common reporting of the sound wave rules; each finding carries the bytes its fix saves
+    class FSoundRuleBase : public TOptimizationMetricsRule<FOptimizationSoundMetrics>
+    {
+    public:
+        virtual UClass* GetAssetClass() const override { return USoundWave::StaticClass(); }
+
+    protected:
+        void AddIssue(const FOptimizationRuleContext& Context, const FOptimizationSoundMetrics& Metrics, const TCHAR* Title,
+            const FString& Finding, int64 SavedBytes, const TCHAR* SuggestedFix, TArray<FOptimizationIssue>& OutIssues) const
+        {
+            const float SavedMB = SavedBytes / (1024.0f * 1024.0f);
+            if (SavedMB <= 0.0f || SavedMB < Context.Analyzer.MinAudioSavingsMB)
+            {
+                return;
+            }
+
+            const float ResidentMB = FOptimizationAudioCost::CalcResidentBytes(Metrics) / (1024.0f * 1024.0f);
+            const float CompressedMB = FOptimizationAudioCost::CalcCompressedBytes(Metrics) / (1024.0f * 1024.0f);
+
+            FOptimizationIssue Issue;
+            Issue.Category = EOptimizationCategory::Audio;
+            Issue.Title = FString::Printf(TEXT("%s: %s"), Title, *Context.AssetData.AssetName.ToString());
+            Issue.EstimatedImpact = GetAudioMemoryImpact(SavedMB);
+            Issue.EstimatedSavingsMB = SavedMB;
+
+            if (Issue.EstimatedImpact > 75.0f)
+            {
+                Issue.Severity = EOptimizationSeverity::Critical;
+            }
+            else if (Issue.EstimatedImpact > 45.0f)
+            {
+                Issue.Severity = EOptimizationSeverity::Warning;
+            }
+            else
+            {
+                Issue.Severity = EOptimizationSeverity::Info;
+            }
+
+            Issue.Description = FString::Printf(
+                TEXT("%s. %.1f s, %d Hz, %d channels, %s quality %d, %s. About %.2f MB of data, %.2f MB resident, saves %.2f MB"),
+                *Finding,
+                Metrics.Duration,
+                Metrics.SampleRate,
+                Metrics.NumChannels,
+                FOptimizationAudioCost::GetCompressionTypeName(Metrics.CompressionType),
+                Metrics.CompressionQuality,
+                FOptimizationAudioCost::GetLoadingBehaviorName(Metrics.LoadingBehavior),
+                CompressedMB,
+                ResidentMB,
+                SavedMB
+            );
+            Issue.AssetPath = Context.AssetData.GetObjectPathString();
+            Issue.SuggestedFix = SuggestedFix;
+            OutIssues.Add(Issue);
+        }
+
+        // Savings of the same wave with other settings: resident memory, or the data size for streamed waves
+        static int64 GetSavedBytes(const FOptimizationSoundMetrics& Metrics, const FOptimizationSoundMetrics& Changed)
+        {
+            if (Metrics.bStreaming)
+            {
+                return FOptimizationAudioCost::CalcCompressedBytes(Metrics) - FOptimizationAudioCost::CalcCompressedBytes(Changed);
+            }
+            return FOptimizationAudioCost::CalcResidentBytes(Metrics) - FOptimizationAudioCost::CalcResidentBytes(Changed);
+        }
+    };
+
+    class FUncompressedSoundRule : public FSoundRuleBase
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Audio.Uncompressed"); }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationSoundMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            if (Metrics.CompressionType != ESoundAssetCompressionType::PCM)
+            {
+                return;
+            }
+
+            // Against Bink Audio at the engine's default quality
+            FOptimizationSoundMetrics Compressed = Metrics;
+            Compressed.CompressionType = ESoundAssetCompressionType::BinkAudio;
+            Compressed.CompressionQuality = 40;
+
+            AddIssue(Context, Metrics, TEXT("Uncompressed Sound"), TEXT("Sound is stored as PCM"),
+                GetSavedBytes(Metrics, Compressed),
+                TEXT("Use Bink Audio, or ADPCM for short sounds that must decode cheaply"), OutIssues);
+        }
+    };
+
+    class FHighSampleRateSoundRule : public FSoundRuleBase
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Audio.HighSampleRate"); }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationSoundMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            const int32 MaxSampleRate = Context.Analyzer.MaxAudioSampleRate;
+            if (Metrics.SampleRate <= MaxSampleRate)
+            {
+                return;
+            }
+
+            FOptimizationSoundMetrics Resampled = Metrics;
+            Resampled.SampleRate = MaxSampleRate;
+
+            AddIssue(Context, Metrics, TEXT("High Sample Rate"),
+                FString::Printf(TEXT("Sample rate %d Hz (threshold: %d Hz)"), Metrics.SampleRate, MaxSampleRate),
+                GetSavedBytes(Metrics, Resampled),
+                TEXT("Lower the Sample Rate setting of the wave or its platform overrides"), OutIssues);
+        }
+    };
+
+    class FLongNonStreamingSoundRule : public FSoundRuleBase
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Audio.NotStreamed"); }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationSoundMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            // Force Inline has its own rule
+            if (Metrics.bStreaming
+                || Metrics.LoadingBehavior == ESoundWaveLoadingBehavior::ForceInline
+                || Metrics.Duration <= Context.Analyzer.MaxNonStreamingSoundSeconds)
+            {
+                return;
+            }
+
+            FOptimizationSoundMetrics Streamed = Metrics;
+            Streamed.bStreaming = true;
+
+            AddIssue(Context, Metrics, TEXT("Long Sound Not Streamed"),
+                FString::Printf(TEXT("Sound is longer than %.0f s and is loaded whole"), Context.Analyzer.MaxNonStreamingSoundSeconds),
+                FOptimizationAudioCost::CalcResidentBytes(Metrics) - FOptimizationAudioCost::CalcResidentBytes(Streamed),
+                TEXT("Enable streaming for music, ambience and dialogue"), OutIssues);
+        }
+    };
+
+    class FSoundCompressionQualityRule : public FSoundRuleBase
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Audio.CompressionQuality"); }
+
+        // Above this the difference is rarely audible in game
+        static constexpr int32 MaxCompressionQuality = 80;
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationSoundMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            if (!IsPerceptualCodec(Metrics.CompressionType) || Metrics.CompressionQuality <= MaxCompressionQuality)
+            {
+                return;
+            }
+
+            FOptimizationSoundMetrics Lower = Metrics;
+            Lower.CompressionQuality = 40;
+
+            AddIssue(Context, Metrics, TEXT("High Compression Quality"),
+                FString::Printf(TEXT("Compression quality %d (threshold: %d)"), Metrics.CompressionQuality, MaxCompressionQuality),
+                GetSavedBytes(Metrics, Lower),
+                TEXT("Lower Compression Quality; 40 is the engine default"), OutIssues);
+        }
+    };
+
+    class FSoundChannelsRule : public FSoundRuleBase
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Audio.Channels"); }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationSoundMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            if (Metrics.NumChannels <= 2)
+            {
+                return;
+            }
+
+            FOptimizationSoundMetrics Stereo = Metrics;
+            Stereo.NumChannels = 2;
+
+            AddIssue(Context, Metrics, TEXT("Multichannel Sound"),
+                FString::Printf(TEXT("Sound has %d channels"), Metrics.NumChannels),
+                GetSavedBytes(Metrics, Stereo),
+                TEXT("Import as stereo, or mono for sounds that are spatialized"), OutIssues);
+        }
+    };
+
+    class FSoundLoadingBehaviorRule : public FSoundRuleBase
+    {
+    public:
+        virtual FName GetName() const override { return TEXT("Audio.LoadingBehavior"); }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationSoundMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            // Force Inline keeps the whole sound in memory with its package, streaming or not
+            if (Metrics.LoadingBehavior != ESoundWaveLoadingBehavior::ForceInline)
+            {
+                return;
+            }
+
+            FOptimizationSoundMetrics OnDemand = Metrics;
+            OnDemand.LoadingBehavior = ESoundWaveLoadingBehavior::LoadOnDemand;
+            OnDemand.bStreaming = true;
+
+            AddIssue(Context, Metrics, TEXT("Sound Forced Inline"), TEXT("Loading Behavior is Force Inline"),
+                FOptimizationAudioCost::CalcResidentBytes(Metrics) - FOptimizationAudioCost::CalcResidentBytes(OnDemand),
+                TEXT("Use Load On Demand, or Prime On Load for sounds that must start without latency"), OutIssues);
+        }
+    };
+
+    // ==================== PARTICLES ====================
+
+    // Each rule is registered once for Cascade and once for Niagara ("Cascade.Emitters", "Niagara.Emitters")
+    class FParticleRuleBase : public TOptimizationMetricsRule<FOptimizationParticleMetrics>
+    {
+    public:
+        FParticleRuleBase(UClass* InAssetClass, const TCHAR* SystemKind, const TCHAR* RuleName)
+            : AssetClass(InAssetClass)
+            , Name(*FString::Printf(TEXT("%s.%s"), SystemKind, RuleName))
+        {
+        }
+
+        virtual FName GetName() const override { return Name; }
+        virtual UClass* GetAssetClass() const override { return AssetClass; }
+
+    protected:
+        bool IsNiagara() const { return AssetClass == UNiagaraSystem::StaticClass(); }
+
+        void AddIssue(const FOptimizationRuleContext& Context, const TCHAR* Title, float Impact, const FString& Description,
+            const TCHAR* SuggestedFix, TArray<FOptimizationIssue>& OutIssues) const
+        {
+            FOptimizationIssue Issue;
+            Issue.Category = EOptimizationCategory::Particle;
+            Issue.Title = FString::Printf(TEXT("%s: %s"), Title, *Context.AssetData.AssetName.ToString());
+            Issue.EstimatedImpact = FMath::Clamp(Impact, 10.0f, 100.0f);
+
+            if (Issue.EstimatedImpact > 75.0f)
+            {
+                Issue.Severity = EOptimizationSeverity::Critical;
+            }
+            else if (Issue.EstimatedImpact > 45.0f)
+            {
+                Issue.Severity = EOptimizationSeverity::Warning;
+            }
+            else
+            {
+                Issue.Severity = EOptimizationSeverity::Info;
+            }
+
+            Issue.Description = Description;
+            Issue.AssetPath = Context.AssetData.GetObjectPathString();
+            Issue.SuggestedFix = SuggestedFix;
+            OutIssues.Add(Issue);
+        }
+
+    private:
+        UClass* AssetClass;
+        FName Name;
+    };
+
+    class FParticleEmitterCountRule : public FParticleRuleBase
+    {
+    public:
+        FParticleEmitterCountRule(UClass* InAssetClass, const TCHAR* SystemKind)
+            : FParticleRuleBase(InAssetClass, SystemKind, TEXT("Emitters"))
+        {
+        }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationParticleMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            const int32 MaxEmitters = Context.Analyzer.MaxEmittersPerSystem;
+            if (Metrics.NumEmitters <= MaxEmitters)
+            {
+                return;
+            }
+
+            // Every emitter ticks, sorts and draws on its own
+            const float ExcessRatio = (float)Metrics.NumEmitters / FMath::Max(MaxEmitters, 1);
+            AddIssue(Context, TEXT("Too Many Emitters"), (ExcessRatio - 1.0f) * 60.0f + 20.0f,
+                FString::Printf(TEXT("System has %d emitters (threshold: %d), %d on the GPU"),
+                    Metrics.NumEmitters, MaxEmitters, Metrics.NumGPUEmitters),
+                TEXT("Merge emitters that share a material, or move detail emitters to lower scalability levels only"), OutIssues);
+        }
+    };
+
+    class FParticleCPUCountRule : public FParticleRuleBase
+    {
+    public:
+        FParticleCPUCountRule(UClass* InAssetClass, const TCHAR* SystemKind)
+            : FParticleRuleBase(InAssetClass, SystemKind, TEXT("CPUParticles"))
+        {
+        }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationParticleMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            const int32 MaxParticles = Context.Analyzer.MaxCPUParticlesPerSystem;
+            if (Metrics.MaxCPUParticles <= MaxParticles)
+            {
+                return;
+            }
+
+            // CPU particles are simulated and uploaded on the game and render threads every frame
+            const float ExcessRatio = (float)Metrics.MaxCPUParticles / FMath::Max(MaxParticles, 1);
+            AddIssue(Context, TEXT("Many CPU Particles"), (ExcessRatio - 1.0f) * 50.0f + 30.0f,
+                FString::Printf(TEXT("Up to %d particles simulated on the CPU (threshold: %d) in %d of %d emitters; %d on the GPU"),
+                    Metrics.MaxCPUParticles, MaxParticles, Metrics.NumEmitters - Metrics.NumGPUEmitters, Metrics.NumEmitters,
+                    Metrics.MaxGPUParticles),
+                IsNiagara()
+                    ? TEXT("Switch large emitters to GPU Compute Sim, or lower their spawn rates")
+                    : TEXT("Use GPU Sprites type data for large emitters, or lower their spawn rates"),
+                OutIssues);
+        }
+    };
+
+    class FParticleBoundsRule : public FParticleRuleBase
+    {
+    public:
+        FParticleBoundsRule(UClass* InAssetClass, const TCHAR* SystemKind)
+            : FParticleRuleBase(InAssetClass, SystemKind, TEXT("Bounds"))
+        {
+        }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationParticleMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            if (Metrics.bFixedBounds || Metrics.NumEmitters == 0)
+            {
+                return;
+            }
+
+            // Dynamic bounds cost a pass over the particles every frame; GPU particles can't be read
+            // back for it, so their systems fall back to bounds that don't cull
+            const bool bHasGPUEmitters = Metrics.NumGPUEmitters > 0;
+            AddIssue(Context, TEXT("No Fixed Bounds"), bHasGPUEmitters ? 55.0f : 30.0f,
+                FString::Printf(TEXT("Bounds are computed at runtime for %d emitters, %d of them on the GPU"),
+                    Metrics.NumEmitters, Metrics.NumGPUEmitters),
+                IsNiagara()
+                    ? TEXT("Set Fixed Bounds on the system (or Calculate Bounds Mode Fixed on each emitter)")
+                    : TEXT("Enable Use Fixed Relative Bounding Box and set it from the emitter preview"),
+                OutIssues);
+        }
+    };
+
+    class FParticleScalabilityRule : public FParticleRuleBase
+    {
+    public:
+        FParticleScalabilityRule(UClass* InAssetClass, const TCHAR* SystemKind)
+            : FParticleRuleBase(InAssetClass, SystemKind, TEXT("Scalability"))
+        {
+        }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationParticleMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            if (Metrics.bHasScalability || Metrics.NumEmitters == 0)
+            {
+                return;
+            }
+
+            // Without culling or LODs every instance runs at full cost, however far or many
+            AddIssue(Context, TEXT("No Scalability Setup"), 20.0f + 5.0f * Metrics.NumEmitters,
+                IsNiagara()
+                    ? FString::Printf(TEXT("System with %d emitters has no Effect Type and no scalability overrides"), Metrics.NumEmitters)
+                    : FString::Printf(TEXT("System with %d emitters has a single LOD level"), Metrics.NumEmitters),
+                IsNiagara()
+                    ? TEXT("Assign an Effect Type with distance and instance count culling")
+                    : TEXT("Add LOD levels with fewer particles and set LOD distances"),
+                OutIssues);
+        }
+    };
+
+    class FParticleTranslucentOverdrawRule : public FParticleRuleBase
+    {
+    public:
+        FParticleTranslucentOverdrawRule(UClass* InAssetClass, const TCHAR* SystemKind)
+            : FParticleRuleBase(InAssetClass, SystemKind, TEXT("TranslucentOverdraw"))
+        {
+        }
+
+    protected:
+        virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const FOptimizationParticleMetrics& Metrics, TArray<FOptimizationIssue>& OutIssues) const override
+        {
+            const int32 MaxParticles = Context.Analyzer.MaxTranslucentParticlesPerSystem;
+            if (Metrics.MaxTranslucentParticles <= MaxParticles)
+            {
+                return;
+            }
+
+            // Overlapping translucent particles shade every pixel once per layer
+            const float ExcessRatio = (float)Metrics.MaxTranslucentParticles / FMath::Max(MaxParticles, 1);
+            AddIssue(Context, TEXT("Translucent Overdraw"), (ExcessRatio - 1.0f) * 50.0f + 30.0f,
+                FString::Printf(TEXT("Up to %d particles (threshold: %d) with translucent materials in %d emitters"),
+                    Metrics.MaxTranslucentParticles, MaxParticles, Metrics.NumTranslucentEmitters),
+                TEXT("Use fewer, larger particles, cutout sprites, or masked materials; check with the Shader Complexity view"),
+                OutIssues);
+        }
+    };
+}
+
+void FOptimizationRuleRegistry::RegisterBuiltinRules()
+{
+    const TSharedRef<IOptimizationRule> BuiltinRules[] =
+    {
+        MakeShared<FHighPolyMeshRule>(),
+        MakeShared<FMissingLODsRule>(),
+        MakeShared<FHighPolySkeletalMeshRule>(),
+        MakeShared<FMissingSkeletalLODsRule>(),
+        MakeShared<FSkeletalBoneCountRule>(),
+        MakeShared<FSkeletalBoneInfluencesRule>(),
+        MakeShared<FSkeletalSectionsRule>(),
+        MakeShared<FLargeTextureRule>(),
+        MakeShared<FNeverStreamTextureRule>(),
+        MakeShared<FNonStreamingGroupTextureRule>(),
+        MakeShared<FNonPowerOfTwoTextureRule>(),
+        MakeShared<FNoMipsTextureRule>(),
+        MakeShared<FVirtualTextureCandidateRule>(),
+        MakeShared<FTooManyTexturesRule>(),
+        MakeShared<FTwoSidedMaterialRule>(),
+        MakeShared<FComplexTranslucentMaterialRule>(),
+        MakeShared<FShaderComplexityRule>(),
+        MakeShared<FMaterialSamplersRule>(),
+        MakeShared<FExpensiveMaterialGraphRule>(),
+        MakeShared<FStaticPermutationsRule>(),
+        MakeShared<FComplexBlueprintRule>(),
+        MakeShared<FEventTickBlueprintRule>(),
+        MakeShared<FUncompressedSoundRule>(),
+        MakeShared<FHighSampleRateSoundRule>(),
+        MakeShared<FLongNonStreamingSoundRule>(),
+        MakeShared<FSoundCompressionQualityRule>(),
+        MakeShared<FSoundChannelsRule>(),
+        MakeShared<FSoundLoadingBehaviorRule>(),
+        MakeShared<FParticleEmitterCountRule>(UParticleSystem::StaticClass(), TEXT("Cascade")),
+        MakeShared<FParticleCPUCountRule>(UParticleSystem::StaticClass(), TEXT("Cascade")),
+        MakeShared<FParticleBoundsRule>(UParticleSystem::StaticClass(), TEXT("Cascade")),
+        MakeShared<FParticleScalabilityRule>(UParticleSystem::StaticClass(), TEXT("Cascade")),
+        MakeShared<FParticleTranslucentOverdrawRule>(UParticleSystem::StaticClass(), TEXT("Cascade")),
+        MakeShared<FParticleEmitterCountRule>(UNiagaraSystem::StaticClass(), TEXT("Niagara")),
+        MakeShared<FParticleCPUCountRule>(UNiagaraSystem::StaticClass(), TEXT("Niagara")),
+        MakeShared<FParticleBoundsRule>(UNiagaraSystem::StaticClass(), TEXT("Niagara")),
+        MakeShared<FParticleScalabilityRule>(UNiagaraSystem::StaticClass(), TEXT("Niagara")),
+        MakeShared<FParticleTranslucentOverdrawRule>(UNiagaraSystem::StaticClass(), TEXT("Niagara"))
+    };
+
+    for (const TSharedRef<IOptimizationRule>& Rule : BuiltinRules)
+    {
+        RegisterRule(Rule);
+        BuiltinRuleNames.Add(Rule->GetName());
+    }
+}
+
+void FOptimizationRuleRegistry::UnregisterBuiltinRules()
+{
+    for (FName RuleName : BuiltinRuleNames)
+    {
+        UnregisterRule(RuleName);
+    }
+    BuiltinRuleNames.Reset();
+}
@@ -0,0 +1,201 @@
+#include "OptimizationFrameGraph.h"
+#include "OptimizationFrameHistory.h"
+#include "OptimizationStatsSampler.h"
+#include "Rendering/DrawElements.h"
+#include "Styling/CoreStyle.h"
+#include "Fonts/SlateFontInfo.h"
+
+namespace
+{
+    // Samples copied out of the history per read
+    const int32 ReadChunkSize = 4096;
+
+    const FLinearColor SeriesColors[] =
+    {
+        FLinearColor(0.2f, 0.9f, 0.3f),   // Frame time
+        FLinearColor(0.3f, 0.6f, 1.0f),   // Draw calls
+        FLinearColor(1.0f, 0.7f, 0.2f)    // Memory
+    };
+}
+
+void SOptimizationFrameGraph::Construct(const FArguments& InArgs)
+{
+    HistorySeconds = FMath::Max(InArgs._HistorySeconds, 1.0f);
+    TargetFrameMS = InArgs._TargetFrameMS;
+
+    ReadBuffer.SetNumUninitialized(ReadChunkSize);
+}
+
+FVector2D SOptimizationFrameGraph::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+    return FVector2D(400.0f, 180.0f);
+}
+
+void SOptimizationFrameGraph::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+    const int32 NumColumns = FMath::Max(FMath::FloorToInt(AllottedGeometry.GetLocalSize().X), 1);
+    if (NumColumns != Columns.Num())
+    {
+        Rebuild(NumColumns);
+    }
+
+    ConsumeNewSamples();
+}
+
+void SOptimizationFrameGraph::Rebuild(int32 NumColumns)
+{
+    Columns.Reset();
+    Columns.SetNum(NumColumns);
+    BucketSeconds = HistorySeconds / NumColumns;
+
+    // The history drops what it no longer holds, so this starts from the oldest frame it has
+    Cursor = 0;
+}
+
+void SOptimizationFrameGraph::ConsumeNewSamples()
+{
+    const FOptimizationFrameHistory& History = FOptimizationStatsSampler::Get().GetHistory();
+
+    int32 NumRead;
+    do
+    {
+        NumRead = History.CopySince(Cursor, ReadBuffer.GetData(), ReadBuffer.Num());
+        for (int32 Index = 0; Index < NumRead; ++Index)
+        {
+            AddSample(ReadBuffer[Index]);
+        }
+    } while (NumRead == ReadBuffer.Num());
+}
+
+void SOptimizationFrameGraph::AddSample(const FOptimizationFrameSample& Sample)
+{
+    const float Values[NumSeries] = { Sample.DeltaMS, (float)Sample.DrawCalls, Sample.UsedMemoryMB };
+
+    const int64 Bucket = FMath::FloorToInt64(Sample.EndTime / BucketSeconds);
+    FColumn& Column = Columns[(int32)(Bucket % Columns.Num())];
+
+    if (Column.Bucket != Bucket)
+    {
+        // A column from one lap earlier, or never used
+        Column.Bucket = Bucket;
+        for (int32 Series = 0; Series < NumSeries; ++Series)
+        {
+            Column.Min[Series] = Values[Series];
+            Column.Max[Series] = Values[Series];
+        }
+    }
+    else
+    {
+        for (int32 Series = 0; Series < NumSeries; ++Series)
+        {
+            Column.Min[Series] = FMath::Min(Column.Min[Series], Values[Series]);
+            Column.Max[Series] = FMath::Max(Column.Max[Series], Values[Series]);
+        }
+    }
+
+    for (int32 Series = 0; Series < NumSeries; ++Series)
+    {
+        LatestValues[Series] = Values[Series];
+    }
+}
+
+int32 SOptimizationFrameGraph::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+    FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+    const FVector2D Size = AllottedGeometry.GetLocalSize();
+    const int32 NumColumns = Columns.Num();
+
+    FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(),
+        FCoreStyle::Get().GetBrush("GenericWhiteBox"), ESlateDrawEffect::None, FLinearColor(0.01f, 0.01f, 0.01f, 1.0f));
+
+    if (NumColumns == 0)
+    {
+        return LayerId;
+    }
+
+    // Newest column at the right edge; keeps scrolling when no frames arrive
+    const int64 NowBucket = FMath::FloorToInt64(FPlatformTime::Seconds() / BucketSeconds);
+    const int64 FirstBucket = NowBucket - NumColumns + 1;
+    const float ColumnWidth = Size.X / NumColumns;
+    const float LaneHeight = Size.Y / NumSeries;
+    const FSlateFontInfo Font = FCoreStyle::GetDefaultFontStyle("Regular", 8);
+
+    for (int32 Series = 0; Series < NumSeries; ++Series)
+    {
+        // Range of the visible columns; frame time and draw calls start at zero
+        float Low = Series == Memory ? MAX_flt : 0.0f;
+        float High = Series == FrameTime ? TargetFrameMS * 2.0f : 0.0f;
+        float PeakValue = 0.0f;
+        int32 NumValid = 0;
+
+        for (const FColumn& Column : Columns)
+        {
+            if (Column.Bucket < FirstBucket || Column.Bucket > NowBucket) continue;
+
+            Low = FMath::Min(Low, Column.Min[Series]);
+            High = FMath::Max(High, Column.Max[Series]);
+            PeakValue = FMath::Max(PeakValue, Column.Max[Series]);
+            ++NumValid;
+        }
+
+        const float LaneTop = LaneHeight * Series;
+        const float LaneBottom = LaneTop + LaneHeight - 2.0f;
+        const float Range = FMath::Max(High - Low, KINDA_SMALL_NUMBER);
+        const float Scale = (LaneHeight - 14.0f) / Range;
+        auto ToY = [LaneBottom, Low, Scale](float Value)
+            {
+                return LaneBottom - (Value - Low) * Scale;
+            };
+
+        if (NumValid > 0)
+        {
+            // Min and max of each column, left to right; one line list for the whole series
+            TArray<FVector2D> Points;
+            Points.Reserve(NumValid * 2);
+
+            for (int64 Bucket = FirstBucket; Bucket <= NowBucket; ++Bucket)
+            {
+                const FColumn& Column = Columns[(int32)(Bucket % NumColumns)];
+                if (Column.Bucket != Bucket) continue;
+
+                const float X = (float)(Bucket - FirstBucket) * ColumnWidth;
+                Points.Add(FVector2D(X, ToY(Column.Max[Series])));
+                if (Column.Min[Series] != Column.Max[Series])
+                {
+                    Points.Add(FVector2D(X, ToY(Column.Min[Series])));
+                }
+            }
+
+            FSlateDrawElement::MakeLines(OutDrawElements, LayerId + 1, AllottedGeometry.ToPaintGeometry(),
+                MoveTemp(Points), ESlateDrawEffect::None, SeriesColors[Series], false, 1.0f);
+        }
+
+        if (Series == FrameTime && TargetFrameMS >= Low && TargetFrameMS <= High)
+        {
+            const float TargetY = ToY(TargetFrameMS);
+            FSlateDrawElement::MakeLines(OutDrawElements, LayerId + 1, AllottedGeometry.ToPaintGeometry(),
+                { FVector2D(0.0f, TargetY), FVector2D(Size.X, TargetY) },
+                ESlateDrawEffect::None, FLinearColor(1.0f, 1.0f, 1.0f, 0.25f), false, 1.0f);
+        }
+
+        FString Label;
+        switch (Series)
+        {
+        case FrameTime:
+            Label = FString::Printf(TEXT("Frame %.2f ms (max %.2f)"), LatestValues[Series], PeakValue);
+            break;
+        case DrawCalls:
+            Label = FString::Printf(TEXT("Draw calls %.0f (max %.0f)"), LatestValues[Series], PeakValue);
+            break;
+        default:
+            Label = FString::Printf(TEXT("Memory %.0f MB (max %.0f)"), LatestValues[Series], PeakValue);
+            break;
+        }
+
+        FSlateDrawElement::MakeText(OutDrawElements, LayerId + 2,
+            AllottedGeometry.ToPaintGeometry(FVector2D(Size.X, 12.0f), FSlateLayoutTransform(FVector2D(4.0f, LaneTop + 1.0f))),
+            Label, Font, ESlateDrawEffect::None, SeriesColors[Series]);
+    }
+
+    return LayerId + 2;
+}
@@ -0,0 +1,140 @@
+#include "OptimizationFrameHistory.h"
+#include "Algo/Sort.h"
+
+static_assert(FMath::IsPowerOfTwo(FOptimizationFrameHistory::Capacity), "Capacity must be a power of two");
+
+void FOptimizationFrameHistory::Push(const FOptimizationFrameSample& Sample)
+{
+    const uint64 Index = NumPushed.load(std::memory_order_relaxed);
+    Samples[Index & (Capacity - 1)] = Sample;
+
+    // Publishes the slot
+    NumPushed.store(Index + 1, std::memory_order_release);
+}
+
+int32 FOptimizationFrameHistory::CopyLatest(FOptimizationFrameSample* OutSamples, int32 MaxSamples) const
+{
+    const uint64 End = NumPushed.load(std::memory_order_acquire);
+    const int32 Num = (int32)FMath::Min<uint64>(End, (uint64)FMath::Min(MaxSamples, Capacity));
+    return CopyRange(End - Num, Num, OutSamples);
+}
+
+int32 FOptimizationFrameHistory::CopySince(uint64& InOutCursor, FOptimizationFrameSample* OutSamples, int32 MaxSamples) const
+{
+    const uint64 End = NumPushed.load(std::memory_order_acquire);
+    const uint64 Oldest = End > Capacity ? End - Capacity : 0;
+    const uint64 Begin = FMath::Clamp(InOutCursor, Oldest, End);
+    const int32 Num = (int32)FMath::Min<uint64>(End - Begin, (uint64)FMath::Min(MaxSamples, Capacity));
+
+    // Torn samples are lost either way, the cursor moves past them too
+    InOutCursor = Begin + Num;
+    return CopyRange(Begin, Num, OutSamples);
+}
+
+int32 FOptimizationFrameHistory::CopyRange(uint64 Begin, int32 Num, FOptimizationFrameSample* OutSamples) const
+{
+    for (int32 Offset = 0; Offset < Num; ++Offset)
+    {
+        OutSamples[Offset] = Samples[(Begin + Offset) & (Capacity - 1)];
+    }
+
+    // Slots the producer reached while we were copying may be torn, drop them from the front
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64 EndAfterCopy = NumPushed.load(std::memory_order_relaxed);
+    // The producer may be writing slot EndAfterCopy already, which holds sample EndAfterCopy - Capacity
+    const uint64 OldestIntact = EndAfterCopy + 1 > Capacity ? EndAfterCopy + 1 - Capacity : 0;
+
+    if (OldestIntact > Begin)
+    {
+        const int32 NumTorn = (int32)FMath::Min<uint64>(OldestIntact - Begin, (uint64)Num);
+        const int32 NumIntact = Num - NumTorn;
+        for (int32 Offset = 0; Offset < NumIntact; ++Offset)
+        {
+            OutSamples[Offset] = OutSamples[Offset + NumTorn];
+        }
+        return NumIntact;
+    }
+
+    return Num;
+}
+
+void FOptimizationFrameHistory::ComputeSummary(float WindowSeconds, TConstArrayView<float> HitchThresholdsMS, FOptimizationFrameTimeSummary& OutSummary)
+{
+    OutSummary = FOptimizationFrameTimeSummary();
+    OutSummary.NumHitchThresholds = FMath::Min(HitchThresholdsMS.Num(), FOptimizationFrameTimeSummary::MaxHitchThresholds);
+    for (int32 Index = 0; Index < FOptimizationFrameTimeSummary::MaxHitchThresholds; ++Index)
+    {
+        OutSummary.HitchThresholdsMS[Index] = Index < OutSummary.NumHitchThresholds ? HitchThresholdsMS[Index] : 0.0f;
+        OutSummary.HitchCounts[Index] = 0;
+    }
+
+    const int32 NumCopied = CopyLatest(ScratchSamples.GetData(), SummaryCapacity);
+    if (NumCopied == 0) return;
+
+    // Newest last; keep the frames that ended inside the window
+    const double WindowStart = ScratchSamples[NumCopied - 1].EndTime - WindowSeconds;
+    int32 First = NumCopied - 1;
+    while (First > 0 && ScratchSamples[First - 1].EndTime >= WindowStart)
+    {
+        --First;
+    }
+
+    const FOptimizationFrameSample* Window = ScratchSamples.GetData() + First;
+    const int32 Num = NumCopied - First;
+    OutSummary.NumFrames = Num;
+
+    double TotalDeltaMS = 0.0;
+    for (int32 Index = 0; Index < Num; ++Index)
+    {
+        const float DeltaMS = Window[Index].DeltaMS;
+        TotalDeltaMS += DeltaMS;
+
+        for (int32 Threshold = 0; Threshold < OutSummary.NumHitchThresholds; ++Threshold)
+        {
+            if (DeltaMS > OutSummary.HitchThresholdsMS[Threshold])
+            {
+                OutSummary.HitchCounts[Threshold]++;
+            }
+        }
+    }
+
+    OutSummary.WindowSeconds = (float)(TotalDeltaMS / 1000.0);
+    OutSummary.AverageFPS = TotalDeltaMS > 0.0 ? (float)(Num * 1000.0 / TotalDeltaMS) : 0.0f;
+
+    // One column at a time through the same scratch array
+    float* Values = ScratchValues.GetData();
+    auto ComputeColumn = [Window, Num, Values](float FOptimizationFrameSample::* Member)
+        {
+            for (int32 Index = 0; Index < Num; ++Index)
+            {
+                Values[Index] = Window[Index].*Member;
+            }
+            return ComputePercentiles(Values, Num);
+        };
+
+    OutSummary.Delta = ComputeColumn(&FOptimizationFrameSample::DeltaMS);
+    OutSummary.GameThread = ComputeColumn(&FOptimizationFrameSample::GameThreadMS);
+    OutSummary.RenderThread = ComputeColumn(&FOptimizationFrameSample::RenderThreadMS);
+    OutSummary.RHIThread = ComputeColumn(&FOptimizationFrameSample::RHIThreadMS);
+}
+
+FOptimizationPercentiles FOptimizationFrameHistory::ComputePercentiles(float* Values, int32 Num)
+{
+    FOptimizationPercentiles Percentiles;
+    if (Num == 0) return Percentiles;
+
+    Algo::Sort(MakeArrayView(Values, Num));
+
+    // Nearest rank
+    auto Rank = [Values, Num](float Percent)
+        {
+            const int32 Index = FMath::Clamp(FMath::CeilToInt(Percent * Num) - 1, 0, Num - 1);
+            return Values[Index];
+        };
+
+    Percentiles.P50 = Rank(0.50f);
+    Percentiles.P95 = Rank(0.95f);
+    Percentiles.P99 = Rank(0.99f);
+    Percentiles.Max = Values[Num - 1];
+    return Percentiles;
+}
@@ -1,6 +1,9 @@
 #include "OptimizationHelperModule.h"
 #include "OptimizationWindow.h"  
 #include "PerformanceMonitorWidget.h"
+#include "OptimizationAssetMetrics.h"
+#include "OptimizationRuleRegistry.h"
+#include "OptimizationStatsSampler.h"
 #include "ToolMenus.h"
 #include "Widgets/SWindow.h"
 #include "Widgets/Text/STextBlock.h"
@@ -11,6 +14,18 @@
 void FOptimizationHelperModule::StartupModule()
 {
     UE_LOG(LogTemp, Warning, TEXT("OptimizationHelper: Plugin Started!"));
+
+    // Custom asset registry tags for the metadata-only scan
+    FOptimizationAssetMetrics::RegisterRegistryTags();
+
+    // Built-in checks; other modules add theirs through the same registry
+    FOptimizationRuleRegistry::Get().RegisterBuiltinRules();
+
+    // Frame stats are sampled from startup, so the monitor has history as soon as it opens
+    if (!IsRunningCommandlet())
+    {
+        FOptimizationStatsSampler::Get().StartSampling();
+    }
     
     UToolMenus::RegisterStartupCallback(
         FSimpleMulticastDelegate::FDelegate::CreateRaw(
@@ -23,6 +38,11 @@ void FOptimizationHelperModule::ShutdownModule()
 {
     UToolMenus::UnRegisterStartupCallback(this);
     UToolMenus::UnregisterOwner(this);
+
+    FOptimizationStatsSampler::Get().StopSampling();
+
+    FOptimizationRuleRegistry::Get().UnregisterBuiltinRules();
+    FOptimizationAssetMetrics::UnregisterRegistryTags();
 }
 
 void FOptimizationHelperModule::RegisterMenus()
@@ -0,0 +1,237 @@
+#include "OptimizationIssueTable.h"
+
+namespace
+{
+    // Private use characters, never part of issue text written by the rules
+    const TCHAR ParamMarker = TCHAR(0xE000);
+    const TCHAR AssetNameMarker = TCHAR(0xE001);
+
+    // Beyond this a double doesn't round-trip through text
+    const int32 MaxParamDigits = 15;
+    const int32 MaxParamDecimals = 9;
+
+    bool IsIdentifierChar(TCHAR Char)
+    {
+        return FChar::IsAlnum(Char) || Char == TEXT('_');
+    }
+}
+
+int32 FOptimizationIssueTable::Add(const FOptimizationIssue& Issue)
+{
+    const FName AssetPath(*Issue.AssetPath);
+    const FString AssetName = GetAssetName(AssetPath);
+
+    Severities.Add(Issue.Severity);
+    Categories.Add(Issue.Category);
+    Impacts.Add(Issue.EstimatedImpact);
+    SavingsMB.Add(Issue.EstimatedSavingsMB);
+    RuleIds.Add(Issue.RuleId);
+    AssetPaths.Add(AssetPath);
+    Titles.Add(Encode(Issue.Title, AssetName));
+    Descriptions.Add(Encode(Issue.Description, AssetName));
+    SuggestedFixes.Add(Encode(Issue.SuggestedFix, AssetName));
+
+    const int32 Row = Severities.Num() - 1;
+    checkSlow(GetTitle(Row) == Issue.Title && GetDescription(Row) == Issue.Description && GetSuggestedFix(Row) == Issue.SuggestedFix);
+    return Row;
+}
+
+void FOptimizationIssueTable::Reset()
+{
+    Severities.Reset();
+    Categories.Reset();
+    Impacts.Reset();
+    SavingsMB.Reset();
+    RuleIds.Reset();
+    AssetPaths.Reset();
+    Titles.Reset();
+    Descriptions.Reset();
+    SuggestedFixes.Reset();
+    ParamValues.Reset();
+    ParamDecimals.Reset();
+    Templates.Reset();
+}
+
+FString FOptimizationIssueTable::GetTitle(int32 Row) const
+{
+    return Decode(Titles[Row], Row);
+}
+
+FString FOptimizationIssueTable::GetDescription(int32 Row) const
+{
+    return Decode(Descriptions[Row], Row);
+}
+
+FString FOptimizationIssueTable::GetSuggestedFix(int32 Row) const
+{
+    return Decode(SuggestedFixes[Row], Row);
+}
+
+FOptimizationIssue FOptimizationIssueTable::GetIssue(int32 Row) const
+{
+    FOptimizationIssue Issue;
+    Issue.Title = GetTitle(Row);
+    Issue.Description = GetDescription(Row);
+    Issue.Severity = Severities[Row];
+    Issue.Category = Categories[Row];
+    Issue.AssetPath = AssetPaths[Row].IsNone() ? FString() : AssetPaths[Row].ToString();
+    Issue.EstimatedImpact = Impacts[Row];
+    Issue.EstimatedSavingsMB = SavingsMB[Row];
+    Issue.SuggestedFix = GetSuggestedFix(Row);
+    Issue.RuleId = RuleIds[Row];
+    return Issue;
+}
+
+SIZE_T FOptimizationIssueTable::GetAllocatedSize() const
+{
+    SIZE_T Size = Severities.GetAllocatedSize()
+        + Categories.GetAllocatedSize()
+        + Impacts.GetAllocatedSize()
+        + SavingsMB.GetAllocatedSize()
+        + RuleIds.GetAllocatedSize()
+        + AssetPaths.GetAllocatedSize()
+        + Titles.GetAllocatedSize()
+        + Descriptions.GetAllocatedSize()
+        + SuggestedFixes.GetAllocatedSize()
+        + ParamValues.GetAllocatedSize()
+        + ParamDecimals.GetAllocatedSize()
+        + Templates.GetAllocatedSize();
+
+    for (const FString& Template : Templates)
+    {
+        Size += Template.GetAllocatedSize();
+    }
+    return Size;
+}
+
+FOptimizationIssueTable::FEncodedText FOptimizationIssueTable::Encode(const FString& Text, const FString& AssetName)
+{
+    FEncodedText Encoded;
+    Encoded.FirstParam = ParamValues.Num();
+
+    FString Template;
+    Template.Reserve(Text.Len());
+
+    // Text that already contains a marker is kept verbatim
+    int32 MarkerIndex = INDEX_NONE;
+    const bool bVerbatim = Text.FindChar(ParamMarker, MarkerIndex) || Text.FindChar(AssetNameMarker, MarkerIndex);
+
+    const TCHAR* Chars = *Text;
+    const int32 Len = Text.Len();
+    int32 Index = 0;
+
+    while (!bVerbatim && Index < Len)
+    {
+        const bool bTokenStart = (Index == 0) || !(IsIdentifierChar(Chars[Index - 1]) || Chars[Index - 1] == TEXT('.'));
+
+        // Asset name as a whole word
+        if (bTokenStart && AssetName.Len() > 0
+            && FCString::Strncmp(Chars + Index, *AssetName, AssetName.Len()) == 0
+            && (Index + AssetName.Len() == Len || !IsIdentifierChar(Chars[Index + AssetName.Len()])))
+        {
+            Template.AppendChar(AssetNameMarker);
+            Index += AssetName.Len();
+            continue;
+        }
+
+        if (bTokenStart && FChar::IsDigit(Chars[Index]))
+        {
+            int32 End = Index;
+            while (End < Len && FChar::IsDigit(Chars[End])) ++End;
+            const int32 IntegerDigits = End - Index;
+
+            int32 Decimals = 0;
+            if (End + 1 < Len && Chars[End] == TEXT('.') && FChar::IsDigit(Chars[End + 1]))
+            {
+                int32 FractionEnd = End + 1;
+                while (FractionEnd < Len && FChar::IsDigit(Chars[FractionEnd])) ++FractionEnd;
+                Decimals = FractionEnd - End - 1;
+                End = FractionEnd;
+            }
+
+            // Leading zeros ("007") and very long numbers wouldn't print back the same
+            const bool bLeadingZero = IntegerDigits > 1 && Chars[Index] == TEXT('0');
+            if (!bLeadingZero && IntegerDigits + Decimals <= MaxParamDigits && Decimals <= MaxParamDecimals)
+            {
+                ParamValues.Add(FCString::Atod(*Text.Mid(Index, End - Index)));
+                ParamDecimals.Add((uint8)Decimals);
+                Template.AppendChar(ParamMarker);
+            }
+            else
+            {
+                Template.AppendChars(Chars + Index, End - Index);
+            }
+
+            Index = End;
+            continue;
+        }
+
+        Template.AppendChar(Chars[Index]);
+        ++Index;
+    }
+
+    if (bVerbatim)
+    {
+        Template = Text;
+    }
+
+    Encoded.NumParams = bVerbatim ? INDEX_NONE : ParamValues.Num() - Encoded.FirstParam;
+    Encoded.TemplateId = Templates.Add(MoveTemp(Template)).AsInteger();
+    return Encoded;
+}
+
+FString FOptimizationIssueTable::Decode(const FEncodedText& Encoded, int32 Row) const
+{
+    const FString& Template = Templates[FSetElementId::FromInteger(Encoded.TemplateId)];
+
+    // Fast path: verbatim, or nothing was cut out
+    int32 MarkerIndex = INDEX_NONE;
+    if (Encoded.NumParams == INDEX_NONE || (Encoded.NumParams == 0 && !Template.FindChar(AssetNameMarker, MarkerIndex)))
+    {
+        return Template;
+    }
+
+    FString Text;
+    Text.Reserve(Template.Len() + Encoded.NumParams * 8);
+
+    int32 ParamIndex = Encoded.FirstParam;
+    for (TCHAR Char : Template)
+    {
+        if (Char == ParamMarker)
+        {
+            const uint8 Decimals = ParamDecimals[ParamIndex];
+            Text += Decimals == 0
+                ? FString::Printf(TEXT("%lld"), (int64)ParamValues[ParamIndex])
+                : FString::Printf(TEXT("%.*f"), (int32)Decimals, ParamValues[ParamIndex]);
+            ++ParamIndex;
+        }
+        else if (Char == AssetNameMarker)
+        {
+            Text += GetAssetName(AssetPaths[Row]);
+        }
+        else
+        {
+            Text.AppendChar(Char);
+        }
+    }
+
+    return Text;
+}
+
+FString FOptimizationIssueTable::GetAssetName(FName AssetPath)
+{
+    if (AssetPath.IsNone())
+    {
+        return FString();
+    }
+
+    // Object paths end in "Package.Object", anything else (e.g. "Project-wide") has no name to share
+    const FString PathString = AssetPath.ToString();
+    int32 DotIndex = INDEX_NONE;
+    if (!PathString.StartsWith(TEXT("/")) || !PathString.FindLastChar(TEXT('.'), DotIndex))
+    {
+        return FString();
+    }
+
+    return PathString.Mid(DotIndex + 1);
+}
@@ -0,0 +1,320 @@
+#include "OptimizationMaterialGraph.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Hash/xxhash.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialFunction.h"
+#include "Materials/MaterialExpressionCustom.h"
+#include "Materials/MaterialExpressionMaterialFunctionCall.h"
+#include "Materials/MaterialExpressionNoise.h"
+#include "Materials/MaterialExpressionSceneColor.h"
+#include "Materials/MaterialExpressionSceneDepth.h"
+#include "Materials/MaterialExpressionSceneTexture.h"
+#include "Materials/MaterialExpressionTextureSample.h"
+#include "Materials/MaterialExpressionVectorNoise.h"
+
+namespace
+{
+    // Estimated extra pixel shader instructions per occurrence. Noise costs per octave,
+    // big Custom nodes about one instruction per line.
+    constexpr int32 DependentTextureReadCost = 30;
+    constexpr int32 NoiseCostPerLevel = 16;
+    constexpr int32 VectorNoiseCost = 80;
+    constexpr int32 SceneTextureCost = 20;
+    constexpr int32 SceneColorCost = 40;
+    constexpr int32 PixelDepthOffsetCost = 50;
+
+    using FExpressionView = TConstArrayView<TObjectPtr<UMaterialExpression>>;
+
+    TMap<uint64, FOptimizationMaterialGraphCost> GraphCostCache;
+
+    template <typename ValueType>
+    void UpdateHash(FXxHash64Builder& Builder, const ValueType& Value)
+    {
+        static_assert(TIsPODType<ValueType>::Value, "Only plain values are hashed by their bytes");
+        Builder.Update(&Value, sizeof(Value));
+    }
+
+    // Names by their text, FName indices differ between sessions
+    void UpdateHash(FXxHash64Builder& Builder, const FString& Value)
+    {
+        UpdateHash(Builder, Value.Len());
+        Builder.Update(*Value, Value.Len() * sizeof(TCHAR));
+    }
+
+    FIoHash GetSavedHash(FName PackageName)
+    {
+        TOptional<FAssetPackageData> PackageData = IAssetRegistry::GetChecked().GetAssetPackageDataCopy(PackageName);
+        return PackageData.IsSet() ? PackageData->GetPackageSavedHash() : FIoHash::Zero;
+    }
+
+    const UMaterialFunction* GetCalledFunction(const UMaterialExpression* Expression)
+    {
+        const UMaterialExpressionMaterialFunctionCall* Call = Cast<UMaterialExpressionMaterialFunctionCall>(Expression);
+        return Call && Call->MaterialFunction ? Call->MaterialFunction->GetBaseFunction() : nullptr;
+    }
+
+    template <typename FunctorType>
+    void ForEachInput(const UMaterialExpression* Expression, FunctorType&& Functor)
+    {
+        // GetInput is not const, it only hands out pointers to the members
+        UMaterialExpression* MutableExpression = const_cast<UMaterialExpression*>(Expression);
+        for (int32 InputIndex = 0; const FExpressionInput* Input = MutableExpression->GetInput(InputIndex); ++InputIndex)
+        {
+            Functor(*Input);
+        }
+    }
+
+    int32 CountLines(const FString& Code)
+    {
+        int32 Lines = 1;
+        for (TCHAR Char : Code)
+        {
+            Lines += (Char == TEXT('\n'));
+        }
+        return Lines;
+    }
+
+    // A texture sample feeds the expression, directly or through math. Answers are kept for the
+    // whole traversal, samples sharing upstream math walk it once. An expression still being
+    // walked counts as no read (cycles only exist in broken graphs).
+    bool HasUpstreamTextureRead(const UMaterialExpression* Expression, TMap<const UMaterialExpression*, bool>& Known)
+    {
+        if (!Expression)
+        {
+            return false;
+        }
+        if (const bool* bKnown = Known.Find(Expression))
+        {
+            return *bKnown;
+        }
+        Known.Add(Expression, false);
+
+        bool bFound = Expression->IsA<UMaterialExpressionTextureSample>();
+        if (!bFound)
+        {
+            ForEachInput(Expression, [&](const FExpressionInput& Input)
+            {
+                bFound = bFound || HasUpstreamTextureRead(Input.Expression, Known);
+            });
+        }
+
+        Known.Add(Expression, bFound);
+        return bFound;
+    }
+
+    void HashExpressions(FExpressionView Expressions, FXxHash64Builder& Builder, TSet<const UMaterialFunction*>& VisitedFunctions)
+    {
+        TMap<const UMaterialExpression*, int32> Indices;
+        for (int32 Index = 0; Index < Expressions.Num(); ++Index)
+        {
+            Indices.Add(Expressions[Index], Index);
+        }
+
+        for (const UMaterialExpression* Expression : Expressions)
+        {
+            if (!Expression) continue;
+
+            UpdateHash(Builder, Expression->GetClass()->GetName());
+            ForEachInput(Expression, [&](const FExpressionInput& Input)
+            {
+                const int32* InputIndex = Input.Expression ? Indices.Find(Input.Expression) : nullptr;
+                UpdateHash(Builder, InputIndex ? *InputIndex : INDEX_NONE);
+                UpdateHash(Builder, Input.OutputIndex);
+            });
+
+            if (const UMaterialExpressionNoise* Noise = Cast<UMaterialExpressionNoise>(Expression))
+            {
+                UpdateHash(Builder, Noise->Levels);
+            }
+            else if (const UMaterialExpressionCustom* Custom = Cast<UMaterialExpressionCustom>(Expression))
+            {
+                UpdateHash(Builder, Custom->Code);
+            }
+            else if (const UMaterialFunction* Function = GetCalledFunction(Expression))
+            {
+                UpdateHash(Builder, Function->GetPathName());
+                if (!VisitedFunctions.Contains(Function))
+                {
+                    VisitedFunctions.Add(Function);
+                    HashExpressions(Function->GetExpressions(), Builder, VisitedFunctions);
+                }
+            }
+        }
+    }
+
+    void AddPattern(FOptimizationMaterialGraphCost& OutCost, EOptimizationMaterialPattern Pattern, int32 Cost)
+    {
+        FOptimizationMaterialPatternCost& PatternCost = OutCost.Patterns[(int32)Pattern];
+        ++PatternCost.Count;
+        PatternCost.Cost += Cost;
+    }
+
+    struct FPatternSearch
+    {
+        bool bPostProcess = false;
+        TSet<const UMaterialFunction*> VisitedFunctions;
+        TMap<const UMaterialExpression*, bool> UpstreamTextureReads;
+    };
+
+    void FindPatterns(FExpressionView Expressions, FOptimizationMaterialGraphCost& OutCost, FPatternSearch& Search)
+    {
+        for (const UMaterialExpression* Expression : Expressions)
+        {
+            if (!Expression) continue;
+
+            if (const UMaterialExpressionTextureSample* Sample = Cast<UMaterialExpressionTextureSample>(Expression))
+            {
+                if (HasUpstreamTextureRead(Sample->Coordinates.Expression, Search.UpstreamTextureReads))
+                {
+                    AddPattern(OutCost, EOptimizationMaterialPattern::DependentTextureRead, DependentTextureReadCost);
+                }
+            }
+            else if (const UMaterialExpressionNoise* Noise = Cast<UMaterialExpressionNoise>(Expression))
+            {
+                AddPattern(OutCost, EOptimizationMaterialPattern::Noise, NoiseCostPerLevel * FMath::Max(Noise->Levels, 1));
+            }
+            else if (Expression->IsA<UMaterialExpressionVectorNoise>())
+            {
+                AddPattern(OutCost, EOptimizationMaterialPattern::Noise, VectorNoiseCost);
+            }
+            else if (Expression->IsA<UMaterialExpressionSceneTexture>() || Expression->IsA<UMaterialExpressionSceneDepth>())
+            {
+                // Reading the scene is what post process materials are for
+                if (!Search.bPostProcess)
+                {
+                    AddPattern(OutCost, EOptimizationMaterialPattern::SceneTexture, SceneTextureCost);
+                }
+            }
+            else if (Expression->IsA<UMaterialExpressionSceneColor>())
+            {
+                AddPattern(OutCost, EOptimizationMaterialPattern::SceneColor, SceneColorCost);
+            }
+            else if (const UMaterialExpressionCustom* Custom = Cast<UMaterialExpressionCustom>(Expression))
+            {
+                const int32 Lines = CountLines(Custom->Code);
+                if (Lines >= FOptimizationMaterialGraph::BigCustomNodeLines)
+                {
+                    AddPattern(OutCost, EOptimizationMaterialPattern::CustomHLSL, Lines);
+                }
+            }
+            else if (const UMaterialFunction* Function = GetCalledFunction(Expression))
+            {
+                // Each function once, however often it is called
+                if (!Search.VisitedFunctions.Contains(Function))
+                {
+                    Search.VisitedFunctions.Add(Function);
+                    FindPatterns(Function->GetExpressions(), OutCost, Search);
+                }
+            }
+        }
+    }
+}
+
+int32 FOptimizationMaterialGraphCost::GetTotalCost() const
+{
+    int32 Total = 0;
+    for (const FOptimizationMaterialPatternCost& PatternCost : Patterns)
+    {
+        Total += PatternCost.Cost;
+    }
+    return Total;
+}
+
+void FOptimizationMaterialGraph::Analyze(const UMaterial* Material, FOptimizationMaterialGraphCost& OutCost)
+{
+    check(IsInGameThread());
+
+    OutCost = FOptimizationMaterialGraphCost();
+    if (!Material) return;
+
+    TSet<FName> FunctionPackages;
+    const uint64 GraphHash = CalcGraphHash(Material, &FunctionPackages);
+
+    // The function graphs are part of the hash, a hit is the same cost. Their saved hashes are
+    // taken again, a function saved without graph changes must not make the tag look stale.
+    if (const FOptimizationMaterialGraphCost* Cached = GraphCostCache.Find(GraphHash))
+    {
+        OutCost = *Cached;
+    }
+    else
+    {
+        FPatternSearch Search;
+        Search.bPostProcess = Material->MaterialDomain == MD_PostProcess;
+        FindPatterns(Material->GetExpressions(), OutCost, Search);
+
+        if (Material->HasPixelDepthOffsetConnected())
+        {
+            AddPattern(OutCost, EOptimizationMaterialPattern::PixelDepthOffset, PixelDepthOffsetCost);
+        }
+
+        OutCost.GraphHash = GraphHash;
+
+        // Saves analyze too, for the whole editor session; start over rather than grow unbounded
+        if (GraphCostCache.Num() >= FOptimizationMaterialGraph::MaxCachedGraphs)
+        {
+            GraphCostCache.Reset();
+        }
+        GraphCostCache.Add(GraphHash, OutCost);
+    }
+
+    OutCost.FunctionPackages.Reset();
+    for (FName PackageName : FunctionPackages)
+    {
+        OutCost.FunctionPackages.Add(PackageName, GetSavedHash(PackageName));
+    }
+}
+
+bool FOptimizationMaterialGraph::AreFunctionsCurrent(const FOptimizationMaterialGraphCost& Cost)
+{
+    for (const TPair<FName, FIoHash>& Function : Cost.FunctionPackages)
+    {
+        if (GetSavedHash(Function.Key) != Function.Value)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64 FOptimizationMaterialGraph::CalcGraphHash(const UMaterial* Material, TSet<FName>* OutFunctionPackages)
+{
+    if (!Material) return 0;
+
+    FXxHash64Builder Builder;
+    UpdateHash(Builder, (int32)Material->MaterialDomain);
+    UpdateHash(Builder, Material->HasPixelDepthOffsetConnected());
+
+    TSet<const UMaterialFunction*> VisitedFunctions;
+    HashExpressions(Material->GetExpressions(), Builder, VisitedFunctions);
+
+    if (OutFunctionPackages)
+    {
+        for (const UMaterialFunction* Function : VisitedFunctions)
+        {
+            OutFunctionPackages->Add(Function->GetOutermost()->GetFName());
+        }
+    }
+
+    // 0 means "not analyzed"
+    const uint64 Hash = Builder.Finalize().Hash;
+    return Hash != 0 ? Hash : 1;
+}
+
+const TCHAR* FOptimizationMaterialGraph::GetPatternName(EOptimizationMaterialPattern Pattern)
+{
+    switch (Pattern)
+    {
+    case EOptimizationMaterialPattern::DependentTextureRead: return TEXT("dependent texture reads");
+    case EOptimizationMaterialPattern::Noise:                return TEXT("noise nodes");
+    case EOptimizationMaterialPattern::SceneTexture:         return TEXT("scene texture lookups");
+    case EOptimizationMaterialPattern::SceneColor:           return TEXT("scene color lookups");
+    case EOptimizationMaterialPattern::CustomHLSL:           return TEXT("large Custom HLSL nodes");
+    case EOptimizationMaterialPattern::PixelDepthOffset:     return TEXT("pixel depth offset");
+    default:                                                 return TEXT("unknown");
+    }
+}
+
+void FOptimizationMaterialGraph::ResetCache()
+{
+    GraphCostCache.Reset();
+}
@@ -0,0 +1,89 @@
+#include "OptimizationRenderStats.h"
+#include "RHI.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+// Draw call categories (DECLARE_GPU_DRAWCALL_STAT) are readable from 5.3 on
+#define OPTIMIZATION_HAS_DRAW_CATEGORIES (HAS_GPU_STATS && (ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3)))
+
+#if OPTIMIZATION_HAS_DRAW_CATEGORIES
+#include "RHIStats.h"
+#endif
+
+namespace
+{
+#if OPTIMIZATION_HAS_DRAW_CATEGORIES
+    // Categories are named after the renderer's passes ("BasePass", "ShadowDepths", "Translucency"...)
+    void ReadPassCounters(FOptimizationRenderCounters& OutCounters)
+    {
+        const FRHIDrawStatsCategory::FManager& Manager = FRHIDrawStatsCategory::GetManager();
+
+        for (int32 CategoryIndex = 0; CategoryIndex < Manager.NumCategory; ++CategoryIndex)
+        {
+            const FRHIDrawStatsCategory* Category = Manager.Array[CategoryIndex];
+            if (!Category) continue;
+
+            int32 Count = 0;
+            for (int32 GPUIndex = 0; GPUIndex < MAX_NUM_GPUS; ++GPUIndex)
+            {
+                Count += Manager.DisplayCounts[CategoryIndex][GPUIndex];
+            }
+
+            const FString Name = Category->Name.ToString();
+            if (Name.Contains(TEXT("BasePass")))
+            {
+                OutCounters.BasePassDrawCalls += Count;
+            }
+            else if (Name.Contains(TEXT("ShadowDepth")))
+            {
+                OutCounters.ShadowDepthDrawCalls += Count;
+            }
+            else if (Name.Contains(TEXT("Translucen")))
+            {
+                OutCounters.TranslucencyDrawCalls += Count;
+            }
+        }
+
+        OutCounters.bHasPassBreakdown = Manager.NumCategory > 0;
+    }
+#endif
+}
+
+bool OptimizationRenderStats::HasRenderCounters()
+{
+    return GIsRHIInitialized && !GUsingNullRHI;
+}
+
+bool OptimizationRenderStats::ReadRenderCounters(FOptimizationRenderCounters& OutCounters)
+{
+    OutCounters = FOptimizationRenderCounters();
+
+    if (!ReadDrawCounters(OutCounters.DrawCalls, OutCounters.PrimitivesDrawn))
+    {
+        return false;
+    }
+
+#if OPTIMIZATION_HAS_DRAW_CATEGORIES
+    ReadPassCounters(OutCounters);
+#endif
+
+    return true;
+}
+
+bool OptimizationRenderStats::ReadDrawCounters(int32& OutDrawCalls, int32& OutPrimitivesDrawn)
+{
+    OutDrawCalls = 0;
+    OutPrimitivesDrawn = 0;
+
+    if (!HasRenderCounters())
+    {
+        return false;
+    }
+
+    // Copied by the RHI at the end of each frame, so this is the previous frame (what "stat rhi" shows)
+    for (int32 GPUIndex = 0; GPUIndex < MAX_NUM_GPUS; ++GPUIndex)
+    {
+        OutDrawCalls += GNumDrawCallsRHI[GPUIndex];
+        OutPrimitivesDrawn += GNumPrimitivesDrawnRHI[GPUIndex];
+    }
+    return true;
+}
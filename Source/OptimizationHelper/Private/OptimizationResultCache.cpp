@@ -0,0 +1,413 @@
+#include "OptimizationResultCache.h"
+#include "OptimizationAssetMetrics.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Package.h"
+#include "UObject/ObjectSaveContext.h"
+
+namespace
+{
+    const uint32 CacheFileMagic = 0x4F484331; // "OHC1"
+
+    void SerializeIssue(FArchive& Ar, FOptimizationIssue& Issue)
+    {
+        Ar << Issue.Title;
+        Ar << Issue.Description;
+        Ar << Issue.Severity;
+        Ar << Issue.Category;
+        Ar << Issue.AssetPath;
+        Ar << Issue.EstimatedImpact;
+        Ar << Issue.EstimatedSavingsMB;
+        Ar << Issue.SuggestedFix;
+        Ar << Issue.RuleId;
+    }
+
+    void SerializeAsset(FArchive& Ar, FName& AssetName, FOptimizationCachedAsset& Asset)
+    {
+        Ar << AssetName;
+        Ar << Asset.Metrics;
+        Ar << Asset.bHasIssues;
+
+        int32 NumIssues = Asset.Issues.Num();
+        Ar << NumIssues;
+        if (Ar.IsLoading())
+        {
+            // Don't trust a count larger than what is left of the file
+            if (NumIssues < 0 || NumIssues > Ar.TotalSize() - Ar.Tell())
+            {
+                Ar.SetError();
+                return;
+            }
+            Asset.Issues.SetNum(NumIssues);
+        }
+
+        for (FOptimizationIssue& Issue : Asset.Issues)
+        {
+            if (Ar.IsError()) return;
+            SerializeIssue(Ar, Issue);
+        }
+    }
+}
+
+FOptimizationResultCache::FOptimizationResultCache()
+{
+    IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+    AssetRegistry.OnAssetAdded().AddRaw(this, &FOptimizationResultCache::OnAssetAdded);
+    AssetRegistry.OnAssetRemoved().AddRaw(this, &FOptimizationResultCache::OnAssetRemoved);
+    AssetRegistry.OnAssetUpdated().AddRaw(this, &FOptimizationResultCache::OnAssetUpdated);
+    AssetRegistry.OnAssetRenamed().AddRaw(this, &FOptimizationResultCache::OnAssetRenamed);
+
+    UPackage::PackageSavedWithContextEvent.AddRaw(this, &FOptimizationResultCache::OnPackageSaved);
+}
+
+FOptimizationResultCache::~FOptimizationResultCache()
+{
+    // The registry may already be gone during editor shutdown
+    if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+    {
+        AssetRegistry->OnAssetAdded().RemoveAll(this);
+        AssetRegistry->OnAssetRemoved().RemoveAll(this);
+        AssetRegistry->OnAssetUpdated().RemoveAll(this);
+        AssetRegistry->OnAssetRenamed().RemoveAll(this);
+    }
+
+    UPackage::PackageSavedWithContextEvent.RemoveAll(this);
+}
+
+const FOptimizationCachedAsset* FOptimizationResultCache::Find(const FAssetData& AssetData) const
+{
+    check(IsInGameThread());
+
+    if (DirtyPackages.Contains(AssetData.PackageName))
+    {
+        return nullptr;
+    }
+
+    const FPackageEntry* Entry = Packages.Find(AssetData.PackageName);
+    if (!Entry || Entry->SavedHash != GetSavedHash(AssetData.PackageName))
+    {
+        return nullptr;
+    }
+
+    return Entry->Assets.Find(AssetData.AssetName);
+}
+
+void FOptimizationResultCache::Store(const FAssetData& AssetData, TArray<uint8>&& Metrics, const TArray<FOptimizationIssue>& Issues)
+{
+    check(IsInGameThread());
+
+    // Unsaved packages have no hash to validate against later
+    const FIoHash SavedHash = GetSavedHash(AssetData.PackageName);
+    if (SavedHash.IsZero())
+    {
+        return;
+    }
+
+    FPackageEntry& Entry = Packages.FindOrAdd(AssetData.PackageName);
+    if (Entry.SavedHash != SavedHash || DirtyPackages.Remove(AssetData.PackageName) > 0)
+    {
+        // Results of other assets in the package are stale as well
+        Entry.Assets.Reset();
+        Entry.SavedHash = SavedHash;
+    }
+
+    FOptimizationCachedAsset& Asset = Entry.Assets.FindOrAdd(AssetData.AssetName);
+    Asset.Metrics = MoveTemp(Metrics);
+    Asset.Issues = Issues;
+    Asset.bHasIssues = true;
+
+    bModified = true;
+}
+
+void FOptimizationResultCache::SetSettingsHash(uint32 InSettingsHash)
+{
+    if (SettingsHash != InSettingsHash)
+    {
+        // Metrics don't depend on thresholds, only the issues have to be re-evaluated
+        DropIssues();
+        SettingsHash = InSettingsHash;
+    }
+}
+
+void FOptimizationResultCache::GetAllIssues(TArray<FOptimizationIssue>& OutIssues) const
+{
+    for (const TPair<FName, FPackageEntry>& PackagePair : Packages)
+    {
+        for (const TPair<FName, FOptimizationCachedAsset>& AssetPair : PackagePair.Value.Assets)
+        {
+            if (AssetPair.Value.bHasIssues)
+            {
+                OutIssues.Append(AssetPair.Value.Issues);
+            }
+        }
+    }
+}
+
+void FOptimizationResultCache::Reset()
+{
+    Packages.Reset();
+    DirtyPackages.Reset();
+    bModified = true;
+}
+
+void FOptimizationResultCache::DropIssues()
+{
+    for (TPair<FName, FPackageEntry>& PackagePair : Packages)
+    {
+        for (TPair<FName, FOptimizationCachedAsset>& AssetPair : PackagePair.Value.Assets)
+        {
+            AssetPair.Value.Issues.Reset();
+            AssetPair.Value.bHasIssues = false;
+        }
+    }
+    bModified = true;
+}
+
+// ==================== DISK ====================
+
+FString FOptimizationResultCache::GetCacheFilePath()
+{
+    return FPaths::ProjectSavedDir() / TEXT("OptimizationHelper") / TEXT("AnalysisCache.bin");
+}
+
+bool FOptimizationResultCache::LoadFromDisk()
+{
+    const FString FilePath = GetCacheFilePath();
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (!PlatformFile.FileExists(*FilePath))
+    {
+        return false;
+    }
+
+    // Map the file instead of copying it into a buffer first (the region is released before the handle)
+    TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*FilePath));
+    TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile ? MappedFile->MapRegion() : nullptr);
+
+    TArray<uint8> FileData;
+    TArrayView<const uint8> FileView;
+    if (MappedRegion && MappedRegion->GetMappedSize() <= MAX_int32)
+    {
+        FileView = MakeArrayView(MappedRegion->GetMappedPtr(), (int32)MappedRegion->GetMappedSize());
+    }
+    else if (FFileHelper::LoadFileToArray(FileData, *FilePath))
+    {
+        // Platforms without mapping support
+        FileView = FileData;
+    }
+    else
+    {
+        return false;
+    }
+
+    FMemoryReaderView Reader(FileView);
+
+    uint32 Magic = 0;
+    int32 FormatVersion = 0;
+    int32 MetricsVersion = 0;
+    int32 LoadedRuleSetVersion = 0;
+    uint32 LoadedSettingsHash = 0;
+    Reader << Magic;
+    Reader << FormatVersion;
+    Reader << MetricsVersion;
+    Reader << LoadedRuleSetVersion;
+    Reader << LoadedSettingsHash;
+
+    if (Reader.IsError() || Magic != CacheFileMagic || FormatVersion != FileFormatVersion
+        || MetricsVersion != FOptimizationAssetMetrics::CurrentTagVersion)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Ignoring outdated analysis cache: %s"), *FilePath);
+        return false;
+    }
+
+    Packages.Reset();
+    DirtyPackages.Reset();
+    Serialize(Reader);
+
+    if (Reader.IsError())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Analysis cache is corrupted, ignoring it: %s"), *FilePath);
+        Packages.Reset();
+        return false;
+    }
+
+    SettingsHash = LoadedSettingsHash;
+    if (LoadedRuleSetVersion != RuleSetVersion)
+    {
+        DropIssues();
+    }
+    bModified = false;
+
+    UE_LOG(LogTemp, Log, TEXT("Loaded analysis cache: %d packages from %s"), Packages.Num(), *FilePath);
+    return true;
+}
+
+bool FOptimizationResultCache::SaveToDisk()
+{
+    if (!bModified)
+    {
+        return true;
+    }
+
+    TArray<uint8> FileData;
+    FMemoryWriter Writer(FileData);
+
+    uint32 Magic = CacheFileMagic;
+    int32 FormatVersion = FileFormatVersion;
+    int32 MetricsVersion = FOptimizationAssetMetrics::CurrentTagVersion;
+    int32 SavedRuleSetVersion = RuleSetVersion;
+    uint32 SavedSettingsHash = SettingsHash;
+    Writer << Magic;
+    Writer << FormatVersion;
+    Writer << MetricsVersion;
+    Writer << SavedRuleSetVersion;
+    Writer << SavedSettingsHash;
+
+    Serialize(Writer);
+
+    // Write to a temp file first so a crash never leaves a truncated cache behind
+    const FString FilePath = GetCacheFilePath();
+    const FString TempFilePath = FilePath + TEXT(".tmp");
+    if (!FFileHelper::SaveArrayToFile(FileData, *TempFilePath) || !IFileManager::Get().Move(*FilePath, *TempFilePath, true))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to write analysis cache: %s"), *FilePath);
+        return false;
+    }
+
+    bModified = false;
+
+    UE_LOG(LogTemp, Log, TEXT("Saved analysis cache: %d packages, %d KB"), Packages.Num(), FileData.Num() / 1024);
+    return true;
+}
+
+void FOptimizationResultCache::Serialize(FArchive& Ar)
+{
+    int32 NumPackages = Packages.Num();
+    Ar << NumPackages;
+
+    if (Ar.IsLoading())
+    {
+        // Every package takes at least one byte; a count beyond what is left is a corrupted file,
+        // not something to reserve memory for
+        if (NumPackages < 0 || NumPackages > Ar.TotalSize() - Ar.Tell())
+        {
+            Ar.SetError();
+            return;
+        }
+
+        Packages.Reserve(NumPackages);
+        for (int32 Index = 0; Index < NumPackages && !Ar.IsError(); ++Index)
+        {
+            FName PackageName;
+            FPackageEntry Entry;
+            SerializePackage(Ar, PackageName, Entry);
+            Packages.Add(PackageName, MoveTemp(Entry));
+        }
+    }
+    else
+    {
+        for (TPair<FName, FPackageEntry>& PackagePair : Packages)
+        {
+            FName PackageName = PackagePair.Key;
+            SerializePackage(Ar, PackageName, PackagePair.Value);
+        }
+    }
+}
+
+void FOptimizationResultCache::SerializePackage(FArchive& Ar, FName& PackageName, FPackageEntry& Entry)
+{
+    Ar << PackageName;
+    Ar << Entry.SavedHash;
+
+    int32 NumAssets = Entry.Assets.Num();
+    Ar << NumAssets;
+
+    if (Ar.IsLoading())
+    {
+        for (int32 Index = 0; Index < NumAssets && !Ar.IsError(); ++Index)
+        {
+            FName AssetName;
+            FOptimizationCachedAsset Asset;
+            SerializeAsset(Ar, AssetName, Asset);
+            Entry.Assets.Add(AssetName, MoveTemp(Asset));
+        }
+    }
+    else
+    {
+        for (TPair<FName, FOptimizationCachedAsset>& AssetPair : Entry.Assets)
+        {
+            FName AssetName = AssetPair.Key;
+            SerializeAsset(Ar, AssetName, AssetPair.Value);
+        }
+    }
+}
+
+// ==================== EVENTS ====================
+
+void FOptimizationResultCache::OnAssetAdded(const FAssetData& AssetData)
+{
+    // The initial registry scan reports every asset as added; entries loaded
+    // from disk are validated by their saved hash instead
+    if (IAssetRegistry::GetChecked().IsLoadingAssets())
+    {
+        return;
+    }
+
+    MarkDirty(AssetData.PackageName);
+}
+
+void FOptimizationResultCache::OnAssetRemoved(const FAssetData& AssetData)
+{
+    if (Packages.Remove(AssetData.PackageName) > 0)
+    {
+        bModified = true;
+    }
+    DirtyPackages.Remove(AssetData.PackageName);
+}
+
+void FOptimizationResultCache::OnAssetUpdated(const FAssetData& AssetData)
+{
+    MarkDirty(AssetData.PackageName);
+}
+
+void FOptimizationResultCache::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    const FName OldPackageName(*FPackageName::ObjectPathToPackageName(OldObjectPath));
+    if (Packages.Remove(OldPackageName) > 0)
+    {
+        bModified = true;
+    }
+    DirtyPackages.Remove(OldPackageName);
+
+    MarkDirty(AssetData.PackageName);
+}
+
+void FOptimizationResultCache::OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext ObjectSaveContext)
+{
+    if (Package)
+    {
+        MarkDirty(Package->GetFName());
+    }
+}
+
+void FOptimizationResultCache::MarkDirty(FName PackageName)
+{
+    // Packages we never evaluated have nothing to invalidate
+    if (Packages.Contains(PackageName))
+    {
+        DirtyPackages.Add(PackageName);
+    }
+}
+
+FIoHash FOptimizationResultCache::GetSavedHash(FName PackageName)
+{
+    TOptional<FAssetPackageData> PackageData = IAssetRegistry::GetChecked().GetAssetPackageDataCopy(PackageName);
+    return PackageData.IsSet() ? PackageData->GetPackageSavedHash() : FIoHash::Zero;
+}
@@ -0,0 +1,76 @@
+#include "OptimizationRuleRegistry.h"
+
+FOptimizationRuleRegistry& FOptimizationRuleRegistry::Get()
+{
+    static FOptimizationRuleRegistry Registry;
+    return Registry;
+}
+
+void FOptimizationRuleRegistry::RegisterRule(const TSharedRef<IOptimizationRule>& Rule)
+{
+    check(IsInGameThread());
+
+    if (!Rule->GetAssetClass())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("OptimizationHelper: rule %s has no asset class, ignored"), *Rule->GetName().ToString());
+        return;
+    }
+
+    const int32 ExistingIndex = Rules.IndexOfByPredicate([&Rule](const TSharedRef<IOptimizationRule>& Existing)
+        {
+            return Existing->GetName() == Rule->GetName();
+        });
+
+    if (ExistingIndex != INDEX_NONE)
+    {
+        Rules[ExistingIndex] = Rule;
+    }
+    else
+    {
+        Rules.Add(Rule);
+    }
+}
+
+void FOptimizationRuleRegistry::UnregisterRule(FName RuleName)
+{
+    check(IsInGameThread());
+
+    Rules.RemoveAll([RuleName](const TSharedRef<IOptimizationRule>& Rule)
+        {
+            return Rule->GetName() == RuleName;
+        });
+}
+
+TArray<UClass*> FOptimizationRuleRegistry::GetAssetClasses() const
+{
+    TArray<UClass*> AssetClasses;
+    for (const TSharedRef<IOptimizationRule>& Rule : Rules)
+    {
+        AssetClasses.AddUnique(Rule->GetAssetClass());
+    }
+    return AssetClasses;
+}
+
+TArray<TSharedRef<IOptimizationRule>> FOptimizationRuleRegistry::GetRulesForClass(const UClass* AssetClass) const
+{
+    TArray<TSharedRef<IOptimizationRule>> ClassRules;
+    for (const TSharedRef<IOptimizationRule>& Rule : Rules)
+    {
+        if (Rule->GetAssetClass() == AssetClass)
+        {
+            ClassRules.Add(Rule);
+        }
+    }
+    return ClassRules;
+}
+
+uint32 FOptimizationRuleRegistry::GetRuleSetHash() const
+{
+    uint32 Hash = 0;
+    for (const TSharedRef<IOptimizationRule>& Rule : Rules)
+    {
+        Hash = HashCombine(Hash, GetTypeHash(Rule->GetName().ToString()));
+        Hash = HashCombine(Hash, GetTypeHash(Rule->GetVersion()));
+    }
+    return Hash;
+}
@@ -0,0 +1,119 @@
+#include "OptimizationScanProfile.h"
+#include "OptimizationAnalyzer.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+const FName FOptimizationScanProfile::RegistryQuery(TEXT("Registry query"));
+const FName FOptimizationScanProfile::ReadMetadata(TEXT("Read metadata"));
+const FName FOptimizationScanProfile::Load(TEXT("Load"));
+const FName FOptimizationScanProfile::ComputeMetrics(TEXT("Compute metrics"));
+const FName FOptimizationScanProfile::Evaluate(TEXT("Evaluate"));
+const FName FOptimizationScanProfile::Publish(TEXT("Publish"));
+const FName FOptimizationScanProfile::LevelActors(TEXT("Level actors"));
+const FName FOptimizationScanProfile::UIPopulation(TEXT("UI population"));
+
+FOptimizationProfileCounter& FOptimizationScanProfile::FindOrAddCounter(FName Name, EOptimizationProfileKind Kind)
+{
+    FScopeLock Lock(&CountersLock);
+
+    for (const TUniquePtr<FOptimizationProfileCounter>& Counter : Counters)
+    {
+        if (Counter->Name == Name && Counter->Kind == Kind)
+        {
+            return *Counter;
+        }
+    }
+
+    return *Counters.Add_GetRef(MakeUnique<FOptimizationProfileCounter>(Name, Kind));
+}
+
+void FOptimizationScanProfile::Reset()
+{
+    FScopeLock Lock(&CountersLock);
+
+    for (const TUniquePtr<FOptimizationProfileCounter>& Counter : Counters)
+    {
+        Counter->Cycles = 0;
+        Counter->Calls = 0;
+        Counter->Assets = 0;
+        Counter->BytesAllocated = 0;
+    }
+
+    StartTime = FPlatformTime::Seconds();
+    EndTime = 0.0;
+}
+
+void FOptimizationScanProfile::MarkFinished()
+{
+    EndTime = FPlatformTime::Seconds();
+}
+
+double FOptimizationScanProfile::GetWallSeconds() const
+{
+    if (StartTime == 0.0) return 0.0;
+    return (EndTime > 0.0 ? EndTime : FPlatformTime::Seconds()) - StartTime;
+}
+
+TArray<FOptimizationProfileEntry> FOptimizationScanProfile::GetEntries() const
+{
+    TArray<FOptimizationProfileEntry> Entries;
+
+    {
+        FScopeLock Lock(&CountersLock);
+
+        for (const TUniquePtr<FOptimizationProfileCounter>& Counter : Counters)
+        {
+            const int64 Calls = Counter->Calls.load(std::memory_order_relaxed);
+            if (Calls == 0) continue;
+
+            FOptimizationProfileEntry& Entry = Entries.AddDefaulted_GetRef();
+            Entry.Name = Counter->Name;
+            Entry.Kind = Counter->Kind;
+            Entry.Seconds = FPlatformTime::ToSeconds64(Counter->Cycles.load(std::memory_order_relaxed));
+            Entry.Calls = Calls;
+            Entry.Assets = Counter->Assets.load(std::memory_order_relaxed);
+            Entry.BytesAllocated = Counter->BytesAllocated.load(std::memory_order_relaxed);
+        }
+    }
+
+    Entries.Sort([](const FOptimizationProfileEntry& A, const FOptimizationProfileEntry& B)
+        {
+            return A.Seconds > B.Seconds;
+        });
+
+    return Entries;
+}
+
+bool FOptimizationScanProfile::SaveToCSV(const FString& FilePath) const
+{
+    FString CSVContent = FString::Printf(TEXT("# Scan wall time: %.3f s\n"), GetWallSeconds());
+    CSVContent += TEXT("Kind,Name,Time (ms),Calls,Assets,Assets/s,Bytes Allocated\n");
+
+    for (const FOptimizationProfileEntry& Entry : GetEntries())
+    {
+        CSVContent += FString::Printf(
+            TEXT("%s,%s,%.3f,%lld,%lld,%.1f,%lld\n"),
+            Entry.Kind == EOptimizationProfileKind::Rule ? TEXT("Rule") : TEXT("Phase"),
+            *Entry.Name.ToString().Replace(TEXT(","), TEXT(";")),
+            Entry.Seconds * 1000.0,
+            Entry.Calls,
+            Entry.Assets,
+            Entry.GetAssetsPerSecond(),
+            Entry.BytesAllocated
+        );
+    }
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+    return FFileHelper::SaveStringToFile(CSVContent, *FilePath);
+}
+
+int64 FOptimizationScanProfile::GetAllocatedSize(const FOptimizationIssue& Issue)
+{
+    return sizeof(FOptimizationIssue)
+        + Issue.Title.GetAllocatedSize()
+        + Issue.Description.GetAllocatedSize()
+        + Issue.AssetPath.GetAllocatedSize()
+        + Issue.SuggestedFix.GetAllocatedSize();
+}
@@ -0,0 +1,453 @@
+#include "OptimizationSceneStats.h"
+#include "Components/PrimitiveComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/Level.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "Misc/ITransaction.h"
+#include "Rendering/SkeletalMeshRenderData.h"
+#include "Rendering/SkeletalMeshLODRenderData.h"
+#include "StaticMeshResources.h"
+#include "UObject/UObjectGlobals.h"
+
+void FOptimizationSceneStats::AddComponent(const UPrimitiveComponent& PrimComp, bool bOwnerIsLandscape)
+{
+    const bool bVisible = PrimComp.IsVisible();
+    if (bVisible)
+    {
+        PrimitivesDrawn++;
+    }
+
+    if (const UStaticMeshComponent* MeshComp = Cast<UStaticMeshComponent>(&PrimComp))
+    {
+        const UStaticMesh* Mesh = MeshComp->GetStaticMesh();
+        if (bVisible && Mesh && Mesh->GetRenderData() && Mesh->GetRenderData()->LODResources.Num() > 0)
+        {
+            // Each section of LOD 0 is a draw call
+            const FStaticMeshLODResources& LOD = Mesh->GetRenderData()->LODResources[0];
+            DrawCalls += LOD.Sections.Num();
+            Triangles += LOD.GetNumTriangles();
+        }
+    }
+    else if (const USkeletalMeshComponent* SkelComp = Cast<USkeletalMeshComponent>(&PrimComp))
+    {
+        const USkeletalMesh* SkelMesh = SkelComp->GetSkeletalMeshAsset();
+        const FSkeletalMeshRenderData* RenderData = SkelMesh ? SkelMesh->GetResourceForRendering() : nullptr;
+        if (bVisible && RenderData && RenderData->LODRenderData.Num() > 0)
+        {
+            // Each section of LOD 0 is a draw call, as for static meshes
+            const FSkeletalMeshLODRenderData& LOD = RenderData->LODRenderData[0];
+            DrawCalls += LOD.RenderSections.Num();
+            for (const FSkelMeshRenderSection& Section : LOD.RenderSections)
+            {
+                Triangles += Section.NumTriangles;
+            }
+        }
+    }
+
+    if (bOwnerIsLandscape && bVisible)
+    {
+        // Landscape components store triangle count in SceneProxy
+        // Estimate based on component bounds and typical quad density
+        const FBoxSphereBounds& Bounds = PrimComp.Bounds;
+        const float Area = Bounds.BoxExtent.X * Bounds.BoxExtent.Y * 4.0f; // Approximate area
+
+        // Typical landscape: 1 quad per 100 units² = 2 triangles per 100 units²
+        const int32 EstimatedQuads = FMath::RoundToInt(Area / 100.0f);
+        Triangles += EstimatedQuads * 2; // Each quad = 2 triangles
+    }
+}
+
+bool FOptimizationSceneStats::IsLandscapeClass(const UClass* ActorClass, TMap<const UClass*, bool>& Cache)
+{
+    if (const bool* bCached = Cache.Find(ActorClass))
+    {
+        return *bCached;
+    }
+    return Cache.Add(ActorClass, ActorClass && ActorClass->GetName().Contains(TEXT("Landscape")));
+}
+
+FOptimizationSceneStatsCache::FOptimizationSceneStatsCache()
+{
+    RenderStateDirtyHandle = UActorComponent::MarkRenderStateDirtyEvent.AddRaw(this, &FOptimizationSceneStatsCache::OnRenderStateDirty);
+    PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FOptimizationSceneStatsCache::OnObjectPropertyChanged);
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FOptimizationSceneStatsCache::OnLevelAddedToWorld);
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FOptimizationSceneStatsCache::OnLevelRemovedFromWorld);
+
+    // Undo/redo and World Partition loads bring actors back without spawning them
+    ObjectTransactedHandle = FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &FOptimizationSceneStatsCache::OnObjectTransacted);
+    LoadedActorAddedHandle = ULevel::OnLoadedActorAddedToLevelEvent.AddRaw(this, &FOptimizationSceneStatsCache::OnLoadedActorAdded);
+    LoadedActorRemovedHandle = ULevel::OnLoadedActorRemovedFromLevelEvent.AddRaw(this, &FOptimizationSceneStatsCache::OnLoadedActorRemoved);
+}
+
+FOptimizationSceneStatsCache::~FOptimizationSceneStatsCache()
+{
+    UnbindWorld();
+
+    UActorComponent::MarkRenderStateDirtyEvent.Remove(RenderStateDirtyHandle);
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+    FCoreUObjectDelegates::OnObjectTransacted.Remove(ObjectTransactedHandle);
+    ULevel::OnLoadedActorAddedToLevelEvent.Remove(LoadedActorAddedHandle);
+    ULevel::OnLoadedActorRemovedFromLevelEvent.Remove(LoadedActorRemovedHandle);
+}
+
+const FOptimizationSceneStats& FOptimizationSceneStatsCache::GetStats(UWorld* World)
+{
+    check(IsInGameThread());
+
+    if (World != BoundWorld.Get())
+    {
+        BindWorld(World);
+    }
+
+    if (!World)
+    {
+        Totals = FOptimizationSceneStats();
+        return Totals;
+    }
+
+    if (bNeedsRebuild)
+    {
+        Rebuild();
+    }
+    else
+    {
+        ApplyPendingChanges();
+        AuditRows();
+    }
+
+    Totals.ActorCount = KnownActors.Num();
+    return Totals;
+}
+
+void FOptimizationSceneStatsCache::BindWorld(UWorld* World)
+{
+    UnbindWorld();
+
+    BoundWorld = World;
+    bNeedsRebuild = true;
+
+    if (World)
+    {
+        ActorSpawnedHandle = World->AddOnActorSpawnedHandler(
+            FOnActorSpawned::FDelegate::CreateRaw(this, &FOptimizationSceneStatsCache::OnActorSpawned));
+        ActorDestroyedHandle = World->AddOnActorDestroyedHandler(
+            FOnActorDestroyed::FDelegate::CreateRaw(this, &FOptimizationSceneStatsCache::OnActorDestroyed));
+    }
+}
+
+void FOptimizationSceneStatsCache::UnbindWorld()
+{
+    if (UWorld* World = BoundWorld.Get())
+    {
+        World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+        World->RemoveOnActorDestroyedHandler(ActorDestroyedHandle);
+    }
+
+    ActorSpawnedHandle.Reset();
+    ActorDestroyedHandle.Reset();
+    BoundWorld.Reset();
+}
+
+void FOptimizationSceneStatsCache::Rebuild()
+{
+    RowComponents.Reset();
+    RowOwners.Reset();
+    RowDrawCalls.Reset();
+    RowTriangles.Reset();
+    RowPrimitives.Reset();
+    FreeRows.Reset();
+    ComponentRows.Reset();
+    ActorRows.Reset();
+    KnownActors.Reset();
+    DirtyActors.Reset();
+    DirtyComponents.Reset();
+    Totals = FOptimizationSceneStats();
+    AuditCursor = 0;
+    bNeedsRebuild = false;
+
+    UWorld* World = BoundWorld.Get();
+    if (!World) return;
+
+    // The only full walk, everything after this is driven by events
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        UpdateActor(*It);
+    }
+}
+
+void FOptimizationSceneStatsCache::OnActorSpawned(AActor* Actor)
+{
+    DirtyActors.Add(Actor);
+}
+
+void FOptimizationSceneStatsCache::OnActorDestroyed(AActor* Actor)
+{
+    // Rows are dropped right away, the actor's components won't be valid later
+    RemoveActor(FObjectKey(Actor));
+    DirtyActors.Remove(Actor);
+}
+
+void FOptimizationSceneStatsCache::OnRenderStateDirty(UActorComponent& Component)
+{
+    // Fires for every component in every world (thumbnails, previews...), keep it cheap
+    UPrimitiveComponent* PrimComp = Cast<UPrimitiveComponent>(&Component);
+    if (PrimComp && !bNeedsRebuild && IsInBoundWorld(PrimComp))
+    {
+        DirtyComponents.Add(PrimComp);
+    }
+}
+
+void FOptimizationSceneStatsCache::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+    if (bNeedsRebuild || !Object || !IsInBoundWorld(Object)) return;
+
+    // Construction scripts may rerun and replace the actor's components
+    if (AActor* Actor = Cast<AActor>(Object))
+    {
+        DirtyActors.Add(Actor);
+    }
+    else if (UActorComponent* Component = Cast<UActorComponent>(Object))
+    {
+        if (AActor* Owner = Component->GetOwner())
+        {
+            DirtyActors.Add(Owner);
+        }
+    }
+}
+
+void FOptimizationSceneStatsCache::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+    if (!Level || World != BoundWorld.Get() || bNeedsRebuild) return;
+
+    for (AActor* Actor : Level->Actors)
+    {
+        if (Actor)
+        {
+            DirtyActors.Add(Actor);
+        }
+    }
+}
+
+void FOptimizationSceneStatsCache::OnLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+    // A null level means every level of the world went away
+    if (World != BoundWorld.Get() || !Level)
+    {
+        bNeedsRebuild = true;
+        return;
+    }
+
+    for (AActor* Actor : Level->Actors)
+    {
+        if (Actor)
+        {
+            RemoveActor(FObjectKey(Actor));
+            DirtyActors.Remove(Actor);
+        }
+    }
+}
+
+void FOptimizationSceneStatsCache::OnObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event)
+{
+    // One call per object of the undone transaction; an undone spawn leaves an invalid actor,
+    // which UpdateActor drops
+    if (bNeedsRebuild || Event.GetEventType() != ETransactionObjectEventType::UndoRedo || !Object || !IsInBoundWorld(Object)) return;
+
+    if (AActor* Actor = Cast<AActor>(Object))
+    {
+        DirtyActors.Add(Actor);
+    }
+    else if (UActorComponent* Component = Cast<UActorComponent>(Object))
+    {
+        if (AActor* Owner = Component->GetOwner())
+        {
+            DirtyActors.Add(Owner);
+        }
+    }
+}
+
+void FOptimizationSceneStatsCache::OnLoadedActorAdded(AActor& Actor)
+{
+    if (!bNeedsRebuild && IsInBoundWorld(&Actor))
+    {
+        DirtyActors.Add(&Actor);
+    }
+}
+
+void FOptimizationSceneStatsCache::OnLoadedActorRemoved(AActor& Actor)
+{
+    RemoveActor(FObjectKey(&Actor));
+    DirtyActors.Remove(&Actor);
+}
+
+void FOptimizationSceneStatsCache::ApplyPendingChanges()
+{
+    for (const TWeakObjectPtr<AActor>& Actor : DirtyActors)
+    {
+        if (AActor* ActorPtr = Actor.Get())
+        {
+            UpdateActor(ActorPtr);
+        }
+    }
+    DirtyActors.Reset();
+
+    for (const TWeakObjectPtr<UPrimitiveComponent>& Component : DirtyComponents)
+    {
+        if (UPrimitiveComponent* ComponentPtr = Component.Get())
+        {
+            UpdateComponent(ComponentPtr);
+        }
+    }
+    DirtyComponents.Reset();
+}
+
+void FOptimizationSceneStatsCache::AuditRows()
+{
+    // Components can be unregistered or garbage collected without an event we listen to
+    const int32 NumRows = RowComponents.Num();
+    for (int32 Step = 0; Step < AuditRowsPerUpdate && Step < NumRows; ++Step)
+    {
+        AuditCursor = (AuditCursor + 1) % NumRows;
+
+        const int32 Row = AuditCursor;
+        if (RowOwners[Row] == FObjectKey()) continue; // Free row
+
+        UPrimitiveComponent* Component = Cast<UPrimitiveComponent>(RowComponents[Row].ResolveObjectPtr());
+        if (!Component || !Component->IsRegistered() || FObjectKey(Component->GetOwner()) != RowOwners[Row])
+        {
+            const FObjectKey OwnerKey = RowOwners[Row];
+            FreeRow(Row);
+
+            // The owner's last row: a live owner is re-read, one that is gone stops counting
+            if (!ActorRows.Contains(OwnerKey))
+            {
+                KnownActors.Remove(OwnerKey);
+                if (AActor* Owner = Cast<AActor>(OwnerKey.ResolveObjectPtr()))
+                {
+                    DirtyActors.Add(Owner);
+                }
+            }
+        }
+    }
+}
+
+void FOptimizationSceneStatsCache::UpdateActor(AActor* Actor)
+{
+    const FObjectKey ActorKey(Actor);
+    RemoveActor(ActorKey);
+
+    if (!IsValid(Actor) || !IsInBoundWorld(Actor))
+    {
+        return;
+    }
+
+    KnownActors.Add(ActorKey);
+
+    Actor->ForEachComponent<UPrimitiveComponent>(false, [this](UPrimitiveComponent* PrimComp)
+        {
+            if (PrimComp && PrimComp->IsRegistered())
+            {
+                UpdateComponent(PrimComp);
+            }
+        });
+}
+
+void FOptimizationSceneStatsCache::RemoveActor(FObjectKey ActorKey)
+{
+    TArray<int32, TInlineAllocator<16>> Rows;
+    ActorRows.MultiFind(ActorKey, Rows);
+
+    for (int32 Row : Rows)
+    {
+        FreeRow(Row);
+    }
+
+    KnownActors.Remove(ActorKey);
+}
+
+void FOptimizationSceneStatsCache::UpdateComponent(UPrimitiveComponent* Component)
+{
+    AActor* Owner = Component->GetOwner();
+    const FObjectKey ComponentKey(Component);
+    int32* ExistingRow = ComponentRows.Find(ComponentKey);
+
+    if (!Owner || !Component->IsRegistered() || !IsValid(Component))
+    {
+        if (ExistingRow)
+        {
+            FreeRow(*ExistingRow);
+        }
+        return;
+    }
+
+    const int32 Row = ExistingRow ? *ExistingRow : AllocateRow(Component, FObjectKey(Owner));
+    KnownActors.Add(FObjectKey(Owner));
+
+    // Hidden actors contribute nothing but keep their rows, unhiding dirties the render state
+    FOptimizationSceneStats ComponentStats;
+    if (!Owner->IsHidden())
+    {
+        ComponentStats.AddComponent(*Component, FOptimizationSceneStats::IsLandscapeClass(Owner->GetClass(), LandscapeClasses));
+    }
+
+    SetRowStats(Row, ComponentStats);
+}
+
+int32 FOptimizationSceneStatsCache::AllocateRow(UPrimitiveComponent* Component, FObjectKey OwnerKey)
+{
+    int32 Row;
+    if (FreeRows.Num() > 0)
+    {
+        Row = FreeRows.Pop();
+        RowComponents[Row] = FObjectKey(Component);
+        RowOwners[Row] = OwnerKey;
+    }
+    else
+    {
+        Row = RowComponents.Add(FObjectKey(Component));
+        RowOwners.Add(OwnerKey);
+        RowDrawCalls.Add(0);
+        RowTriangles.Add(0);
+        RowPrimitives.Add(0);
+    }
+
+    ComponentRows.Add(FObjectKey(Component), Row);
+    ActorRows.Add(OwnerKey, Row);
+    return Row;
+}
+
+void FOptimizationSceneStatsCache::FreeRow(int32 Row)
+{
+    SetRowStats(Row, FOptimizationSceneStats());
+
+    ComponentRows.Remove(RowComponents[Row]);
+    ActorRows.RemoveSingle(RowOwners[Row], Row);
+
+    RowComponents[Row] = FObjectKey();
+    RowOwners[Row] = FObjectKey();
+    FreeRows.Add(Row);
+}
+
+void FOptimizationSceneStatsCache::SetRowStats(int32 Row, const FOptimizationSceneStats& Stats)
+{
+    Totals.DrawCalls += Stats.DrawCalls - RowDrawCalls[Row];
+    Totals.Triangles += Stats.Triangles - RowTriangles[Row];
+    Totals.PrimitivesDrawn += Stats.PrimitivesDrawn - RowPrimitives[Row];
+
+    RowDrawCalls[Row] = Stats.DrawCalls;
+    RowTriangles[Row] = Stats.Triangles;
+    RowPrimitives[Row] = (uint8)Stats.PrimitivesDrawn;
+}
+
+bool FOptimizationSceneStatsCache::IsInBoundWorld(const UObject* Object) const
+{
+    const UWorld* World = BoundWorld.Get();
+    return World && Object->GetWorld() == World;
+}
@@ -0,0 +1,68 @@
+#include "OptimizationShaderStats.h"
+#include "OptimizationAssetMetrics.h"
+#include "MaterialEditingLibrary.h"
+#include "Materials/Material.h"
+#include "MaterialShared.h"
+#include "ShaderCompiler.h"
+
+namespace
+{
+    const FMaterialResource* GetEditorResource(const UMaterial* Material)
+    {
+        return Material ? Material->GetMaterialResource(GMaxRHIFeatureLevel, EMaterialQualityLevel::High) : nullptr;
+    }
+}
+
+bool FOptimizationShaderStats::Read(const UMaterial* Material, FOptimizationMaterialMetrics& OutMetrics)
+{
+    const FMaterialResource* Resource = GetEditorResource(Material);
+    if (!Resource || !Resource->IsCompilationFinished() || !Resource->GetGameThreadShaderMap())
+    {
+        return false;
+    }
+
+    // Largest count of the representative shaders (base pass with and without lights, static
+    // and skeletal vertex factories), the same numbers the Stats panel lists
+    const FMaterialStatistics Stats = UMaterialEditingLibrary::GetStatistics(const_cast<UMaterial*>(Material));
+    if (Stats.NumPixelShaderInstructions <= 0 && Stats.NumVertexShaderInstructions <= 0)
+    {
+        return false;
+    }
+
+    OutMetrics.PixelShaderInstructions = Stats.NumPixelShaderInstructions;
+    OutMetrics.VertexShaderInstructions = Stats.NumVertexShaderInstructions;
+    OutMetrics.NumSamplers = Stats.NumSamplers;
+    OutMetrics.VirtualTextureLookups = Stats.NumVirtualTextureSamples;
+    OutMetrics.bHasShaderStats = true;
+    return true;
+}
+
+bool FOptimizationShaderStats::IsCompiling(const UMaterial* Material)
+{
+    const FMaterialResource* Resource = GetEditorResource(Material);
+    return Resource && !Resource->IsCompilationFinished();
+}
+
+void FOptimizationShaderStats::FinishCompilation(const TArray<const UMaterial*>& Materials)
+{
+    if (!GShaderCompilingManager)
+    {
+        return;
+    }
+
+    TArray<int32> ShaderMapIds;
+    for (const UMaterial* Material : Materials)
+    {
+        const FMaterialResource* Resource = GetEditorResource(Material);
+        if (Resource && !Resource->IsCompilationFinished())
+        {
+            ShaderMapIds.AddUnique(Resource->GetGameThreadCompilingShaderMapId());
+        }
+    }
+
+    if (ShaderMapIds.Num() > 0)
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE(OptimizationHelper_FinishShaderCompilation);
+        GShaderCompilingManager->FinishCompilation(TEXT("Optimization scan"), ShaderMapIds);
+    }
+}
@@ -0,0 +1,178 @@
+#include "OptimizationStatsSampler.h"
+#include "OptimizationRenderStats.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/App.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/ScopeLock.h"
+#include "RenderCore.h"
+
+FOptimizationStatsSampler& FOptimizationStatsSampler::Get()
+{
+    static FOptimizationStatsSampler Sampler;
+    return Sampler;
+}
+
+FOptimizationStatsSampler::FOptimizationStatsSampler()
+    : Queue(QueueCapacity)
+{
+}
+
+void FOptimizationStatsSampler::StartSampling()
+{
+    check(IsInGameThread());
+    if (IsSampling()) return;
+
+    bStopRequested = false;
+
+    if (FPlatformProcess::SupportsMultithreading())
+    {
+        WakeEvent = FPlatformProcess::GetSynchEventFromPool();
+        Thread = FRunnableThread::Create(this, TEXT("OptimizationStatsSampler"), 0, TPri_BelowNormal);
+    }
+
+    EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FOptimizationStatsSampler::OnEndFrame);
+}
+
+void FOptimizationStatsSampler::StopSampling()
+{
+    check(IsInGameThread());
+
+    FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+    EndFrameHandle.Reset();
+
+    if (Thread)
+    {
+        Thread->Kill(true);
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    if (WakeEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        WakeEvent = nullptr;
+    }
+
+    StopCapture();
+}
+
+void FOptimizationStatsSampler::OnEndFrame()
+{
+    // Only globals the engine already updated this frame, nothing here allocates or locks
+    FOptimizationFrameSample Sample;
+    Sample.EndTime = FPlatformTime::Seconds();
+    Sample.DeltaMS = (float)(FApp::GetDeltaTime() * 1000.0);
+    Sample.GameThreadMS = FPlatformTime::ToMilliseconds(GGameThreadTime);
+    Sample.RenderThreadMS = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+    Sample.RHIThreadMS = FPlatformTime::ToMilliseconds(GRHIThreadTime);
+
+    // Totals only: the per pass split converts every category name to a string
+    OptimizationRenderStats::ReadDrawCounters(Sample.DrawCalls, Sample.PrimitivesDrawn);
+
+    if (!Queue.Enqueue(Sample))
+    {
+        NumDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (WakeEvent)
+    {
+        WakeEvent->Trigger();
+    }
+    else
+    {
+        DrainQueue();
+    }
+}
+
+uint32 FOptimizationStatsSampler::Run()
+{
+    while (!bStopRequested)
+    {
+        WakeEvent->Wait(100);
+        DrainQueue();
+    }
+
+    DrainQueue();
+    return 0;
+}
+
+void FOptimizationStatsSampler::Stop()
+{
+    bStopRequested = true;
+
+    if (WakeEvent)
+    {
+        WakeEvent->Trigger();
+    }
+}
+
+void FOptimizationStatsSampler::DrainQueue()
+{
+    FScopeLock Lock(&CaptureLock);
+
+    FOptimizationFrameSample Sample;
+    while (Queue.Dequeue(Sample))
+    {
+        if (Sample.EndTime - LastMemoryTime >= MemoryRefreshSeconds)
+        {
+            UsedMemoryMB = FPlatformMemory::GetStats().UsedPhysical / (1024.0f * 1024.0f);
+            LastMemoryTime = Sample.EndTime;
+        }
+        Sample.UsedMemoryMB = UsedMemoryMB;
+
+        History.Push(Sample);
+
+        if (CaptureFile)
+        {
+            FString Line = FString::Printf(TEXT("%.6f,%.3f,%.3f,%.3f,%.3f,%d,%d,%.1f\n"),
+                Sample.EndTime, Sample.DeltaMS, Sample.GameThreadMS, Sample.RenderThreadMS, Sample.RHIThreadMS,
+                Sample.DrawCalls, Sample.PrimitivesDrawn, Sample.UsedMemoryMB);
+
+            FTCHARToUTF8 Utf8(*Line);
+            CaptureFile->Serialize((void*)Utf8.Get(), Utf8.Length());
+        }
+    }
+}
+
+bool FOptimizationStatsSampler::StartCapture(const FString& FilePath)
+{
+    TUniquePtr<FArchive> File(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!File)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Stats capture: cannot write %s"), *FilePath);
+        return false;
+    }
+
+    const char* Header = "Time,FrameMS,GameThreadMS,RenderThreadMS,RHIThreadMS,DrawCalls,Primitives,MemoryMB\n";
+    File->Serialize((void*)Header, FCStringAnsi::Strlen(Header));
+
+    FScopeLock Lock(&CaptureLock);
+    CaptureFile = MoveTemp(File);
+
+    UE_LOG(LogTemp, Log, TEXT("Stats capture started: %s"), *FilePath);
+    return true;
+}
+
+void FOptimizationStatsSampler::StopCapture()
+{
+    FScopeLock Lock(&CaptureLock);
+
+    if (CaptureFile)
+    {
+        CaptureFile->Close();
+        CaptureFile.Reset();
+
+        UE_LOG(LogTemp, Log, TEXT("Stats capture stopped"));
+    }
+}
+
+bool FOptimizationStatsSampler::IsCapturing() const
+{
+    FScopeLock Lock(&CaptureLock);
+    return CaptureFile.IsValid();
+}
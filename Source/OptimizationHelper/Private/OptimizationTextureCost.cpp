@@ -0,0 +1,115 @@
+#include "OptimizationTextureCost.h"
+#include "OptimizationAssetMetrics.h"
+#include "DeviceProfiles/DeviceProfile.h"
+#include "DeviceProfiles/DeviceProfileManager.h"
+#include "Engine/Texture2D.h"
+#include "Engine/TextureLODSettings.h"
+
+int64 FOptimizationTextureCost::CalcBytes(EPixelFormat Format, int32 SizeX, int32 SizeY, int32 NumSlices, int32 NumMips, int32 FirstMip)
+{
+    if (SizeX <= 0 || SizeY <= 0 || Format <= PF_Unknown || Format >= PF_MAX)
+    {
+        return 0;
+    }
+
+    const FPixelFormatInfo& Info = GPixelFormats[Format];
+    if (Info.BlockBytes <= 0)
+    {
+        return 0;
+    }
+
+    const int32 FullMips = GetFullMipCount(SizeX, SizeY);
+    const int32 LastMip = (NumMips > 0 ? FMath::Min(NumMips, FullMips) : FullMips) - 1;
+    FirstMip = FMath::Clamp(FirstMip, 0, LastMip);
+
+    int64 Bytes = 0;
+    for (int32 Mip = FirstMip; Mip <= LastMip; ++Mip)
+    {
+        const int32 MipSizeX = FMath::Max(SizeX >> Mip, 1);
+        const int32 MipSizeY = FMath::Max(SizeY >> Mip, 1);
+
+        // Block compressed formats round every mip up to whole blocks
+        const int64 BlocksX = FMath::DivideAndRoundUp(MipSizeX, Info.BlockSizeX);
+        const int64 BlocksY = FMath::DivideAndRoundUp(MipSizeY, Info.BlockSizeY);
+        Bytes += BlocksX * BlocksY * Info.BlockBytes;
+    }
+
+    return Bytes * FMath::Max(NumSlices, 1);
+}
+
+int64 FOptimizationTextureCost::CalcResidentBytes(const FOptimizationTextureMetrics& Metrics)
+{
+    return CalcBytes(Metrics.PixelFormat, Metrics.SizeX, Metrics.SizeY, Metrics.NumSlices, Metrics.NumMips, GetLODBias(Metrics));
+}
+
+int64 FOptimizationTextureCost::CalcResidentBytesAtMaxSize(const FOptimizationTextureMetrics& Metrics, int32 MaxDimension)
+{
+    int32 FirstMip = GetLODBias(Metrics);
+
+    const int32 MaxSize = FMath::Max(Metrics.SizeX, Metrics.SizeY);
+    while (MaxDimension > 0 && (MaxSize >> FirstMip) > MaxDimension)
+    {
+        ++FirstMip;
+    }
+
+    return CalcBytes(Metrics.PixelFormat, Metrics.SizeX, Metrics.SizeY, Metrics.NumSlices, Metrics.NumMips, FirstMip);
+}
+
+int64 FOptimizationTextureCost::CalcMinStreamedBytes(const FOptimizationTextureMetrics& Metrics)
+{
+    const int32 FullMips = GetFullMipCount(Metrics.SizeX, Metrics.SizeY);
+    const int32 MinResidentMips = UTexture2D::GetStaticMinTextureResidentMipCount();
+    const int32 FirstMip = FMath::Max(FullMips - MinResidentMips, GetLODBias(Metrics));
+
+    return CalcBytes(Metrics.PixelFormat, Metrics.SizeX, Metrics.SizeY, Metrics.NumSlices, 0, FirstMip);
+}
+
+int64 FOptimizationTextureCost::CalcStreamingSavings(const FOptimizationTextureMetrics& Metrics)
+{
+    return FMath::Max<int64>(CalcResidentBytes(Metrics) - CalcMinStreamedBytes(Metrics), 0);
+}
+
+int64 FOptimizationTextureCost::CalcVirtualTextureSavings(const FOptimizationTextureMetrics& Metrics)
+{
+    const int32 FirstMip = GetLODBias(Metrics);
+    return CalcBytes(Metrics.PixelFormat, Metrics.SizeX, Metrics.SizeY, Metrics.NumSlices, FirstMip + 1, FirstMip);
+}
+
+int32 FOptimizationTextureCost::GetLODBias(const FOptimizationTextureMetrics& Metrics)
+{
+    int32 Bias = FMath::Max(Metrics.LODBias, 0);
+
+    // Group bias and max size of the device profile the editor runs with
+    if (UDeviceProfile* Profile = UDeviceProfileManager::Get().GetActiveProfile())
+    {
+        if (const UTextureLODSettings* LODSettings = Profile->GetTextureLODSettings())
+        {
+            Bias = LODSettings->CalculateLODBias(Metrics.SizeX, Metrics.SizeY, 0, Metrics.LODGroup, Metrics.LODBias, 0,
+                TMGS_FromTextureGroup, false);
+        }
+    }
+
+    return FMath::Max(Bias, 0);
+}
+
+EPixelFormat FOptimizationTextureCost::FindPixelFormat(const FString& Name)
+{
+    for (int32 Format = PF_Unknown + 1; Format < PF_MAX; ++Format)
+    {
+        if (Name.Equals(GetPixelFormatName((EPixelFormat)Format), ESearchCase::IgnoreCase))
+        {
+            return (EPixelFormat)Format;
+        }
+    }
+    return PF_Unknown;
+}
+
+const TCHAR* FOptimizationTextureCost::GetPixelFormatName(EPixelFormat Format)
+{
+    return (Format > PF_Unknown && Format < PF_MAX) ? GPixelFormats[Format].Name : TEXT("PF_Unknown");
+}
+
+int32 FOptimizationTextureCost::GetFullMipCount(int32 SizeX, int32 SizeY)
+{
+    return FMath::FloorLog2(FMath::Max(FMath::Max(SizeX, SizeY), 1)) + 1;
+}
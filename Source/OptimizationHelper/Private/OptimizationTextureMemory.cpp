@@ -0,0 +1,373 @@
+#include "OptimizationTextureMemory.h"
+#include "Engine/Texture.h"
+#include "Engine/Texture2D.h"
+#include "Engine/Texture2DArray.h"
+#include "Engine/TextureCube.h"
+#include "Engine/TextureRenderTarget.h"
+#include "Engine/VolumeTexture.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/UObjectIterator.h"
+
+const TCHAR* FOptimizationTextureMemoryStats::GetKindName(EOptimizationTextureKind Kind)
+{
+    switch (Kind)
+    {
+    case EOptimizationTextureKind::Texture2D:       return TEXT("2D");
+    case EOptimizationTextureKind::Virtual:         return TEXT("Virtual");
+    case EOptimizationTextureKind::Cube:            return TEXT("Cube");
+    case EOptimizationTextureKind::Array:           return TEXT("2D Array");
+    case EOptimizationTextureKind::Volume:          return TEXT("Volume");
+    case EOptimizationTextureKind::RenderTarget:    return TEXT("Render Target");
+    default:                                        return TEXT("Other");
+    }
+}
+
+FOptimizationTextureMemoryTracker::FOptimizationTextureMemoryTracker()
+{
+    // Object indices never go past the capacity set at startup
+    NumTrackedWords = FMath::DivideAndRoundUp(GUObjectArray.GetObjectArrayCapacity(), 32);
+    TrackedBits = MakeUnique<std::atomic<uint32>[]>(NumTrackedWords);
+    for (int32 Word = 0; Word < NumTrackedWords; ++Word)
+    {
+        TrackedBits[Word].store(0, std::memory_order_relaxed);
+    }
+
+    GUObjectArray.AddUObjectCreateListener(this);
+    GUObjectArray.AddUObjectDeleteListener(this);
+    bListening = true;
+}
+
+FOptimizationTextureMemoryTracker::~FOptimizationTextureMemoryTracker()
+{
+    RemoveListeners();
+}
+
+void FOptimizationTextureMemoryTracker::RemoveListeners()
+{
+    if (bListening)
+    {
+        GUObjectArray.RemoveUObjectCreateListener(this);
+        GUObjectArray.RemoveUObjectDeleteListener(this);
+        bListening = false;
+    }
+}
+
+void FOptimizationTextureMemoryTracker::OnUObjectArrayShutdown()
+{
+    RemoveListeners();
+}
+
+void FOptimizationTextureMemoryTracker::NotifyUObjectCreated(const UObjectBase* Object, int32 Index)
+{
+    // Called for every object; the class check is all that runs for non-textures
+    const UClass* Class = Object->GetClass();
+    if (Class && Class->IsChildOf(UTexture::StaticClass()))
+    {
+        // Set here, so a delete that comes before the next update is seen too
+        SetTracked(Index, true);
+
+        FScopeLock Lock(&EventsLock);
+        PendingEvents.Add({ Index, true });
+    }
+}
+
+void FOptimizationTextureMemoryTracker::NotifyUObjectDeleted(const UObjectBase* Object, int32 Index)
+{
+    // May run on the GC purge thread; the object's class may already be gone, only the bit is checked
+    if (IsTracked(Index))
+    {
+        FScopeLock Lock(&EventsLock);
+        PendingEvents.Add({ Index, false });
+    }
+}
+
+const FOptimizationTextureMemoryStats& FOptimizationTextureMemoryTracker::GetStats()
+{
+    check(IsInGameThread());
+
+    if (bNeedsRebuild)
+    {
+        Rebuild();
+    }
+    else
+    {
+        ApplyPendingEvents();
+        UpdatePendingCreates();
+        UpdateVolatileRows();
+        AuditRows();
+    }
+
+    return Totals;
+}
+
+void FOptimizationTextureMemoryTracker::Rebuild()
+{
+    bNeedsRebuild = false;
+
+    // Events recorded so far are covered by the walk below
+    {
+        FScopeLock Lock(&EventsLock);
+        PendingEvents.Reset();
+    }
+
+    // The only full walk: textures already in memory, none is loaded for this
+    for (TObjectIterator<UTexture> It(RF_ClassDefaultObject | RF_ArchetypeObject); It; ++It)
+    {
+        UTexture* Texture = *It;
+        AddTexture(Texture, GUObjectArray.ObjectToIndex(Texture));
+    }
+}
+
+void FOptimizationTextureMemoryTracker::ApplyPendingEvents()
+{
+    TArray<FObjectEvent> Events;
+    {
+        FScopeLock Lock(&EventsLock);
+        Events = MoveTemp(PendingEvents);
+    }
+
+    // In order: an index can be freed and reused by another texture between two updates
+    for (const FObjectEvent& Event : Events)
+    {
+        RemoveObjectIndex(Event.ObjectIndex);
+
+        if (Event.bCreated)
+        {
+            PendingCreates.Add(Event.ObjectIndex);
+        }
+        else
+        {
+            PendingCreates.Remove(Event.ObjectIndex);
+        }
+    }
+
+    // Clear the bits of indices no texture holds anymore (a reused index keeps its bit)
+    for (const FObjectEvent& Event : Events)
+    {
+        if (!Event.bCreated && !PendingCreates.Contains(Event.ObjectIndex) && !ObjectIndexRows.Contains(Event.ObjectIndex))
+        {
+            SetTracked(Event.ObjectIndex, false);
+        }
+    }
+}
+
+void FOptimizationTextureMemoryTracker::UpdatePendingCreates()
+{
+    for (auto It = PendingCreates.CreateIterator(); It; ++It)
+    {
+        const FUObjectItem* Item = GUObjectArray.IndexToObject(*It);
+        UTexture* Texture = Item ? Cast<UTexture>(static_cast<UObject*>(Item->Object)) : nullptr;
+        if (!Texture || Texture->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+        {
+            SetTracked(*It, false);
+            It.RemoveCurrent();
+            continue;
+        }
+
+        // Still being loaded, its resource doesn't exist yet
+        if (Texture->HasAnyFlags(RF_NeedLoad | RF_NeedPostLoad) || Texture->HasAnyInternalFlags(EInternalObjectFlags::Async))
+        {
+            continue;
+        }
+
+        AddTexture(Texture, *It);
+        It.RemoveCurrent();
+    }
+}
+
+void FOptimizationTextureMemoryTracker::UpdateVolatileRows()
+{
+    // UpdateRow can remove the row from the set
+    TArray<int32, TInlineAllocator<64>> Rows(VolatileRows.Array());
+    for (int32 Row : Rows)
+    {
+        UpdateRow(Row);
+    }
+}
+
+void FOptimizationTextureMemoryTracker::AuditRows()
+{
+    const int32 NumRows = RowTextures.Num();
+    for (int32 Step = 0; Step < AuditRowsPerUpdate && Step < NumRows; ++Step)
+    {
+        AuditCursor = (AuditCursor + 1) % NumRows;
+        if (RowObjectIndices[AuditCursor] != INDEX_NONE)
+        {
+            UpdateRow(AuditCursor);
+        }
+    }
+}
+
+void FOptimizationTextureMemoryTracker::AddTexture(UTexture* Texture, int32 ObjectIndex)
+{
+    if (ObjectIndexRows.Contains(ObjectIndex))
+    {
+        UpdateRow(ObjectIndexRows[ObjectIndex]);
+        return;
+    }
+
+    int32 Row;
+    if (FreeRows.Num() > 0)
+    {
+        Row = FreeRows.Pop();
+        RowTextures[Row] = Texture;
+        RowObjectIndices[Row] = ObjectIndex;
+    }
+    else
+    {
+        Row = RowTextures.Add(Texture);
+        RowObjectIndices.Add(ObjectIndex);
+        RowMeasures.AddDefaulted();
+    }
+
+    ObjectIndexRows.Add(ObjectIndex, Row);
+    SetTracked(ObjectIndex, true);
+    SetRowMeasure(Row, Measure(Texture));
+}
+
+void FOptimizationTextureMemoryTracker::RemoveObjectIndex(int32 ObjectIndex)
+{
+    int32 Row = INDEX_NONE;
+    if (!ObjectIndexRows.RemoveAndCopyValue(ObjectIndex, Row))
+    {
+        return;
+    }
+
+    SetRowMeasure(Row, FMeasure());
+    VolatileRows.Remove(Row);
+
+    RowTextures[Row].Reset();
+    RowObjectIndices[Row] = INDEX_NONE;
+    FreeRows.Add(Row);
+}
+
+void FOptimizationTextureMemoryTracker::UpdateRow(int32 Row)
+{
+    UTexture* Texture = RowTextures[Row].Get();
+    if (!Texture)
+    {
+        // Gone without the delete event reaching us yet
+        RemoveObjectIndex(RowObjectIndices[Row]);
+        return;
+    }
+
+    SetRowMeasure(Row, Measure(Texture));
+}
+
+void FOptimizationTextureMemoryTracker::SetRowMeasure(int32 Row, const FMeasure& NewMeasure)
+{
+    FMeasure& OldMeasure = RowMeasures[Row];
+
+    if (OldMeasure.bHasResource)
+    {
+        if (OldMeasure.Kind != EOptimizationTextureKind::Virtual)
+        {
+            Totals.ResidentBytes -= OldMeasure.ResidentBytes;
+            Totals.WantedBytes -= OldMeasure.WantedBytes;
+        }
+        Totals.NumTextures--;
+        Totals.NumStreaming -= OldMeasure.ResidentBytes != OldMeasure.WantedBytes ? 1 : 0;
+        Totals.ResidentBytesByKind[(int32)OldMeasure.Kind] -= OldMeasure.ResidentBytes;
+        Totals.NumTexturesByKind[(int32)OldMeasure.Kind]--;
+    }
+
+    // Virtual textures live in the VT pools, counted per kind only
+    if (NewMeasure.bHasResource)
+    {
+        if (NewMeasure.Kind != EOptimizationTextureKind::Virtual)
+        {
+            Totals.ResidentBytes += NewMeasure.ResidentBytes;
+            Totals.WantedBytes += NewMeasure.WantedBytes;
+        }
+        Totals.NumTextures++;
+        Totals.NumStreaming += NewMeasure.ResidentBytes != NewMeasure.WantedBytes ? 1 : 0;
+        Totals.ResidentBytesByKind[(int32)NewMeasure.Kind] += NewMeasure.ResidentBytes;
+        Totals.NumTexturesByKind[(int32)NewMeasure.Kind]++;
+    }
+
+    if (NewMeasure.bVolatile)
+    {
+        VolatileRows.Add(Row);
+    }
+    else
+    {
+        VolatileRows.Remove(Row);
+    }
+
+    OldMeasure = NewMeasure;
+}
+
+FOptimizationTextureMemoryTracker::FMeasure FOptimizationTextureMemoryTracker::Measure(UTexture* Texture)
+{
+    FMeasure Result;
+    Result.Kind = GetKind(Texture);
+
+    // Textures without a resource take no GPU memory (editor-only, not yet created, or released)
+    if (!Texture->GetResource())
+    {
+        return Result;
+    }
+
+    Result.bHasResource = true;
+    Result.ResidentBytes = (int64)Texture->CalcTextureMemorySizeEnum(TMC_ResidentMips);
+    Result.WantedBytes = Result.ResidentBytes;
+
+    // Streamed 2D textures: the mips the streaming manager requested
+    UTexture2D* Texture2D = Cast<UTexture2D>(Texture);
+    if (Texture2D && Result.Kind == EOptimizationTextureKind::Texture2D && Texture2D->IsStreamable())
+    {
+        Result.WantedBytes = (int64)Texture2D->CalcTextureMemorySize(Texture2D->GetNumRequestedMips());
+    }
+
+    Result.bVolatile = Result.Kind == EOptimizationTextureKind::RenderTarget
+        || Result.ResidentBytes != Result.WantedBytes
+        || Texture->HasPendingInitOrStreaming();
+
+    return Result;
+}
+
+EOptimizationTextureKind FOptimizationTextureMemoryTracker::GetKind(const UTexture* Texture)
+{
+    if (Texture->IsA<UTextureRenderTarget>())
+    {
+        return EOptimizationTextureKind::RenderTarget;
+    }
+    if (Texture->IsA<UTextureCube>())
+    {
+        return EOptimizationTextureKind::Cube;
+    }
+    if (Texture->IsA<UTexture2DArray>())
+    {
+        return EOptimizationTextureKind::Array;
+    }
+    if (Texture->IsA<UVolumeTexture>())
+    {
+        return EOptimizationTextureKind::Volume;
+    }
+    if (const UTexture2D* Texture2D = Cast<UTexture2D>(Texture))
+    {
+        return Texture2D->IsCurrentlyVirtualTextured() ? EOptimizationTextureKind::Virtual : EOptimizationTextureKind::Texture2D;
+    }
+    return EOptimizationTextureKind::Other;
+}
+
+void FOptimizationTextureMemoryTracker::SetTracked(int32 ObjectIndex, bool bTracked)
+{
+    if (ObjectIndex < 0 || ObjectIndex / 32 >= NumTrackedWords) return;
+
+    const uint32 Mask = 1u << (ObjectIndex % 32);
+    if (bTracked)
+    {
+        TrackedBits[ObjectIndex / 32].fetch_or(Mask, std::memory_order_relaxed);
+    }
+    else
+    {
+        TrackedBits[ObjectIndex / 32].fetch_and(~Mask, std::memory_order_relaxed);
+    }
+}
+
+bool FOptimizationTextureMemoryTracker::IsTracked(int32 ObjectIndex) const
+{
+    if (ObjectIndex < 0 || ObjectIndex / 32 >= NumTrackedWords) return false;
+    return (TrackedBits[ObjectIndex / 32].load(std::memory_order_relaxed) & (1u << (ObjectIndex % 32))) != 0;
+}
@@ -1,14 +1,17 @@
 #include "OptimizationWindow.h"
 #include "PerformanceMonitorWidget.h" 
+#include "OptimizationAnalysisJob.h"
+#include "OptimizationScanProfile.h"
 #include "Widgets/Layout/SScrollBox.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/SBoxPanel.h"
 #include "Widgets/Input/SSpinBox.h"
+#include "Widgets/Input/SCheckBox.h"
+#include "Widgets/Layout/SExpandableArea.h"
 #include "Widgets/Notifications/SProgressBar.h"  // ← НОВОЕ!
 #include "Subsystems/AssetEditorSubsystem.h"
-#include "HAL/PlatformProcess.h"
 #include "HAL/PlatformFileManager.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
@@ -21,7 +24,7 @@
 
 void SOptimizationWindow::Construct(const FArguments& InArgs)
 {
-    Analyzer = NewObject<UOptimizationAnalyzer>();
+    Analyzer.Reset(NewObject<UOptimizationAnalyzer>());
     Analyzer->MaxBlueprintNodes = 200;
     Analyzer->MaxTextureSamplesPerMaterial = 8;
     CurrentFilter = EFilterType::All;
@@ -95,106 +98,149 @@ void SOptimizationWindow::Construct(const FArguments& InArgs)
                         ]
                 ]
         ];
+
+    ShowCachedResults();
 }
 
-FReply SOptimizationWindow::OnAnalyzeClicked()
+void SOptimizationWindow::ShowCachedResults()
 {
-    if (!Analyzer)
+    TArray<FOptimizationIssue> CachedIssues;
+    Analyzer->GetCachedIssues(CachedIssues);
+    if (CachedIssues.Num() == 0)
     {
-        StatusText->SetText(LOCTEXT("AnalyzerError", "Error: Analyzer not initialized"));
-        return FReply::Handled();
+        return;
     }
 
-    // Clear previous results
-    AllIssues.Empty();
-    Issues.Empty();
+    AddIssues(CachedIssues);
+    SortIssues();
+    ApplyFilter();
 
-    // Show progress widgets
-    if (ProgressBar.IsValid())
+    StatusText->SetText(FText::Format(
+        LOCTEXT("CachedResults", "Showing {0} issues from the last scan. Analyze Project re-checks only changed assets."),
+        FText::AsNumber(AllRows.Num())
+    ));
+}
+
+void SOptimizationWindow::SortIssues()
+{
+    // Sort by severity and impact (only the row order moves, the table stays as is)
+    AllRows.Sort([this](const FOptimizationIssueRow& A, const FOptimizationIssueRow& B)
+        {
+            const EOptimizationSeverity SeverityA = IssueTable.GetSeverity(A.Index);
+            const EOptimizationSeverity SeverityB = IssueTable.GetSeverity(B.Index);
+            if (SeverityA != SeverityB)
+            {
+                return SeverityA > SeverityB;
+            }
+            return IssueTable.GetImpact(A.Index) > IssueTable.GetImpact(B.Index);
+        });
+}
+
+void SOptimizationWindow::AddIssues(TArray<FOptimizationIssue>& NewIssues)
+{
+    for (const FOptimizationIssue& Issue : NewIssues)
     {
-        ProgressBar->SetVisibility(EVisibility::Visible);
-        ProgressBar->SetPercent(0.0f);  // ← ИСПРАВЛЕНО
+        const FOptimizationIssueRow Row { IssueTable.Add(Issue) };
+        AllRows.Add(Row);
+
+        if (PassesFilter(Row.Index))
+        {
+            FilteredRows.Add(Row);
+        }
     }
 
-    if (ProgressText.IsValid())
+    // The table keeps its own compact copy
+    NewIssues.Empty();
+}
+
+FReply SOptimizationWindow::OnAnalyzeClicked()
+{
+    if (!Analyzer)
     {
-        ProgressText->SetVisibility(EVisibility::Visible);
-        ProgressText->SetText(LOCTEXT("ProgressStarting", "Starting analysis... (0%)"));
+        StatusText->SetText(LOCTEXT("AnalyzerError", "Error: Analyzer not initialized"));
+        return FReply::Handled();
     }
 
     StatusText->SetText(LOCTEXT("Analyzing", "Analyzing project..."));
 
-    // Force UI update
-    FSlateApplication::Get().PumpMessages();
-    FSlateApplication::Get().Tick();
-    FPlatformProcess::Sleep(0.1f);
-
-    // Step 1: Analyze Meshes (0-40%)
-    UpdateProgress(LOCTEXT("ProgressMeshes", "Analyzing meshes..."), 0.1f);
-    FPlatformProcess::Sleep(0.1f);
+    // Runs in the background, results stream into the list as they arrive
+    StartAnalysisJob(FOptimizationAnalysisJob::StartProjectAnalysis(Analyzer.Get()), true);
 
-    TArray<FOptimizationIssue> MeshIssues = Analyzer->CheckMeshes();
-    UpdateProgress(LOCTEXT("ProgressMeshesDone", "Meshes analyzed"), 0.4f);
-    FPlatformProcess::Sleep(0.1f);
-
-    // Step 2: Analyze Textures (40-70%)
-    UpdateProgress(LOCTEXT("ProgressTextures", "Analyzing textures..."), 0.5f);
-    FPlatformProcess::Sleep(0.05f);
+    return FReply::Handled();
+}
 
-    TArray<FOptimizationIssue> TextureIssues = Analyzer->CheckTextures();
-    UpdateProgress(LOCTEXT("ProgressTexturesDone", "Textures analyzed"), 0.7f);
-    FPlatformProcess::Sleep(0.05f);
+void SOptimizationWindow::StartAnalysisJob(const TSharedRef<FOptimizationAnalysisJob>& Job, bool bInSortWhenFinished)
+{
+    // Clear previous results
+    IssueTable.Reset();
+    AllRows.Empty();
+    CurrentFilter = EFilterType::All;
+    ApplyFilter();
 
-    // Step 3: Analyze Materials (70-80%)
-    UpdateProgress(LOCTEXT("ProgressMaterials", "Analyzing materials..."), 0.75f);
-    FPlatformProcess::Sleep(0.05f);
+    ActiveJob = Job;
+    bSortWhenFinished = bInSortWhenFinished;
 
-    TArray<FOptimizationIssue> MaterialIssues = Analyzer->CheckMaterials();
-    UpdateProgress(LOCTEXT("ProgressMaterialsDone", "Materials analyzed"), 0.8f);
-    FPlatformProcess::Sleep(0.05f);
+    UpdateProgress(Job->GetCurrentTask(), 0.0f);
 
-    // Step 4: Analyze Blueprints (80-90%)
-    UpdateProgress(LOCTEXT("ProgressBlueprints", "Analyzing blueprints..."), 0.85f);
-    FPlatformProcess::Sleep(0.05f);
+    // Active timer keeps Slate ticking and repainting while the job runs
+    RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SOptimizationWindow::OnAnalysisTimer));
+}
 
-    TArray<FOptimizationIssue> BlueprintIssues = Analyzer->CheckBlueprints();
-    UpdateProgress(LOCTEXT("ProgressBlueprintsDone", "Blueprints analyzed"), 0.9f);
-    FPlatformProcess::Sleep(0.05f);
+EActiveTimerReturnType SOptimizationWindow::OnAnalysisTimer(double InCurrentTime, float InDeltaTime)
+{
+    if (!ActiveJob.IsValid())
+    {
+        return EActiveTimerReturnType::Stop;
+    }
 
-    // Step 5: Finalize (90-100%)
-    UpdateProgress(LOCTEXT("ProgressFinalizing", "Finalizing results..."), 0.95f);
-    FPlatformProcess::Sleep(0.05f);
+    // Stream partial results into the list
+    TArray<FOptimizationIssue> NewIssues;
+    ActiveJob->ConsumeNewIssues(NewIssues);
+    if (NewIssues.Num() > 0)
+    {
+        FOptimizationProfileCounter& UICounter = Analyzer->GetScanProfile().FindOrAddCounter(
+            FOptimizationScanProfile::UIPopulation, EOptimizationProfileKind::Phase);
+        OPTIMIZATION_PROFILE_SCOPE(UIScope, UICounter, NewIssues.Num());
 
-    // Combine all issues
-    TArray<FOptimizationIssue> AllIssuesArray;
-    AllIssuesArray.Append(MeshIssues);
-    AllIssuesArray.Append(TextureIssues);
-    AllIssuesArray.Append(MaterialIssues);
-    AllIssuesArray.Append(BlueprintIssues);
+        // Rows are appended, no need to filter everything again
+        AddIssues(NewIssues);
 
-    // Sort by severity and impact
-    AllIssuesArray.Sort([](const FOptimizationIssue& A, const FOptimizationIssue& B)
+        if (IssueListView.IsValid())
         {
-            if (A.Severity != B.Severity)
-            {
-                return A.Severity > B.Severity;
-            }
-            return A.EstimatedImpact > B.EstimatedImpact;
-        });
+            IssueListView->RequestListRefresh();
+        }
+        UpdateFilterStatus();
+    }
 
-    // Convert to shared pointers
-    for (const FOptimizationIssue& Issue : AllIssuesArray)
+    if (ActiveJob->IsFinished())
     {
-        AllIssues.Add(MakeShared<FOptimizationIssue>(Issue));
+        OnAnalysisFinished();
+        return EActiveTimerReturnType::Stop;
     }
 
-    // Apply current filter
-    CurrentFilter = EFilterType::All;
-    ApplyFilter();
+    UpdateProgress(ActiveJob->GetCurrentTask(), ActiveJob->GetProgress());
+    return EActiveTimerReturnType::Continue;
+}
 
-    // Complete
-    UpdateProgress(LOCTEXT("ProgressComplete", "Analysis complete!"), 1.0f);
-    FPlatformProcess::Sleep(0.3f);  // Show 100% for a moment
+void SOptimizationWindow::OnAnalysisFinished()
+{
+    const bool bCancelled = ActiveJob->WasCancelled();
+    ActiveJob.Reset();
+
+    {
+        FOptimizationProfileCounter& UICounter = Analyzer->GetScanProfile().FindOrAddCounter(
+            FOptimizationScanProfile::UIPopulation, EOptimizationProfileKind::Phase);
+        OPTIMIZATION_PROFILE_SCOPE(UIScope, UICounter, 0);
+
+        if (bSortWhenFinished)
+        {
+            SortIssues();
+        }
+
+        ApplyFilter();
+    }
+
+    RefreshScanProfile();
 
     // Hide progress bar
     if (ProgressBar.IsValid())
@@ -208,19 +254,39 @@ FReply SOptimizationWindow::OnAnalyzeClicked()
 
     // Update status
     FText StatusMessage = FText::Format(
-        LOCTEXT("AnalysisComplete", "Analysis complete! Found {0} issues."),
-        FText::AsNumber(AllIssues.Num())
+        bCancelled
+            ? LOCTEXT("AnalysisCancelled", "Analysis cancelled. Showing {0} partial issues.")
+            : LOCTEXT("AnalysisComplete", "Analysis complete! Found {0} issues."),
+        FText::AsNumber(AllRows.Num())
     );
     StatusText->SetText(StatusMessage);
 
-    UE_LOG(LogTemp, Warning, TEXT("OptimizationHelper: Found %d issues"), AllIssues.Num());
+    UE_LOG(LogTemp, Warning, TEXT("OptimizationHelper: Found %d issues%s (issue table: %.1f MB)"), AllRows.Num(),
+        bCancelled ? TEXT(" (cancelled)") : TEXT(""), IssueTable.GetAllocatedSize() / (1024.0 * 1024.0));
+}
 
+FReply SOptimizationWindow::OnCancelClicked()
+{
+    if (ActiveJob.IsValid())
+    {
+        ActiveJob->Cancel();
+    }
     return FReply::Handled();
 }
 
+bool SOptimizationWindow::IsAnalysisRunning() const
+{
+    return ActiveJob.IsValid();
+}
+
+bool SOptimizationWindow::CanStartAnalysis() const
+{
+    return !IsAnalysisRunning();
+}
+
 FReply SOptimizationWindow::OnExportClicked()
 {
-    if (Issues.Num() == 0)
+    if (FilteredRows.Num() == 0)
     {
         StatusText->SetText(LOCTEXT("NoIssues", "No issues to export. Run analysis first."));
         return FReply::Handled();
@@ -242,6 +308,10 @@ FReply SOptimizationWindow::OnExportClicked()
 
     ExportToCSV(SavePath);
 
+    // Profile of the scan that produced the report, next to it
+    const FString ProfilePath = FPaths::GetPath(SavePath) / FPaths::GetBaseFilename(SavePath) + TEXT("_Profile.csv");
+    Analyzer->GetScanProfile().SaveToCSV(ProfilePath);
+
     FText Message = FText::Format(
         LOCTEXT("ExportSuccess", "Report exported to: {0}"),
         FText::FromString(SavePath)
@@ -258,13 +328,15 @@ void SOptimizationWindow::ExportToCSV(const FString& FilePath)
     FString CSVContent;
 
     // Header
-    CSVContent += TEXT("Severity,Title,Description,Impact (%),Asset Path,Suggested Fix\n");
+    CSVContent += TEXT("Severity,Title,Description,Impact (%),Savings (MB),Asset Path,Suggested Fix\n");
 
-    // Data rows
-    for (const TSharedPtr<FOptimizationIssue>& Issue : Issues)
+    // Data rows (text is formatted here, row by row)
+    for (const FOptimizationIssueRow& Row : FilteredRows)
     {
+        const FOptimizationIssue Issue = IssueTable.GetIssue(Row.Index);
+
         FString SeverityStr;
-        switch (Issue->Severity)
+        switch (Issue.Severity)
         {
         case EOptimizationSeverity::Critical: SeverityStr = TEXT("Critical"); break;
         case EOptimizationSeverity::Warning: SeverityStr = TEXT("Warning"); break;
@@ -272,17 +344,18 @@ void SOptimizationWindow::ExportToCSV(const FString& FilePath)
         }
 
         // Escape commas in text
-        FString Title = Issue->Title.Replace(TEXT(","), TEXT(";"));
-        FString Description = Issue->Description.Replace(TEXT(","), TEXT(";"));
-        FString SuggestedFix = Issue->SuggestedFix.Replace(TEXT(","), TEXT(";"));
-        FString AssetPath = Issue->AssetPath.Replace(TEXT(","), TEXT(";"));
+        FString Title = Issue.Title.Replace(TEXT(","), TEXT(";"));
+        FString Description = Issue.Description.Replace(TEXT(","), TEXT(";"));
+        FString SuggestedFix = Issue.SuggestedFix.Replace(TEXT(","), TEXT(";"));
+        FString AssetPath = Issue.AssetPath.Replace(TEXT(","), TEXT(";"));
 
         CSVContent += FString::Printf(
-            TEXT("%s,%s,%s,%.1f,%s,%s\n"),
+            TEXT("%s,%s,%s,%.1f,%.1f,%s,%s\n"),
             *SeverityStr,
             *Title,
             *Description,
-            Issue->EstimatedImpact,
+            Issue.EstimatedImpact,
+            Issue.EstimatedSavingsMB,
             *AssetPath,
             *SuggestedFix
         );
@@ -292,93 +365,145 @@ void SOptimizationWindow::ExportToCSV(const FString& FilePath)
     FFileHelper::SaveStringToFile(CSVContent, *FilePath);
 }
 
-FReply SOptimizationWindow::OnAnalyzeCurrentLevelClicked()
+void SOptimizationWindow::RefreshScanProfile()
 {
-    if (!Analyzer)
+    const FOptimizationScanProfile& Profile = Analyzer->GetScanProfile();
+
+    ProfileEntries.Reset();
+    for (const FOptimizationProfileEntry& Entry : Profile.GetEntries())
     {
-        StatusText->SetText(LOCTEXT("AnalyzerError", "Error: Analyzer not initialized"));
-        return FReply::Handled();
+        ProfileEntries.Add(MakeShared<FOptimizationProfileEntry>(Entry));
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("=== Starting Current Level Analysis ==="));
-
-    // Clear previous results
-    AllIssues.Empty();
-    Issues.Empty();
-
-    // Show progress bar - ВАЖНО: сначала показать виджеты
-    if (ProgressBar.IsValid())
+    if (ProfileListView.IsValid())
     {
-        ProgressBar->SetVisibility(EVisibility::Visible);
-        ProgressBar->SetPercent(0.0f);
+        ProfileListView->RequestListRefresh();
     }
 
-    if (ProgressText.IsValid())
+    if (ProfileSummaryText.IsValid())
     {
-        ProgressText->SetVisibility(EVisibility::Visible);
-        ProgressText->SetText(LOCTEXT("ProgressStartingLevel", "Starting level analysis... (0%)"));
+        FNumberFormattingOptions SecondsFormat;
+        SecondsFormat.SetMaximumFractionalDigits(2);
+
+        ProfileSummaryText->SetText(FText::Format(
+            LOCTEXT("ProfileSummary", "Last scan: {0} s wall time. Rule times are summed over worker threads."),
+            FText::AsNumber(Profile.GetWallSeconds(), &SecondsFormat)
+        ));
     }
+}
 
-    StatusText->SetText(LOCTEXT("AnalyzingLevel", "Analyzing current level..."));
+TSharedRef<ITableRow> SOptimizationWindow::OnGenerateProfileRow(
+    TSharedPtr<FOptimizationProfileEntry> Entry,
+    const TSharedRef<STableViewBase>& OwnerTable)
+{
+    const bool bRule = Entry->Kind == EOptimizationProfileKind::Rule;
 
-    // Force UI update ПЕРЕД началом анализа
-    FSlateApplication::Get().PumpMessages();
-    FSlateApplication::Get().Tick();
-    FPlatformProcess::Sleep(0.15f);  // Увеличил задержку
+    auto MakeCell = [](const FString& Text, float Width)
+        {
+            return SNew(SBox)
+                .WidthOverride(Width)
+                [
+                    SNew(STextBlock)
+                        .Text(FText::FromString(Text))
+                ];
+        };
 
-    // Step 1: Initialize (0-20%)
-    UpdateProgress(LOCTEXT("ProgressLevelInit", "Initializing level scan..."), 0.1f);
-    FPlatformProcess::Sleep(0.2f);
+    return SNew(STableRow<TSharedPtr<FOptimizationProfileEntry>>, OwnerTable)
+        .Padding(2.0f)
+        [
+            SNew(SHorizontalBox)
 
-    UpdateProgress(LOCTEXT("ProgressLevelScan", "Scanning level actors..."), 0.2f);
-    FPlatformProcess::Sleep(0.2f);
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                [
+                    SNew(SBox)
+                        .WidthOverride(260.0f)
+                        [
+                            SNew(STextBlock)
+                                .Text(FText::FromString(FString::Printf(TEXT("%s %s"), bRule ? TEXT("Rule:") : TEXT("Phase:"), *Entry->Name.ToString())))
+                                .ColorAndOpacity(bRule ? FLinearColor(0.6f, 0.8f, 1.0f) : FLinearColor::White)
+                        ]
+                ]
 
-    // Step 2: Analyze (20-80%)
-    UpdateProgress(LOCTEXT("ProgressLevelAnalyzing", "Analyzing meshes and textures..."), 0.4f);
-    FPlatformProcess::Sleep(0.2f);
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                [
+                    MakeCell(FString::Printf(TEXT("%.1f ms"), Entry->Seconds * 1000.0), 110.0f)
+                ]
 
-    // ОСНОВНОЙ АНАЛИЗ
-    TArray<FOptimizationIssue> LevelIssues = Analyzer->AnalyzeCurrentLevel();
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                [
+                    MakeCell(FString::Printf(TEXT("%lld calls"), Entry->Calls), 110.0f)
+                ]
 
-    UpdateProgress(LOCTEXT("ProgressLevelProcessing", "Processing results..."), 0.8f);
-    FPlatformProcess::Sleep(0.2f);
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                [
+                    MakeCell(FString::Printf(TEXT("%.0f assets/s"), Entry->GetAssetsPerSecond()), 130.0f)
+                ]
 
-    // Step 3: Finalize (80-100%)
-    UpdateProgress(LOCTEXT("ProgressLevelFinalizing", "Finalizing..."), 0.9f);
-    FPlatformProcess::Sleep(0.2f);
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                [
+                    MakeCell(FString::Printf(TEXT("%.1f KB"), Entry->BytesAllocated / 1024.0), 110.0f)
+                ]
+        ];
+}
 
-    // Convert to shared pointers
-    for (const FOptimizationIssue& Issue : LevelIssues)
-    {
-        AllIssues.Add(MakeShared<FOptimizationIssue>(Issue));
-    }
+TSharedRef<SWidget> SOptimizationWindow::CreateScanProfilePanel()
+{
+    TSharedRef<SWidget> Panel = SNew(SExpandableArea)
+        .InitiallyCollapsed(true)
+        .AreaTitle(LOCTEXT("ScanProfileTitle", "Scan Profile"))
+        .BodyContent()
+        [
+            SNew(SVerticalBox)
 
-    // Apply filter
-    CurrentFilter = EFilterType::All;
-    ApplyFilter();
+                + SVerticalBox::Slot()
+                .AutoHeight()
+                .Padding(0.0f, 2.0f)
+                [
+                    SAssignNew(ProfileSummaryText, STextBlock)
+                        .Text(LOCTEXT("ProfileEmpty", "Run an analysis to see where the scan spends its time."))
+                        .ColorAndOpacity(FLinearColor(0.6f, 0.6f, 0.6f))
+                ]
 
-    // Complete
-    UpdateProgress(LOCTEXT("ProgressLevelComplete", "Level analysis complete!"), 1.0f);
-    FPlatformProcess::Sleep(0.5f);  // Показать 100% подольше
+                + SVerticalBox::Slot()
+                .AutoHeight()
+                [
+                    SNew(SBox)
+                        .MaxDesiredHeight(200.0f)
+                        [
+                            SAssignNew(ProfileListView, SListView<TSharedPtr<FOptimizationProfileEntry>>)
+                                .ListItemsSource(&ProfileEntries)
+                                .OnGenerateRow(this, &SOptimizationWindow::OnGenerateProfileRow)
+                        ]
+                ]
+        ];
 
-    // Hide progress bar
-    if (ProgressBar.IsValid())
+    // The tab is rebuilt when switching back to it
+    if (ProfileEntries.Num() > 0)
     {
-        ProgressBar->SetVisibility(EVisibility::Collapsed);
+        RefreshScanProfile();
     }
-    if (ProgressText.IsValid())
+
+    return Panel;
+}
+
+FReply SOptimizationWindow::OnAnalyzeCurrentLevelClicked()
+{
+    if (!Analyzer)
     {
-        ProgressText->SetVisibility(EVisibility::Collapsed);
+        StatusText->SetText(LOCTEXT("AnalyzerError", "Error: Analyzer not initialized"));
+        return FReply::Handled();
     }
 
-    // Update status
-    FText StatusMessage = FText::Format(
-        LOCTEXT("LevelAnalysisComplete", "Level analysis complete! Found {0} issues."),
-        FText::AsNumber(AllIssues.Num())
-    );
-    StatusText->SetText(StatusMessage);
+    UE_LOG(LogTemp, Warning, TEXT("=== Starting Current Level Analysis ==="));
+
+    StatusText->SetText(LOCTEXT("AnalyzingLevel", "Analyzing current level..."));
 
-    UE_LOG(LogTemp, Warning, TEXT("=== Level Analysis Complete: %d issues found ==="), AllIssues.Num());
+    StartAnalysisJob(FOptimizationAnalysisJob::StartLevelAnalysis(Analyzer.Get()), false);
 
     return FReply::Handled();
 }
@@ -420,6 +545,20 @@ void SOptimizationWindow::OnMaxTextureSamplesChanged(float NewValue)
     }
 }
 
+void SOptimizationWindow::OnMetadataOnlyScanChanged(ECheckBoxState NewState)
+{
+    if (Analyzer)
+    {
+        Analyzer->bMetadataOnlyScan = (NewState == ECheckBoxState::Checked);
+        UE_LOG(LogTemp, Log, TEXT("Metadata-only scan: %s"), Analyzer->bMetadataOnlyScan ? TEXT("enabled") : TEXT("disabled"));
+    }
+}
+
+ECheckBoxState SOptimizationWindow::IsMetadataOnlyScanChecked() const
+{
+    return (Analyzer && Analyzer->bMetadataOnlyScan) ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+}
+
 FReply SOptimizationWindow::OnFilterAll()
 {
     CurrentFilter = EFilterType::All;
@@ -478,112 +617,63 @@ FReply SOptimizationWindow::OnFilterMaterials()
 
 void SOptimizationWindow::ApplyFilter()
 {
-    FilteredIssues.Empty();
+    FilteredRows.Reset();
 
-    switch (CurrentFilter)
+    for (const FOptimizationIssueRow& Row : AllRows)
     {
-    case EFilterType::All:
-        FilteredIssues = AllIssues;
-        break;
-
-    case EFilterType::Critical:
-        for (const auto& Issue : AllIssues)
+        if (PassesFilter(Row.Index))
         {
-            if (Issue->Severity == EOptimizationSeverity::Critical)
-            {
-                FilteredIssues.Add(Issue);
-            }
-        }
-        break;
-
-    case EFilterType::Warning:
-        for (const auto& Issue : AllIssues)
-        {
-            if (Issue->Severity == EOptimizationSeverity::Warning)
-            {
-                FilteredIssues.Add(Issue);
-            }
+            FilteredRows.Add(Row);
         }
-        break;
-
-    case EFilterType::Info:
-        for (const auto& Issue : AllIssues)
-        {
-            if (Issue->Severity == EOptimizationSeverity::Info)
-            {
-                FilteredIssues.Add(Issue);
-            }
-        }
-        break;
-
-    case EFilterType::Meshes:
-        for (const auto& Issue : AllIssues)
-        {
-            if (Issue->Category == EOptimizationCategory::Mesh)
-            {
-                FilteredIssues.Add(Issue);
-            }
-        }
-        break;
-
-    case EFilterType::Textures:
-        for (const auto& Issue : AllIssues)
-        {
-            if (Issue->Category == EOptimizationCategory::Texture)
-            {
-                FilteredIssues.Add(Issue);
-            }
-        }
-        break;
-
-    case EFilterType::Blueprints:
-        for (const auto& Issue : AllIssues)
-        {
-            if (Issue->Category == EOptimizationCategory::Blueprint)
-            {
-                FilteredIssues.Add(Issue);
-            }
-        }
-        break;
-
-    case EFilterType::Materials:
-        for (const auto& Issue : AllIssues)
-        {
-            if (Issue->Category == EOptimizationCategory::Material)
-            {
-                FilteredIssues.Add(Issue);
-            }
-        }
-        break;
     }
 
-    // Update list view to use filtered issues
-    Issues = FilteredIssues;
-
     if (IssueListView.IsValid())
     {
         IssueListView->RequestListRefresh();
     }
 
+    UpdateFilterStatus();
+
+    UE_LOG(LogTemp, Log, TEXT("Filter applied: %d/%d issues shown"), FilteredRows.Num(), AllRows.Num());
+}
+
+bool SOptimizationWindow::PassesFilter(int32 Row) const
+{
+    switch (CurrentFilter)
+    {
+    case EFilterType::Critical:   return IssueTable.GetSeverity(Row) == EOptimizationSeverity::Critical;
+    case EFilterType::Warning:    return IssueTable.GetSeverity(Row) == EOptimizationSeverity::Warning;
+    case EFilterType::Info:       return IssueTable.GetSeverity(Row) == EOptimizationSeverity::Info;
+    case EFilterType::Meshes:     return IssueTable.GetCategory(Row) == EOptimizationCategory::Mesh;
+    case EFilterType::Textures:   return IssueTable.GetCategory(Row) == EOptimizationCategory::Texture;
+    case EFilterType::Blueprints: return IssueTable.GetCategory(Row) == EOptimizationCategory::Blueprint;
+    case EFilterType::Materials:  return IssueTable.GetCategory(Row) == EOptimizationCategory::Material;
+    default:                      return true;
+    }
+}
+
+void SOptimizationWindow::UpdateFilterStatus()
+{
     // Update status
     FText FilterMessage = FText::Format(
         LOCTEXT("FilterApplied", "Showing {0} of {1} issues"),
-        FText::AsNumber(FilteredIssues.Num()),
-        FText::AsNumber(AllIssues.Num())
+        FText::AsNumber(FilteredRows.Num()),
+        FText::AsNumber(AllRows.Num())
     );
     StatusText->SetText(FilterMessage);
-
-    UE_LOG(LogTemp, Log, TEXT("Filter applied: %d/%d issues shown"), FilteredIssues.Num(), AllIssues.Num());
 }
 
 TSharedRef<ITableRow> SOptimizationWindow::OnGenerateIssueRow(
-    TSharedPtr<FOptimizationIssue> Issue,
+    FOptimizationIssueRow Row,
     const TSharedRef<STableViewBase>& OwnerTable)
 {
+    // Only visible rows get here, so this is the only place their text is built
+    const FOptimizationIssue Issue = IssueTable.GetIssue(Row.Index);
+
     FLinearColor SeverityColor = FLinearColor::White;
     FString SeverityText;
 
-    switch (Issue->Severity)
+    switch (Issue.Severity)
     {
     case EOptimizationSeverity::Critical:
         SeverityColor = FLinearColor::Red;
@@ -599,19 +689,21 @@ TSharedRef<ITableRow> SOptimizationWindow::OnGenerateIssueRow(
         break;
     }
 
-    return SNew(STableRow<TSharedPtr<FOptimizationIssue>>, OwnerTable)
+    const FString AssetPath = Issue.AssetPath;
+
+    return SNew(STableRow<FOptimizationIssueRow>, OwnerTable)
         .Padding(5.0f)
         [
             SNew(SButton)
                 .ButtonStyle(FAppStyle::Get(), "SimpleButton")
-                .OnClicked_Lambda([Issue]() -> FReply
+                .OnClicked_Lambda([AssetPath]() -> FReply
                     {
                         // Open asset on click
-                        if (!Issue->AssetPath.IsEmpty())
+                        if (!AssetPath.IsEmpty())
                         {
                             // Find asset in Asset Registry
                             FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-                            FAssetData AssetData = AssetRegistryModule.Get().GetAssetByObjectPath(FSoftObjectPath(Issue->AssetPath));
+                            FAssetData AssetData = AssetRegistryModule.Get().GetAssetByObjectPath(FSoftObjectPath(AssetPath));
 
                             if (AssetData.IsValid())
                             {
@@ -622,7 +714,7 @@ TSharedRef<ITableRow> SOptimizationWindow::OnGenerateIssueRow(
                                 FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
                                 ContentBrowserModule.Get().SyncBrowserToAssets(AssetsToSync);
 
-                                UE_LOG(LogTemp, Log, TEXT("Highlighted asset in Content Browser: %s"), *Issue->AssetPath);
+                                UE_LOG(LogTemp, Log, TEXT("Highlighted asset in Content Browser: %s"), *AssetPath);
                             }
                         }
                         return FReply::Handled();
@@ -661,7 +753,7 @@ TSharedRef<ITableRow> SOptimizationWindow::OnGenerateIssueRow(
                                         .AutoHeight()
                                         [
                                             SNew(STextBlock)
-                                                .Text(FText::FromString(Issue->Title))
+                                                .Text(FText::FromString(Issue.Title))
                                                 .Font(FCoreStyle::GetDefaultFontStyle("Bold", 11))
                                         ]
 
@@ -671,7 +763,7 @@ TSharedRef<ITableRow> SOptimizationWindow::OnGenerateIssueRow(
                                         .Padding(0.0f, 2.0f)
                                         [
                                             SNew(STextBlock)
-                                                .Text(FText::FromString(Issue->Description))
+                                                .Text(FText::FromString(Issue.Description))
                                                 .AutoWrapText(true)
                                         ]
 
@@ -681,7 +773,7 @@ TSharedRef<ITableRow> SOptimizationWindow::OnGenerateIssueRow(
                                         .Padding(0.0f, 2.0f)
                                         [
                                             SNew(STextBlock)
-                                                .Text(FText::FromString(FString::Printf(TEXT("💡 Fix: %s"), *Issue->SuggestedFix)))
+                                                .Text(FText::FromString(FString::Printf(TEXT("💡 Fix: %s"), *Issue.SuggestedFix)))
                                                 .ColorAndOpacity(FLinearColor(0.6f, 0.8f, 1.0f))
                                                 .AutoWrapText(true)
                                         ]
@@ -692,7 +784,7 @@ TSharedRef<ITableRow> SOptimizationWindow::OnGenerateIssueRow(
                                         .Padding(0.0f, 2.0f)
                                         [
                                             SNew(STextBlock)
-                                                .Text(FText::FromString(FString::Printf(TEXT("📁 %s (Click to open)"), *Issue->AssetPath)))
+                                                .Text(FText::FromString(FString::Printf(TEXT("📁 %s (Click to open)"), *Issue.AssetPath)))
                                                 .ColorAndOpacity(FLinearColor(0.5f, 0.5f, 0.5f))
                                                 .Font(FCoreStyle::GetDefaultFontStyle("Regular", 8))
                                         ]
@@ -708,7 +800,7 @@ TSharedRef<ITableRow> SOptimizationWindow::OnGenerateIssueRow(
                                         .WidthOverride(80.0f)
                                         [
                                             SNew(STextBlock)
-                                                .Text(FText::FromString(FString::Printf(TEXT("Impact:\n%.0f%%"), Issue->EstimatedImpact)))
+                                                .Text(FText::FromString(FString::Printf(TEXT("Impact:\n%.0f%%"), Issue.EstimatedImpact)))
                                                 .Justification(ETextJustify::Center)
                                                 .Font(FCoreStyle::GetDefaultFontStyle("Bold", 10))
                                         ]
@@ -736,17 +828,6 @@ void SOptimizationWindow::UpdateProgress(const FText& CurrentTask, float Progres
         ProgressText->SetText(ProgressMessage);
         ProgressText->SetVisibility(EVisibility::Visible);
     }
-
-    if (StatusText.IsValid())
-    {
-        StatusText->SetText(CurrentTask);
-    }
-
-    // КРИТИЧНО: Принудительное обновление UI
-    FSlateApplication::Get().PumpMessages();
-    FSlateApplication::Get().Tick();  // ← Добавьте эту строку!
-
-    UE_LOG(LogTemp, Warning, TEXT("Progress updated: %.1f%% - %s"), Progress * 100, *CurrentTask.ToString());
 }
 
 FReply SOptimizationWindow::OnSwitchToAnalysisTab()
@@ -811,6 +892,8 @@ TSharedPtr<SWidget> SOptimizationWindow::CreateAnalysisTab()
                                 .Font(FCoreStyle::GetDefaultFontStyle("Bold", 12))
                         ]
 
+                        // Worker threads read the thresholds and the result cache stores issues under
+                        // their hash, so they are locked while a scan runs
                         // First row
                         + SVerticalBox::Slot()
                         .AutoHeight()
@@ -839,6 +922,7 @@ TSharedPtr<SWidget> SOptimizationWindow::CreateAnalysisTab()
                                                 .Value(100000.0f)
                                                 .Delta(10000.0f)
                                                 .OnValueChanged(this, &SOptimizationWindow::OnMaxTrianglesChanged)
+                                                .IsEnabled(this, &SOptimizationWindow::CanStartAnalysis)
                                         ]
                                 ]
 
@@ -863,6 +947,7 @@ TSharedPtr<SWidget> SOptimizationWindow::CreateAnalysisTab()
                                                 .Delta(512.0f)
                                                 .Value(2048.0f)
                                                 .OnValueChanged(this, &SOptimizationWindow::OnMaxTextureSizeChanged)
+                                                .IsEnabled(this, &SOptimizationWindow::CanStartAnalysis)
                                         ]
                                 ]
 
@@ -887,6 +972,7 @@ TSharedPtr<SWidget> SOptimizationWindow::CreateAnalysisTab()
                                                 .Delta(50.0f)
                                                 .Value(200.0f)
                                                 .OnValueChanged(this, &SOptimizationWindow::OnMaxBlueprintNodesChanged)
+                                                .IsEnabled(this, &SOptimizationWindow::CanStartAnalysis)
                                         ]
                                 ]
                         ]
@@ -919,18 +1005,29 @@ TSharedPtr<SWidget> SOptimizationWindow::CreateAnalysisTab()
                                                 .Delta(1.0f)
                                                 .Value(8.0f)
                                                 .OnValueChanged(this, &SOptimizationWindow::OnMaxTextureSamplesChanged)
+                                                .IsEnabled(this, &SOptimizationWindow::CanStartAnalysis)
                                         ]
                                 ]
 
-                            // Placeholders
+                            // Metadata-only scan
                             + SHorizontalBox::Slot()
                                 .FillWidth(1.0f)
                                 .Padding(5.0f, 0.0f)
+                                .VAlign(VAlign_Bottom)
                                 [
-                                    SNew(SBox)
+                                    SNew(SCheckBox)
+                                        .IsChecked(this, &SOptimizationWindow::IsMetadataOnlyScanChecked)
+                                        .OnCheckStateChanged(this, &SOptimizationWindow::OnMetadataOnlyScanChanged)
+                                        .IsEnabled(this, &SOptimizationWindow::CanStartAnalysis)
+                                        .ToolTipText(LOCTEXT("MetadataOnlyScanTooltip", "Read triangle counts, texture sizes, blend modes and node counts from asset registry tags instead of loading every asset. Assets without tags are still loaded."))
+                                        [
+                                            SNew(STextBlock)
+                                                .Text(LOCTEXT("MetadataOnlyScan", "Metadata-only scan (no asset loading)"))
+                                        ]
                                 ]
 
-                                + SHorizontalBox::Slot()
+                            // Placeholder
+                            + SHorizontalBox::Slot()
                                 .FillWidth(1.0f)
                                 .Padding(5.0f, 0.0f)
                                 [
@@ -1047,6 +1144,7 @@ TSharedPtr<SWidget> SOptimizationWindow::CreateAnalysisTab()
                     SNew(SButton)
                         .Text(LOCTEXT("AnalyzeCurrentLevelButton", "Analyze Current Level"))
                         .OnClicked(this, &SOptimizationWindow::OnAnalyzeCurrentLevelClicked)
+                        .IsEnabled(this, &SOptimizationWindow::CanStartAnalysis)
                         .HAlign(HAlign_Center)
                 ]
 
@@ -1057,6 +1155,18 @@ TSharedPtr<SWidget> SOptimizationWindow::CreateAnalysisTab()
                     SNew(SButton)
                         .Text(LOCTEXT("AnalyzeButton", "Analyze Project"))
                         .OnClicked(this, &SOptimizationWindow::OnAnalyzeClicked)
+                        .IsEnabled(this, &SOptimizationWindow::CanStartAnalysis)
+                        .HAlign(HAlign_Center)
+                ]
+
+                + SHorizontalBox::Slot()
+                .FillWidth(1.0f)
+                .Padding(5.0f, 0.0f)
+                [
+                    SNew(SButton)
+                        .Text(LOCTEXT("CancelButton", "Cancel"))
+                        .OnClicked(this, &SOptimizationWindow::OnCancelClicked)
+                        .IsEnabled(this, &SOptimizationWindow::IsAnalysisRunning)
                         .HAlign(HAlign_Center)
                 ]
 
@@ -1109,6 +1219,14 @@ TSharedPtr<SWidget> SOptimizationWindow::CreateAnalysisTab()
                 ]
         ]
 
+    // Scan profile
+    + SVerticalBox::Slot()
+        .AutoHeight()
+        .Padding(10.0f, 0.0f)
+        [
+            CreateScanProfilePanel()
+        ]
+
     // Issues list
     + SVerticalBox::Slot()
         .FillHeight(1.0f)
@@ -1117,8 +1235,8 @@ TSharedPtr<SWidget> SOptimizationWindow::CreateAnalysisTab()
             SNew(SScrollBox)
                 + SScrollBox::Slot()
                 [
-                    SAssignNew(IssueListView, SListView<TSharedPtr<FOptimizationIssue>>)
-                        .ListItemsSource(&Issues)
+                    SAssignNew(IssueListView, SListView<FOptimizationIssueRow>)
+                        .ListItemsSource(&FilteredRows)
                         .OnGenerateRow(this, &SOptimizationWindow::OnGenerateIssueRow)
                 ]
         ];
@@ -1130,7 +1248,7 @@ TSharedPtr<SWidget> SOptimizationWindow::CreatePerformanceTab()
         .Padding(10.0f)
         [
             SAssignNew(PerformanceMonitor, SPerformanceMonitorWidget)
-                .Analyzer(Analyzer)  // ← Передаём Analyzer
+                .Analyzer(Analyzer.Get())  // ← Передаём Analyzer
         ];
 }
 
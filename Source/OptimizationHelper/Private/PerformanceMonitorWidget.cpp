@@ -3,17 +3,24 @@
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/SBoxPanel.h"
 #include "Widgets/Layout/SBorder.h"
+#include "Widgets/Input/SButton.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
 #include "Engine/Engine.h"
 #include "RenderingThread.h"
 #include "HAL/PlatformMemory.h"
 #include "Styling/CoreStyle.h"
 #include "OptimizationAnalyzer.h"
+#include "OptimizationFrameGraph.h"
+#include "OptimizationStatsSampler.h"
 
 #define LOCTEXT_NAMESPACE "PerformanceMonitorWidget"
 
 void SPerformanceMonitorWidget::Construct(const FArguments& InArgs)
 {
     Analyzer = InArgs._Analyzer; 
+    WindowSeconds = InArgs._WindowSeconds;
+    HitchThresholdsMS = InArgs._HitchThresholdsMS;
 
     ChildSlot
         [
@@ -34,6 +41,19 @@ void SPerformanceMonitorWidget::Construct(const FArguments& InArgs)
                                 .ColorAndOpacity(FLinearColor::White)
                         ]
 
+                        // History of the last minutes
+                        + SVerticalBox::Slot()
+                        .AutoHeight()
+                        .Padding(0.0f, 0.0f, 0.0f, 10.0f)
+                        [
+                            SNew(SBox)
+                                .HeightOverride(180.0f)
+                                [
+                                    SNew(SOptimizationFrameGraph)
+                                        .HistorySeconds(600.0f)
+                                ]
+                        ]
+
                         // FPS
                         + SVerticalBox::Slot()
                         .AutoHeight()
@@ -78,6 +98,72 @@ void SPerformanceMonitorWidget::Construct(const FArguments& InArgs)
                                 ]
                         ]
 
+                    // Frame time percentiles over the window
+                    + SVerticalBox::Slot()
+                        .AutoHeight()
+                        .Padding(0.0f, 2.0f)
+                        [
+                            SNew(SHorizontalBox)
+                                + SHorizontalBox::Slot()
+                                .AutoWidth()
+                                [
+                                    SNew(STextBlock)
+                                        .Text(LOCTEXT("PercentilesLabel", "P95 / P99 / Max: "))
+                                        .Font(FCoreStyle::GetDefaultFontStyle("Bold", 11))
+                                ]
+                                + SHorizontalBox::Slot()
+                                .FillWidth(1.0f)
+                                [
+                                    SAssignNew(PercentilesText, STextBlock)
+                                        .Text(LOCTEXT("PercentilesValue", "-"))
+                                        .Font(FCoreStyle::GetDefaultFontStyle("Regular", 11))
+                                ]
+                        ]
+
+                    // Thread times
+                    + SVerticalBox::Slot()
+                        .AutoHeight()
+                        .Padding(0.0f, 2.0f)
+                        [
+                            SNew(SHorizontalBox)
+                                + SHorizontalBox::Slot()
+                                .AutoWidth()
+                                [
+                                    SNew(STextBlock)
+                                        .Text(LOCTEXT("ThreadTimesLabel", "Game / Render / RHI (P95): "))
+                                        .Font(FCoreStyle::GetDefaultFontStyle("Bold", 11))
+                                ]
+                                + SHorizontalBox::Slot()
+                                .FillWidth(1.0f)
+                                [
+                                    SAssignNew(ThreadTimesText, STextBlock)
+                                        .Text(LOCTEXT("ThreadTimesValue", "-"))
+                                        .Font(FCoreStyle::GetDefaultFontStyle("Regular", 11))
+                                ]
+                        ]
+
+                    // Hitches
+                    + SVerticalBox::Slot()
+                        .AutoHeight()
+                        .Padding(0.0f, 2.0f)
+                        [
+                            SNew(SHorizontalBox)
+                                + SHorizontalBox::Slot()
+                                .AutoWidth()
+                                [
+                                    SNew(STextBlock)
+                                        .Text(LOCTEXT("HitchesLabel", "Hitches: "))
+                                        .Font(FCoreStyle::GetDefaultFontStyle("Bold", 11))
+                                ]
+                                + SHorizontalBox::Slot()
+                                .FillWidth(1.0f)
+                                [
+                                    SAssignNew(HitchesText, STextBlock)
+                                        .Text(LOCTEXT("HitchesValue", "0"))
+                                        .Font(FCoreStyle::GetDefaultFontStyle("Regular", 11))
+                                ]
+                        ]
+
                     // Draw Calls
                     + SVerticalBox::Slot()
                         .AutoHeight()
@@ -165,6 +251,26 @@ void SPerformanceMonitorWidget::Construct(const FArguments& InArgs)
                                         .Font(FCoreStyle::GetDefaultFontStyle("Regular", 11))
                                 ]
                         ]
+
+                    // Per-frame CSV capture (written by the sampler thread)
+                    + SVerticalBox::Slot()
+                        .AutoHeight()
+                        .Padding(0.0f, 10.0f, 0.0f, 0.0f)
+                        [
+                            SNew(SHorizontalBox)
+                                + SHorizontalBox::Slot()
+                                .AutoWidth()
+                                [
+                                    SNew(SButton)
+                                        .Text_Lambda([]()
+                                            {
+                                                return FOptimizationStatsSampler::Get().IsCapturing()
+                                                    ? LOCTEXT("StopCapture", "Stop Recording")
+                                                    : LOCTEXT("StartCapture", "Record Frames to CSV");
+                                            })
+                                        .OnClicked(this, &SPerformanceMonitorWidget::OnToggleCapture)
+                                ]
+                        ]
                 ]
         ];
 }
@@ -193,9 +299,11 @@ void SPerformanceMonitorWidget::UpdateStats()
 
     UE_LOG(LogTemp, Warning, TEXT("PerformanceMonitorWidget: UpdateStats called, Analyzer is valid"));
 
-    // Get FPS
-    CurrentFPS = 1.0f / FApp::GetDeltaTime();
-    CurrentFrameTime = FApp::GetDeltaTime() * 1000.0f;  // Convert to milliseconds
+    // FPS and frame time over the window, not the last frame alone.
+    // The sampler records every frame even while this widget isn't ticking.
+    FOptimizationStatsSampler::Get().GetHistory().ComputeSummary(WindowSeconds, HitchThresholdsMS, FrameSummary);
+    CurrentFPS = FrameSummary.AverageFPS;
+    CurrentFrameTime = FrameSummary.Delta.P50;
 
     // Get rendering stats from Analyzer
     if (Analyzer)
@@ -203,6 +311,24 @@ void SPerformanceMonitorWidget::UpdateStats()
         FPerformanceStats Stats = Analyzer->GetCurrentPerformanceStats();
         CurrentDrawCalls = Stats.DrawCalls;
         CurrentTriangles = Stats.Triangles;
+        CurrentStreamingTextures = Stats.StreamingTextures;
+        CurrentTextureMemoryMB = Stats.TextureMemoryMB;
+        CurrentTextureWantedMB = Stats.TextureWantedMB;
+
+        // Where the draw call number comes from and how it splits over passes
+        bDrawCallsFromRenderer = Stats.bFromRenderer;
+        DrawCallsTooltip = Stats.bFromRenderer
+            ? FString::Printf(TEXT("Renderer draw calls of the last frame (all viewports and UI)\nPrimitives: %d\nScene mesh sections: %d"),
+                Stats.PrimitivesDrawn, Stats.MeshDrawCalls)
+            : FString::Printf(TEXT("No renderer (-nullrhi): estimated from the LOD 0 sections of the scene\nPrimitives: %d"),
+                Stats.PrimitivesDrawn);
+
+        if (Stats.bHasPassBreakdown)
+        {
+            DrawCallsTooltip += FString::Printf(TEXT("\nBase pass: %d\nShadow depths: %d\nTranslucency: %d"),
+                Stats.BasePassDrawCalls, Stats.ShadowDepthDrawCalls, Stats.TranslucencyDrawCalls);
+        }
+
         UE_LOG(LogTemp, Warning, TEXT("PerformanceMonitorWidget: Got stats - DrawCalls=%d, Triangles=%d"),
             CurrentDrawCalls, CurrentTriangles);
     }
@@ -216,8 +342,6 @@ void SPerformanceMonitorWidget::UpdateStats()
     FPlatformMemoryStats MemStats = FPlatformMemory::GetStats();
     CurrentMemoryMB = MemStats.UsedPhysical / (1024.0f * 1024.0f);
 
-    // Get texture streaming count
-    CurrentStreamingTextures = 0;  // Would need TextureStreamingManager access
 
     // Update UI
     if (FPSText.IsValid())
@@ -232,6 +356,35 @@ void SPerformanceMonitorWidget::UpdateStats()
         FrameTimeText->SetColorAndOpacity(GetFrameTimeColor(CurrentFrameTime));
     }
 
+    if (PercentilesText.IsValid())
+    {
+        PercentilesText->SetText(FText::FromString(FString::Printf(TEXT("%.2f / %.2f / %.2f ms"),
+            FrameSummary.Delta.P95, FrameSummary.Delta.P99, FrameSummary.Delta.Max)));
+        PercentilesText->SetColorAndOpacity(GetFrameTimeColor(FrameSummary.Delta.P99));
+        PercentilesText->SetToolTipText(FText::FromString(FString::Printf(TEXT("%d frames over the last %.1f s"),
+            FrameSummary.NumFrames, FrameSummary.WindowSeconds)));
+    }
+
+    if (ThreadTimesText.IsValid())
+    {
+        ThreadTimesText->SetText(FText::FromString(FString::Printf(TEXT("%.2f / %.2f / %.2f ms"),
+            FrameSummary.GameThread.P95, FrameSummary.RenderThread.P95, FrameSummary.RHIThread.P95)));
+    }
+
+    if (HitchesText.IsValid())
+    {
+        FString HitchesStr;
+        for (int32 Index = 0; Index < FrameSummary.NumHitchThresholds; ++Index)
+        {
+            HitchesStr += FString::Printf(TEXT("%s>%.0f ms: %d"), Index > 0 ? TEXT("  ") : TEXT(""),
+                FrameSummary.HitchThresholdsMS[Index], FrameSummary.HitchCounts[Index]);
+        }
+
+        HitchesText->SetText(FText::FromString(HitchesStr));
+        HitchesText->SetColorAndOpacity(FrameSummary.NumHitchThresholds > 0 && FrameSummary.HitchCounts[0] > 0
+            ? FLinearColor::Yellow : FLinearColor::Green);
+    }
+
     if (DrawCallsText.IsValid())
     {
         // Color coding for Draw Calls
@@ -241,8 +394,11 @@ void SPerformanceMonitorWidget::UpdateStats()
         else if (CurrentDrawCalls > 2000)
             DrawCallsColor = FLinearColor::Yellow;
 
-        DrawCallsText->SetText(FText::FromString(FString::Printf(TEXT("%d"), CurrentDrawCalls)));
+        DrawCallsText->SetText(FText::FromString(bDrawCallsFromRenderer
+            ? FString::Printf(TEXT("%d"), CurrentDrawCalls)
+            : FString::Printf(TEXT("~%d (estimate)"), CurrentDrawCalls)));
         DrawCallsText->SetColorAndOpacity(DrawCallsColor);
+        DrawCallsText->SetToolTipText(FText::FromString(DrawCallsTooltip));
         // DEBUG
         UE_LOG(LogTemp, Warning, TEXT("UI UPDATE: DrawCalls text set to %d"), CurrentDrawCalls);
     }
@@ -275,7 +431,8 @@ void SPerformanceMonitorWidget::UpdateStats()
 
     if (MemoryText.IsValid())
     {
-        MemoryText->SetText(FText::FromString(FString::Printf(TEXT("%.0f MB"), CurrentMemoryMB)));
+        MemoryText->SetText(FText::FromString(FString::Printf(TEXT("%.0f MB (textures %.0f MB, wanted %.0f MB)"),
+            CurrentMemoryMB, CurrentTextureMemoryMB, CurrentTextureWantedMB)));
     }
 
     if (TextureStreamingText.IsValid())
@@ -284,6 +441,29 @@ void SPerformanceMonitorWidget::UpdateStats()
     }
 }
 
+FReply SPerformanceMonitorWidget::OnToggleCapture()
+{
+    FOptimizationStatsSampler& Sampler = FOptimizationStatsSampler::Get();
+    if (Sampler.IsCapturing())
+    {
+        Sampler.StopCapture();
+        return FReply::Handled();
+    }
+
+    FDateTime Now = FDateTime::Now();
+    FString FileName = FString::Printf(
+        TEXT("FrameStats_%04d-%02d-%02d_%02d-%02d-%02d.csv"),
+        Now.GetYear(), Now.GetMonth(), Now.GetDay(),
+        Now.GetHour(), Now.GetMinute(), Now.GetSecond()
+    );
+
+    FString SavePath = FPaths::ProjectSavedDir() / TEXT("OptimizationReports") / FileName;
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(SavePath), true);
+
+    Sampler.StartCapture(SavePath);
+    return FReply::Handled();
+}
+
 FLinearColor SPerformanceMonitorWidget::GetFPSColor(float FPS) const
 {
     if (FPS >= 60.0f)
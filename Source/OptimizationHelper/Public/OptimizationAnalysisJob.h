@@ -0,0 +1,132 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Tasks/Task.h"
+#include "UObject/StrongObjectPtr.h"
+#include "OptimizationAnalyzer.h"
+#include <atomic>
+
+class FOptimizationCheckPassBase;
+struct FOptimizationProfileCounter;
+
+// Analysis that runs across frames instead of blocking the editor.
+// Game-thread work (loading, actor iteration) is time-sliced from the core
+// ticker, registry parsing and rule evaluation run as worker tasks in chunks.
+// Results are published chunk by chunk in the same order as a serial scan.
+class FOptimizationAnalysisJob : public TSharedFromThis<FOptimizationAnalysisJob>
+{
+public:
+    // Project scan over the given passes
+    FOptimizationAnalysisJob(UOptimizationAnalyzer* InAnalyzer, TArray<TSharedRef<FOptimizationCheckPassBase>>&& InPasses);
+
+    // Scan of the editor world
+    FOptimizationAnalysisJob(UOptimizationAnalyzer* InAnalyzer, UWorld* InWorld);
+
+    ~FOptimizationAnalysisJob();
+
+    // Background mode: ticks itself until done
+    static TSharedRef<FOptimizationAnalysisJob> StartProjectAnalysis(UOptimizationAnalyzer* Analyzer);
+    static TSharedRef<FOptimizationAnalysisJob> StartLevelAnalysis(UOptimizationAnalyzer* Analyzer);
+
+    // Blocking mode: used by the synchronous AnalyzeProject / Check* API
+    void RunToCompletion();
+
+    void Cancel();
+    bool IsFinished() const { return bFinished; }
+    bool WasCancelled() const { return bCancelRequested.load(); }
+
+    int32 GetProcessedCount() const { return ProcessedCount.load(std::memory_order_relaxed); }
+    int32 GetTotalCount() const { return TotalCount; }
+    float GetProgress() const;
+    FText GetCurrentTask() const;
+
+    // Issues published since the last call
+    void ConsumeNewIssues(TArray<FOptimizationIssue>& OutIssues);
+
+    // Game-thread time per tick, and the number of assets per worker task
+    static constexpr double TickBudgetSeconds = 0.010;
+    static constexpr int32 ChunkSize = 128;
+
+    // Longest a loaded batch waits for its objects to become ready (material shader compilation)
+    static constexpr double MaxObjectWaitSeconds = 300.0;
+
+private:
+    struct FChunk
+    {
+        int32 PassIndex = 0;
+        int32 Begin = 0;
+        int32 End = 0;
+        bool bLastInPass = false;
+        UE::Tasks::FTask ReadTask;
+        UE::Tasks::FTask EvaluateTask;
+    };
+
+    void Start();
+    bool OnTicker(float DeltaTime);
+
+    // Returns true when the job has finished
+    bool Step(double TimeBudgetSeconds, bool bBlocking);
+    void StepProject(double EndTime, bool bBlocking);
+
+    // Loads the assets of a chunk in async batches. Returns true once the chunk is done.
+    bool StepLoads(FOptimizationCheckPassBase& Pass, const FChunk& Chunk, double EndTime, bool bBlocking, bool bAllowLoading);
+    void RequestBatchLoads(const FOptimizationCheckPassBase& Pass);
+    bool AreLoadBatchObjectsReady(const FOptimizationCheckPassBase& Pass) const;
+    void OnPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
+    void CollectGarbageIfOverBudget();
+    void ResolveProfileCounters();
+    void StepLevel(double EndTime);
+    bool AreTasksCompleted() const;
+    void Finish();
+
+    TStrongObjectPtr<UOptimizationAnalyzer> Analyzer;
+
+    // Project scan
+    TArray<TSharedRef<FOptimizationCheckPassBase>> Passes;
+    TArray<FChunk> Chunks;
+    int32 LoadChunkIndex = 0;
+    int32 LoadAssetIndex = 0;
+    int32 PublishChunkIndex = 0;
+
+    // Current load batch (asset indices into the pass of LoadChunkIndex)
+    TArray<int32> LoadBatch;
+    int32 LoadBatchComputeIndex = 0;
+    bool bLoadBatchReady = false;
+    double ObjectWaitStartTime = 0.0;
+    TArray<int32> LoadRequestIds;
+    TSet<FName> FailedPackages;
+    int32 NumLoadsInFlight = 0;
+
+    // Memory use when the scan started, the load budget is relative to it
+    uint64 BaselineMemoryUsed = 0;
+    int32 NumPackagesLoaded = 0;
+    int32 NumGarbageCollections = 0;
+
+    // When the current load batch was requested, 0 once it is resident
+    uint64 LoadBatchStartCycles = 0;
+    uint64 LoadBatchStartMemory = 0;
+
+    // Phase counters of the analyzer's scan profile
+    FOptimizationProfileCounter* ReadCounter = nullptr;
+    FOptimizationProfileCounter* LoadCounter = nullptr;
+    FOptimizationProfileCounter* ComputeCounter = nullptr;
+    FOptimizationProfileCounter* EvaluateCounter = nullptr;
+    FOptimizationProfileCounter* PublishCounter = nullptr;
+    FOptimizationProfileCounter* LevelCounter = nullptr;
+
+    // Level scan
+    TWeakObjectPtr<UWorld> World;
+    TArray<TWeakObjectPtr<AActor>> Actors;
+    int32 NextActorIndex = 0;
+    TUniquePtr<FOptimizationLevelScanState> LevelState;
+    int32 LevelIssueCount = 0;
+
+    TArray<FOptimizationIssue> PendingIssues;
+    FTSTicker::FDelegateHandle TickerHandle;
+
+    std::atomic<bool> bCancelRequested { false };
+    std::atomic<int32> ProcessedCount { 0 };
+    int32 TotalCount = 0;
+    bool bFinished = false;
+};
@@ -2,10 +2,19 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
+#include "UObject/ObjectKey.h"
+#include "OptimizationAssetMetrics.h"
+#include "OptimizationSceneStats.h"
 #include "OptimizationAnalyzer.generated.h"
 
 // Forward declarations
 class UEdGraphNode;
+class AActor;
+class FOptimizationCheckPassBase;
+class FOptimizationAnalysisJob;
+class FOptimizationResultCache;
+class FOptimizationScanProfile;
+class FOptimizationTextureMemoryTracker;
 
 UENUM(BlueprintType)
 enum class EOptimizationSeverity : uint8
@@ -36,6 +45,7 @@ struct FOptimizationIssue
         : Severity(EOptimizationSeverity::Info)
         , Category(EOptimizationCategory::Other)
         , EstimatedImpact(0.0f)
+        , EstimatedSavingsMB(0.0f)
     {
     }
 
@@ -57,8 +67,16 @@ struct FOptimizationIssue
     UPROPERTY(BlueprintReadWrite)
     float EstimatedImpact; // 0-100 scale
 
+    // Memory the suggested fix is projected to free, 0 when the rule doesn't estimate it
+    UPROPERTY(BlueprintReadWrite)
+    float EstimatedSavingsMB;
+
     UPROPERTY(BlueprintReadWrite)
     FString SuggestedFix;
+
+    // Name of the rule that reported the issue (e.g. "Mesh.HighPoly"), None for legacy checks
+    UPROPERTY(BlueprintReadWrite)
+    FName RuleId;
 };
 
 // Real-time performance stats structure
@@ -73,6 +91,8 @@ struct FPerformanceStats
     UPROPERTY()
     float FrameTimeMS = 0.0f;
 
+    // Submitted by the renderer in the last frame (all passes, UI included).
+    // Scene estimate when bFromRenderer is false (e.g. -nullrhi).
     UPROPERTY()
     int32 DrawCalls = 0;
 
@@ -82,14 +102,58 @@ struct FPerformanceStats
     UPROPERTY()
     float MemoryUsedMB = 0.0f;
 
+    // Resident mips of the textures in memory
     UPROPERTY()
     float TextureMemoryMB = 0.0f;
 
+    // What the streamer wants resident; above TextureMemoryMB while textures stream in
+    UPROPERTY()
+    float TextureWantedMB = 0.0f;
+
+    // Textures whose resident mips differ from the wanted ones
+    UPROPERTY()
+    int32 StreamingTextures = 0;
+
     UPROPERTY()
     int32 PrimitivesDrawn = 0;
 
+    // LOD 0 mesh sections of the visible scene components (one draw each, single pass)
     UPROPERTY()
     int32 MeshDrawCalls = 0;
+
+    // Draw calls per pass, valid when bHasPassBreakdown
+    UPROPERTY()
+    int32 BasePassDrawCalls = 0;
+
+    UPROPERTY()
+    int32 ShadowDepthDrawCalls = 0;
+
+    UPROPERTY()
+    int32 TranslucencyDrawCalls = 0;
+
+    UPROPERTY()
+    bool bHasPassBreakdown = false;
+
+    // DrawCalls / PrimitivesDrawn are the renderer's own counters
+    UPROPERTY()
+    bool bFromRenderer = false;
+};
+
+// Running state of a level scan, so it can be processed one actor at a time
+struct FOptimizationLevelScanState
+{
+    FString WorldName;
+
+    // Track processed assets to avoid duplicates
+    TSet<FObjectKey> ProcessedMeshes;
+    TSet<FObjectKey> ProcessedTextures;
+
+    int32 ActorCount = 0;
+    int32 MeshCount = 0;
+    int32 TextureCount = 0;
+
+    // Rules of each asset class, created on first use
+    TMap<UClass*, TSharedPtr<FOptimizationCheckPassBase>> Evaluators;
 };
 
 UCLASS()
@@ -98,10 +162,18 @@ class UOptimizationAnalyzer : public UObject
     GENERATED_BODY()
 
 public:
+    UOptimizationAnalyzer();
+
     // Analysis functions
     TArray<FOptimizationIssue> AnalyzeCurrentLevel();
     TArray<FOptimizationIssue> AnalyzeProject();
 
+    // Level analysis of any loaded world (the commandlet passes maps it loaded itself)
+    TArray<FOptimizationIssue> AnalyzeLevel(UWorld* World);
+
+    // Level analysis of a single actor (used by the time-sliced level scan)
+    void AnalyzeLevelActor(AActor* Actor, FOptimizationLevelScanState& State, TArray<FOptimizationIssue>& OutIssues);
+
     // Specific checks
     TArray<FOptimizationIssue> CheckMeshes();
     TArray<FOptimizationIssue> CheckTextures();
@@ -116,10 +188,24 @@ public:
     int32 GetCurrentTriangleCount();
     float GetTextureMemoryUsage();
 
+    // Draw calls, primitives and triangles of the editor world in a single traversal.
+    // The live stats come from the incremental cache; this is the full walk it can be checked against.
+    FOptimizationSceneStats CollectSceneStats() const;
+
     // Configuration
     UPROPERTY()
     int32 MaxTrianglesPerMesh = 100000;
 
+    // Skeletal meshes share MaxTrianglesPerMesh, these are theirs only
+    UPROPERTY()
+    int32 MaxBonesPerSkeletalMesh = 150;
+
+    UPROPERTY()
+    int32 MaxBoneInfluences = 4;
+
+    UPROPERTY()
+    int32 MaxSectionsPerSkeletalMesh = 8;
+
     UPROPERTY()
     int32 MaxTextureSize = 2048;
 
@@ -129,9 +215,133 @@ public:
     UPROPERTY()
     int32 MaxTextureSamplesPerMaterial = 8;
 
+    // Instruction counts of the compiled shaders (material editor Stats panel)
+    UPROPERTY()
+    int32 MaxPixelShaderInstructions = 400;
+
+    UPROPERTY()
+    int32 MaxVertexShaderInstructions = 300;
+
+    UPROPERTY()
+    int32 MaxMaterialSamplers = 12;
+
+    // Expression graphs whose expensive patterns add up to less than this many
+    // estimated instructions are not reported
+    UPROPERTY()
+    int32 MinMaterialGraphCost = 40;
+
+    // Unique static permutations a master material may compile for its instances
+    UPROPERTY()
+    int32 MaxPermutationsPerMaterial = 16;
+
+    // Particle systems, Cascade and Niagara
+    UPROPERTY()
+    int32 MaxEmittersPerSystem = 8;
+
+    UPROPERTY()
+    int32 MaxCPUParticlesPerSystem = 1000;
+
+    UPROPERTY()
+    int32 MaxTranslucentParticlesPerSystem = 500;
+
+    UPROPERTY()
+    int32 MaxAudioSampleRate = 48000;
+
+    // Sound waves longer than this should stream
+    UPROPERTY()
+    float MaxNonStreamingSoundSeconds = 10.0f;
+
+    // Audio findings that would free less memory than this are not reported
+    UPROPERTY()
+    float MinAudioSavingsMB = 0.25f;
+
+    // Texture streaming findings that would free less pool memory than this are not reported
+    UPROPERTY()
+    float MinStreamingSavingsMB = 1.0f;
+
+    // Read metrics from asset registry tags instead of loading every asset
+    UPROPERTY()
+    bool bMetadataOnlyScan = true;
+
+    // In metadata-only mode, load assets whose registry tags are missing
+    // (saved before the plugin was enabled). When false those assets are skipped.
+    UPROPERTY()
+    bool bLoadAssetsWithoutMetadata = true;
+
+    // Assets requested from the async loader at once when registry tags aren't enough
+    UPROPERTY()
+    int32 LoadBatchSize = 32;
+
+    // Garbage is collected between load batches once memory use grows this much
+    // over what it was when the scan started
+    UPROPERTY()
+    int32 LoadMemoryBudgetMB = 4096;
+
+    // Reuse results of assets whose package hasn't changed since the last scan
+    UPROPERTY()
+    bool bIncrementalScan = true;
+
+    // Forget all cached results, the next scan evaluates every asset
+    void InvalidateResultCache();
+
+    // Results of the last project scan as stored in the on-disk cache (no asset is checked)
+    void GetCachedIssues(TArray<FOptimizationIssue>& OutIssues);
+
+    // Time spent per phase and per rule by the last scan
+    FOptimizationScanProfile& GetScanProfile() const;
+
 private:
-    // Helper functions for stats gathering
-    int32 CalculateSceneTriangles();
-    int32 CountVisiblePrimitives();
+    friend class FOptimizationAnalysisJob;
+
+    // One pass per asset class with registered rules (registry query happens here, on the game thread)
+    TSharedRef<FOptimizationCheckPassBase> MakeClassPass(UClass* AssetClass);
+    TArray<TSharedRef<FOptimizationCheckPassBase>> MakeProjectPasses();
+
+    // Picks the metrics struct for the class, the pass has no assets yet
+    TSharedRef<FOptimizationCheckPassBase> MakePassForClass(UClass* AssetClass) const;
+
+    // Runs the rules of every registered class the object is an instance of (level scan)
+    void EvaluateLevelObject(const UObject* Object, FOptimizationLevelScanState& State, TArray<FOptimizationIssue>& OutIssues) const;
+
+    // Fills issues of unchanged assets from the result cache before the pass runs
+    void ApplyCachedResults(FOptimizationCheckPassBase& Pass);
+
+    // Stores freshly evaluated results of assets [Begin, End) (called as chunks are published)
+    void StoreResults(const FOptimizationCheckPassBase& Pass, int32 Begin, int32 End);
+
+    // Hash of every setting that changes rule output
+    uint32 GetRuleSettingsHash() const;
+
+    // Creates the cache and loads it from disk on first use
+    FOptimizationResultCache& GetResultCache();
+
+    // Writes the cache to Saved/OptimizationHelper/ (after a project scan)
+    void SaveResultCache();
+
+    // Runs passes through an analysis job and blocks until it is done
+    TArray<FOptimizationIssue> RunPasses(TArray<TSharedRef<FOptimizationCheckPassBase>>&& Passes);
+
+    // Project-wide material instance ratio check
+    void CheckMaterialInstanceUsage(int32 BaseMaterialCount, TArray<FOptimizationIssue>& OutIssues) const;
+
+    // Projected memory savings of the texture findings, per rule
+    void LogTextureSavingsReport(const TArray<FOptimizationIssue>& Issues) const;
+
+    // Stats of the level scan, shared by the blocking and time-sliced paths
+    void LogLevelScanSummary(const FOptimizationLevelScanState& State, int32 IssueCount) const;
+
+    // Created on first use, so the CDO doesn't subscribe to registry events
+    TSharedPtr<FOptimizationResultCache> ResultCache;
+
+    static UWorld* GetEditorWorld();
+
+    // Created on first use, like the result cache
+    FOptimizationSceneStatsCache& GetSceneStatsCache();
+    TSharedPtr<FOptimizationSceneStatsCache> SceneStatsCache;
+
+    FOptimizationTextureMemoryTracker& GetTextureMemoryTracker();
+    TSharedPtr<FOptimizationTextureMemoryTracker> TextureMemoryTracker;
+
+    TSharedPtr<FOptimizationScanProfile> ScanProfile;
 
 };
\ No newline at end of file
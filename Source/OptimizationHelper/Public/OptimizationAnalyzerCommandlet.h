@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "OptimizationAnalyzer.h"
+#include "OptimizationAnalyzerCommandlet.generated.h"
+
+// Runs the analysis without the editor UI, for build agents:
+//
+//   UnrealEditor-Cmd Project.uproject -run=OptimizationAnalyzer -nullrhi -unattended
+//       [-Maps=/Game/Maps/A+/Game/Maps/B | -AllMaps] [-NoProject]
+//       [-Output=Report.json] [-MaxCritical=0] [-FullLoad] [-NoCache]
+//       [-MaxTriangles=N] [-MaxTextureSize=N] [-MaxBlueprintNodes=N] [-MaxTextureSamples=N]
+//       [-MaxBones=N] [-MaxBoneInfluences=N] [-MaxSkeletalSections=N] [-MinStreamingSavingsMB=N]
+//       [-MaxAudioSampleRate=N] [-MaxNonStreamingSoundSeconds=N] [-MinAudioSavingsMB=N]
+//       [-MaxEmitters=N] [-MaxCPUParticles=N] [-MaxTranslucentParticles=N]
+//       [-MaxPixelShaderInstructions=N] [-MaxVertexShaderInstructions=N] [-MaxSamplers=N]
+//       [-MinMaterialGraphCost=N] [-MaxPermutations=N]
+//
+// Compiled shader rules (Material.ShaderComplexity, Material.Samplers) need a real RHI: under
+// -nullrhi they only see stats saved in registry tags by an editor that compiled the material.
+//
+// Writes a JSON report and returns 1 when the number of Critical issues is
+// over -MaxCritical, 2 when a map or the report couldn't be processed.
+UCLASS()
+class UOptimizationAnalyzerCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UOptimizationAnalyzerCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    // Issues together with where they were found ("Project" or a map package)
+    struct FReportEntry
+    {
+        FString Source;
+        FOptimizationIssue Issue;
+    };
+
+    void ApplySettings(UOptimizationAnalyzer* Analyzer, const FString& Params) const;
+    TArray<FString> GetMapsToAnalyze(const FString& Params) const;
+    bool AnalyzeMap(UOptimizationAnalyzer* Analyzer, const FString& MapPackageName, TArray<FReportEntry>& OutEntries) const;
+    bool WriteReport(const FString& FilePath, const TArray<FReportEntry>& Entries, int32 MaxCritical) const;
+};
@@ -0,0 +1,300 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Engine/TextureDefines.h"
+#include "PixelFormat.h"
+#include "OptimizationMaterialGraph.h"
+
+// Forward declarations
+struct FAssetData;
+class UStaticMesh;
+class USkeletalMesh;
+class UTexture2D;
+class UMaterial;
+class UMaterialInstanceConstant;
+class UBlueprint;
+class USoundWave;
+class UParticleSystem;
+class UNiagaraSystem;
+enum class ESoundAssetCompressionType : uint8;
+enum class ESoundWaveLoadingBehavior : uint8;
+
+// Values the project scan needs per asset. They are filled either from asset
+// registry tags (no load) or from the loaded object, and metadata rules only
+// look at these structs, never at the UObject itself. Each struct can be
+// serialized, so the result cache can store it on disk.
+
+struct FOptimizationMeshMetrics
+{
+    int32 Triangles = 0;
+    int32 NumLODs = 0;
+
+    static const TCHAR* GetTypeName() { return TEXT("MeshMetrics"); }
+
+    friend FArchive& operator<<(FArchive& Ar, FOptimizationMeshMetrics& Metrics)
+    {
+        return Ar << Metrics.Triangles << Metrics.NumLODs;
+    }
+};
+
+struct FOptimizationSkeletalMeshMetrics
+{
+    TArray<int32> LODTriangles;
+    int32 NumBones = 0;
+    int32 MaxBoneInfluences = 0;   // Per vertex, largest of all LODs
+    int32 NumSections = 0;         // Of LOD 0, one skinned draw call each
+    int32 NumMaterials = 0;
+    int64 SkinWeightBytes = 0;     // Skin weight buffers of all LODs
+
+    int32 GetTriangles() const { return LODTriangles.Num() > 0 ? LODTriangles[0] : 0; }
+    int32 GetNumLODs() const { return LODTriangles.Num(); }
+
+    static const TCHAR* GetTypeName() { return TEXT("SkeletalMeshMetrics"); }
+
+    friend FArchive& operator<<(FArchive& Ar, FOptimizationSkeletalMeshMetrics& Metrics)
+    {
+        return Ar << Metrics.LODTriangles << Metrics.NumBones << Metrics.MaxBoneInfluences
+            << Metrics.NumSections << Metrics.NumMaterials << Metrics.SkinWeightBytes;
+    }
+};
+
+struct FOptimizationTextureMetrics
+{
+    int32 SizeX = 0;
+    int32 SizeY = 0;
+    TEnumAsByte<EPixelFormat> PixelFormat = PF_Unknown;
+    int32 NumMips = 0;      // 0 = full chain
+    int32 NumSlices = 1;
+    int32 LODBias = 0;
+    TEnumAsByte<TextureGroup> LODGroup = TEXTUREGROUP_World;
+
+    // Streaming settings
+    bool bNeverStream = false;
+    bool bVirtualTextureStreaming = false;
+    bool bPaddedToPowerOfTwo = false;   // Power Of Two Mode pads or stretches the source
+
+    static const TCHAR* GetTypeName() { return TEXT("TextureMetrics"); }
+
+    friend FArchive& operator<<(FArchive& Ar, FOptimizationTextureMetrics& Metrics)
+    {
+        return Ar << Metrics.SizeX << Metrics.SizeY << Metrics.PixelFormat << Metrics.NumMips
+            << Metrics.NumSlices << Metrics.LODBias << Metrics.LODGroup
+            << Metrics.bNeverStream << Metrics.bVirtualTextureStreaming << Metrics.bPaddedToPowerOfTwo;
+    }
+};
+
+struct FOptimizationMaterialMetrics
+{
+    int32 TextureSamples = 0;
+    bool bTwoSided = false;
+    TEnumAsByte<EBlendMode> BlendMode = BLEND_Opaque;
+
+    // Compiled shaders for the editor's shader platform (FOptimizationShaderStats),
+    // all 0 when bHasShaderStats is false
+    int32 PixelShaderInstructions = 0;
+    int32 VertexShaderInstructions = 0;
+    int32 NumSamplers = 0;
+    int32 VirtualTextureLookups = 0;
+    bool bHasShaderStats = false;
+
+    // Expensive patterns of the expression graph
+    FOptimizationMaterialGraphCost Graph;
+
+    static const TCHAR* GetTypeName() { return TEXT("MaterialMetrics"); }
+
+    friend FArchive& operator<<(FArchive& Ar, FOptimizationMaterialMetrics& Metrics)
+    {
+        return Ar << Metrics.TextureSamples << Metrics.bTwoSided << Metrics.BlendMode
+            << Metrics.PixelShaderInstructions << Metrics.VertexShaderInstructions
+            << Metrics.NumSamplers << Metrics.VirtualTextureLookups << Metrics.bHasShaderStats
+            << Metrics.Graph;
+    }
+};
+
+// What an instance itself sets that selects a shader permutation. Only its own overrides are
+// kept, the parent chain is resolved when all instances are known: a parent saved later than
+// its children then can't leave them with stale values.
+struct FOptimizationMaterialInstanceMetrics
+{
+    FString Parent;                     // Object path of the parent material or instance
+    TMap<FName, int32> StaticOverrides; // Static switches (0/1), component masks (RGBA bits) and
+                                        // base property overrides ("@BlendMode" etc.)
+
+    static const TCHAR* GetTypeName() { return TEXT("MaterialInstanceMetrics"); }
+
+    friend FArchive& operator<<(FArchive& Ar, FOptimizationMaterialInstanceMetrics& Metrics)
+    {
+        return Ar << Metrics.Parent << Metrics.StaticOverrides;
+    }
+};
+
+struct FOptimizationSoundMetrics
+{
+    float Duration = 0.0f;                  // Seconds
+    int32 SampleRate = 0;                   // For the platform the editor cooks for
+    int32 NumChannels = 0;
+    int32 CompressionQuality = 0;           // 1-100, codecs with a quality setting only
+    ESoundAssetCompressionType CompressionType = {};
+    ESoundWaveLoadingBehavior LoadingBehavior = {};
+    bool bStreaming = false;
+
+    static const TCHAR* GetTypeName() { return TEXT("SoundMetrics"); }
+
+    friend FArchive& operator<<(FArchive& Ar, FOptimizationSoundMetrics& Metrics)
+    {
+        return Ar << Metrics.Duration << Metrics.SampleRate << Metrics.NumChannels << Metrics.CompressionQuality
+            << Metrics.CompressionType << Metrics.LoadingBehavior << Metrics.bStreaming;
+    }
+};
+
+// Cascade and Niagara systems alike. Particle counts are the peaks the editor recorded
+// (Cascade) or the allocation estimate (Niagara), 0 when the system never ran.
+struct FOptimizationParticleMetrics
+{
+    int32 NumEmitters = 0;                  // Enabled ones
+    int32 NumGPUEmitters = 0;
+    int32 NumTranslucentEmitters = 0;
+    int32 MaxCPUParticles = 0;
+    int32 MaxGPUParticles = 0;
+    int32 MaxTranslucentParticles = 0;
+    int32 NumLODs = 0;                      // Cascade LOD levels, 0 for Niagara
+    bool bFixedBounds = false;
+    bool bHasScalability = false;           // LOD levels, or a Niagara effect type / scalability overrides
+
+    static const TCHAR* GetTypeName() { return TEXT("ParticleMetrics"); }
+
+    friend FArchive& operator<<(FArchive& Ar, FOptimizationParticleMetrics& Metrics)
+    {
+        return Ar << Metrics.NumEmitters << Metrics.NumGPUEmitters << Metrics.NumTranslucentEmitters
+            << Metrics.MaxCPUParticles << Metrics.MaxGPUParticles << Metrics.MaxTranslucentParticles
+            << Metrics.NumLODs << Metrics.bFixedBounds << Metrics.bHasScalability;
+    }
+};
+
+struct FOptimizationBlueprintMetrics
+{
+    int32 TotalNodes = 0;
+    bool bHasEventTick = false;
+
+    static const TCHAR* GetTypeName() { return TEXT("BlueprintMetrics"); }
+
+    friend FArchive& operator<<(FArchive& Ar, FOptimizationBlueprintMetrics& Metrics)
+    {
+        return Ar << Metrics.TotalNodes << Metrics.bHasEventTick;
+    }
+};
+
+// For asset classes without a metrics struct: rules only see FAssetData (or the loaded object)
+struct FOptimizationNoMetrics
+{
+    static const TCHAR* GetTypeName() { return TEXT("NoMetrics"); }
+
+    friend FArchive& operator<<(FArchive& Ar, FOptimizationNoMetrics& Metrics)
+    {
+        return Ar;
+    }
+};
+
+class FOptimizationAssetMetrics
+{
+public:
+    // Adds our own registry tags to assets on save, for values the engine doesn't tag
+    static void RegisterRegistryTags();
+    static void UnregisterRegistryTags();
+
+    // Read metrics from registry tags. Return false when a tag is missing
+    // (asset saved before the plugin was enabled), the caller then has to load.
+    static bool ReadFromRegistry(const FAssetData& AssetData, FOptimizationMeshMetrics& OutMetrics);
+    static bool ReadFromRegistry(const FAssetData& AssetData, FOptimizationSkeletalMeshMetrics& OutMetrics);
+    static bool ReadFromRegistry(const FAssetData& AssetData, FOptimizationTextureMetrics& OutMetrics);
+    static bool ReadFromRegistry(const FAssetData& AssetData, FOptimizationMaterialMetrics& OutMetrics);
+    static bool ReadFromRegistry(const FAssetData& AssetData, FOptimizationMaterialInstanceMetrics& OutMetrics);
+    static bool ReadFromRegistry(const FAssetData& AssetData, FOptimizationBlueprintMetrics& OutMetrics);
+    static bool ReadFromRegistry(const FAssetData& AssetData, FOptimizationSoundMetrics& OutMetrics);
+    static bool ReadFromRegistry(const FAssetData& AssetData, FOptimizationParticleMetrics& OutMetrics);
+    static bool ReadFromRegistry(const FAssetData& AssetData, FOptimizationNoMetrics& OutMetrics) { return true; }
+
+    // Compute metrics from a loaded object (also used to write the custom tags)
+    static void ComputeFromObject(const UStaticMesh* Mesh, FOptimizationMeshMetrics& OutMetrics);
+    static void ComputeFromObject(const USkeletalMesh* Mesh, FOptimizationSkeletalMeshMetrics& OutMetrics);
+    static void ComputeFromObject(const UTexture2D* Texture, FOptimizationTextureMetrics& OutMetrics);
+    static void ComputeFromObject(const UMaterial* Material, FOptimizationMaterialMetrics& OutMetrics);
+    static void ComputeFromObject(const UMaterialInstanceConstant* Instance, FOptimizationMaterialInstanceMetrics& OutMetrics);
+    static void ComputeFromObject(const UBlueprint* Blueprint, FOptimizationBlueprintMetrics& OutMetrics);
+    static void ComputeFromObject(const USoundWave* Wave, FOptimizationSoundMetrics& OutMetrics);
+    static void ComputeFromObject(const UParticleSystem* System, FOptimizationParticleMetrics& OutMetrics);
+    static void ComputeFromObject(const UNiagaraSystem* System, FOptimizationParticleMetrics& OutMetrics);
+    static void ComputeFromObject(const UObject* Object, FOptimizationNoMetrics& OutMetrics) {}
+
+    // Blend modes drawn in the translucency pass, shared by every rule that asks
+    static bool IsTranslucentBlendMode(EBlendMode BlendMode);
+
+    // A master material's static switch / component mask defaults and base properties, keyed
+    // like FOptimizationMaterialInstanceMetrics::StaticOverrides. Read from the tag when saved.
+    static void ComputeStaticDefaults(const UMaterial* Material, TMap<FName, int32>& OutDefaults);
+    static bool ReadStaticDefaults(const FAssetData& AssetData, TMap<FName, int32>& OutDefaults);
+
+    // Whether ComputeFromObject would see everything yet. Materials compile their shaders in
+    // the background after loading and only have shader statistics once that is done.
+    template <typename ObjectType>
+    static bool IsReadyToCompute(const ObjectType* Object) { return true; }
+    static bool IsReadyToCompute(const UMaterial* Material);
+
+    // Blocks until IsReadyToCompute holds for all of the objects
+    template <typename ObjectType>
+    static void FinishPendingWork(const TArray<const ObjectType*>& Objects) {}
+    static void FinishPendingWork(const TArray<const UMaterial*>& Materials);
+
+    // Metrics that also depend on packages other than the asset's own (the material functions
+    // a material calls). Tagged or cached values are only reused while those are unchanged.
+    template <typename MetricsType>
+    static constexpr bool HasDependencies() { return false; }
+    template <typename MetricsType>
+    static bool AreDependenciesCurrent(const MetricsType& Metrics) { return true; }
+    static bool AreDependenciesCurrent(const FOptimizationMaterialMetrics& Metrics);
+
+    // Custom tag names
+    static const FName TagVersion;
+    static const FName TagTextureSamples;
+    static const FName TagTwoSided;
+    static const FName TagShaderStats;              // "PS,VS,Samplers,VTLookups"
+    static const FName TagMaterialGraph;            // "Hash,Count,Cost,Count,Cost,..." per pattern
+    static const FName TagMaterialFunctions;        // "Package=SavedHash;...", "-" when none
+    static const FName TagInstanceParent;
+    static const FName TagInstanceOverrides;        // "Name=Value;Name=Value", "-" when none
+    static const FName TagStaticDefaults;           // Same format, on materials
+    static const FName TagSkeletalLODTriangles;
+    static const FName TagSkeletalBones;
+    static const FName TagSkeletalMaxInfluences;
+    static const FName TagSkeletalSections;
+    static const FName TagSkeletalMaterials;
+    static const FName TagSkeletalSkinWeightBytes;
+    static const FName TagTexturePixelFormat;
+    static const FName TagTextureMips;
+    static const FName TagTextureLODBias;
+    static const FName TagTextureLODGroup;
+    static const FName TagTextureNeverStream;
+    static const FName TagTextureVirtual;
+    static const FName TagTexturePadded;
+    static const FName TagBlueprintNodes;
+    static const FName TagBlueprintEventTick;
+    static const FName TagSoundDuration;
+    static const FName TagSoundSampleRate;
+    static const FName TagSoundChannels;
+    static const FName TagSoundQuality;
+    static const FName TagSoundCompression;
+    static const FName TagSoundLoading;
+    static const FName TagSoundStreaming;
+    static const FName TagParticleEmitters;
+    static const FName TagParticleMaxParticles;    // "CPU,GPU,Translucent"
+    static const FName TagParticleLODs;
+    static const FName TagParticleFixedBounds;
+    static const FName TagParticleScalability;
+
+    // Bump when the meaning of a custom tag changes so stale values are ignored
+    static constexpr int32 CurrentTagVersion = 2;
+};
+
+template <>
+constexpr bool FOptimizationAssetMetrics::HasDependencies<FOptimizationMaterialMetrics>() { return true; }
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FOptimizationSoundMetrics;
+enum class ESoundAssetCompressionType : uint8;
+enum class ESoundWaveLoadingBehavior : uint8;
+
+// Size of a sound wave from its duration, rate, channels and codec settings, without
+// decoding or even loading it. Codec bit rates are averages; the real size depends on the content.
+class OPTIMIZATIONHELPER_API FOptimizationAudioCost
+{
+public:
+    // Audio streams in chunks of at most this much; a retained wave keeps its first one
+    static constexpr int64 StreamingChunkBytes = 256 * 1024;
+
+    // Average compressed bits per sample and channel for the codec and quality
+    static float GetBitsPerSample(const FOptimizationSoundMetrics& Metrics);
+
+    // Size of the cooked audio data
+    static int64 CalcCompressedBytes(const FOptimizationSoundMetrics& Metrics);
+
+    // Memory held while the wave is loaded, before it plays: all of the data for waves that
+    // don't stream, the first chunk for retained streaming waves, nothing for the others
+    static int64 CalcResidentBytes(const FOptimizationSoundMetrics& Metrics);
+
+    static const TCHAR* GetCompressionTypeName(ESoundAssetCompressionType Type);
+    static const TCHAR* GetLoadingBehaviorName(ESoundWaveLoadingBehavior Behavior);
+};
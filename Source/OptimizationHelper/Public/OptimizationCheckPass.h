@@ -0,0 +1,366 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "OptimizationAnalyzer.h"
+#include "OptimizationRule.h"
+#include "OptimizationScanProfile.h"
+
+// How the metrics of one asset were obtained
+enum class EOptimizationMetricsSource : uint8
+{
+    Pending,        // Not read yet / registry tags missing
+    Registry,       // Parsed from asset registry tags
+    Object,         // Computed from the loaded object
+    Unavailable,    // Could not be loaded (or loading disabled)
+    Cached,         // Issues reused from the previous scan, nothing to evaluate
+    CachedMetrics   // Metrics reused from the previous scan, issues are re-evaluated
+};
+
+inline bool HasOptimizationMetrics(EOptimizationMetricsSource Source)
+{
+    return Source == EOptimizationMetricsSource::Registry
+        || Source == EOptimizationMetricsSource::Object
+        || Source == EOptimizationMetricsSource::CachedMetrics;
+}
+
+// All rules of one asset class, split by thread requirements:
+// ReadMetadata and Evaluate touch no UObjects and run on worker threads,
+// LoadAndCompute reads the (batch-loaded) asset and must run on the game thread.
+class FOptimizationCheckPassBase
+{
+public:
+    explicit FOptimizationCheckPassBase(const FString& InName)
+        : Name(InName)
+    {
+    }
+
+    virtual ~FOptimizationCheckPassBase() = default;
+
+    void SetAssets(TArray<FAssetData>&& InAssets)
+    {
+        Assets = MoveTemp(InAssets);
+        Sources.Init(EOptimizationMetricsSource::Pending, Assets.Num());
+        IssuesPerAsset.SetNum(Assets.Num());
+        OnAssetsSet();
+    }
+
+    // Any thread
+    virtual void ReadMetadata(int32 Index) = 0;
+    virtual void Evaluate(int32 Index) = 0;
+
+    // Game thread only
+    virtual void LoadAndCompute(int32 Index) = 0;
+
+    // Game thread only. A loaded asset may need more time before LoadAndCompute sees all of it
+    // (materials compile their shaders in the background); FinishObjects waits for the given ones.
+    virtual bool IsObjectReady(int32 Index) const = 0;
+    virtual void FinishObjects(const TArray<int32>& Indices) = 0;
+
+    // Runs every rule of the pass on an object that is already loaded (level scan)
+    virtual void EvaluateObject(const UObject* Object, TArray<FOptimizationIssue>& OutIssues) const = 0;
+
+    // Metrics of one asset as bytes, for the result cache
+    virtual void SaveMetrics(int32 Index, TArray<uint8>& OutBytes) const = 0;
+    virtual bool RestoreMetrics(int32 Index, const TArray<uint8>& Bytes) = 0;
+
+    // Cached metrics (and the issues found with them) don't depend on packages saved since
+    virtual bool AreCachedDependenciesCurrent(const TArray<uint8>& Bytes) const = 0;
+
+    // Pass-wide rules, once every asset has been evaluated. Adds to TrailingIssues.
+    virtual void EvaluatePass() = 0;
+
+    // A rule needs the UObject, registry tags are not enough for this pass
+    virtual bool RequiresLoadedObjects() const = 0;
+
+    // Pass-wide rules need the metrics of every asset, not only of the changed ones
+    virtual bool HasPassRules() const = 0;
+
+    // Engine content is worth querying only if a rule looks at it
+    virtual bool IncludesEngineContent() const = 0;
+
+    // Issues of assets [Begin, End), in asset order
+    void CollectIssues(int32 Begin, int32 End, TArray<FOptimizationIssue>& OutIssues) const
+    {
+        for (int32 Index = Begin; Index < End; ++Index)
+        {
+            OutIssues.Append(IssuesPerAsset[Index]);
+        }
+    }
+
+    // Issues of all assets followed by the pass-wide ones
+    void CollectIssues(TArray<FOptimizationIssue>& OutIssues) const
+    {
+        CollectIssues(0, Assets.Num(), OutIssues);
+        OutIssues.Append(TrailingIssues);
+    }
+
+    static bool IsEngineContent(const FAssetData& AssetData)
+    {
+        return AssetData.PackageName.ToString().StartsWith(TEXT("/Engine/"));
+    }
+
+    FString Name;
+    TArray<FAssetData> Assets;
+    TArray<EOptimizationMetricsSource> Sources;
+    TArray<TArray<FOptimizationIssue>> IssuesPerAsset;
+
+    // Pass-wide issues (not tied to one asset), reported after the asset issues
+    TArray<FOptimizationIssue> TrailingIssues;
+
+protected:
+    virtual void OnAssetsSet() = 0;
+};
+
+template <typename ObjectType, typename MetricsType>
+class TOptimizationCheckPass : public FOptimizationCheckPassBase
+{
+public:
+    TOptimizationCheckPass(const FString& InName, const UOptimizationAnalyzer& InAnalyzer, const TArray<TSharedRef<IOptimizationRule>>& InRules, FOptimizationScanProfile& Profile)
+        : FOptimizationCheckPassBase(InName)
+        , Analyzer(InAnalyzer)
+    {
+        for (const TSharedRef<IOptimizationRule>& Rule : InRules)
+        {
+            // A rule written for another metrics struct would read garbage
+            const TCHAR* RuleMetrics = Rule->GetMetricsTypeName();
+            if (RuleMetrics && FCString::Strcmp(RuleMetrics, MetricsType::GetTypeName()) != 0)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("Rule %s expects %s but %s assets provide %s, skipped"),
+                    *Rule->GetName().ToString(), RuleMetrics, *Name, MetricsType::GetTypeName());
+                continue;
+            }
+
+            FProfiledRule ProfiledRule { Rule, &Profile.FindOrAddCounter(Rule->GetName(), EOptimizationProfileKind::Rule) };
+            if (Rule->GetInput() == EOptimizationRuleInput::LoadedObject)
+            {
+                ObjectRules.Add(ProfiledRule);
+            }
+            else if (Rule->GetInput() == EOptimizationRuleInput::AllAssets)
+            {
+                PassRules.Add(ProfiledRule);
+            }
+            else
+            {
+                MetadataRules.Add(ProfiledRule);
+            }
+
+            bIncludesEngineContent |= Rule->IncludesEngineContent();
+        }
+    }
+
+    virtual void ReadMetadata(int32 Index) override
+    {
+        // Object rules need the load anyway, metrics come from the object then
+        if (Sources[Index] != EOptimizationMetricsSource::Pending || RequiresLoadedObjects()) return;
+
+        if (FOptimizationAssetMetrics::ReadFromRegistry(Assets[Index], Metrics[Index]))
+        {
+            Sources[Index] = EOptimizationMetricsSource::Registry;
+        }
+    }
+
+    virtual void LoadAndCompute(int32 Index) override
+    {
+        check(IsInGameThread());
+
+        const ObjectType* Object = Cast<ObjectType>(Assets[Index].GetAsset());
+        if (Object)
+        {
+            FOptimizationAssetMetrics::ComputeFromObject(Object, Metrics[Index]);
+            Sources[Index] = EOptimizationMetricsSource::Object;
+
+            const bool bEngineContent = IsEngineContent(Assets[Index]);
+            const FOptimizationRuleContext Context(Assets[Index], Analyzer, &Metrics[Index], Object);
+            for (const FProfiledRule& Rule : ObjectRules)
+            {
+                if (!bEngineContent || Rule.Rule->IncludesEngineContent())
+                {
+                    Rule.Evaluate(Context, ObjectIssuesPerAsset[Index]);
+                }
+            }
+        }
+        else
+        {
+            Sources[Index] = EOptimizationMetricsSource::Unavailable;
+        }
+    }
+
+    virtual bool IsObjectReady(int32 Index) const override
+    {
+        // Nothing is loaded here, an asset that isn't resident is the loader's business
+        const ObjectType* Object = Cast<ObjectType>(Assets[Index].FastGetAsset(false));
+        return !Object || FOptimizationAssetMetrics::IsReadyToCompute(Object);
+    }
+
+    virtual void FinishObjects(const TArray<int32>& Indices) override
+    {
+        TArray<const ObjectType*> Objects;
+        for (int32 Index : Indices)
+        {
+            if (const ObjectType* Object = Cast<ObjectType>(Assets[Index].FastGetAsset(false)))
+            {
+                Objects.Add(Object);
+            }
+        }
+        FOptimizationAssetMetrics::FinishPendingWork(Objects);
+    }
+
+    virtual void Evaluate(int32 Index) override
+    {
+        if (!HasOptimizationMetrics(Sources[Index])) return;
+
+        const bool bEngineContent = IsEngineContent(Assets[Index]);
+        const FOptimizationRuleContext Context(Assets[Index], Analyzer, &Metrics[Index], nullptr);
+        for (const FProfiledRule& Rule : MetadataRules)
+        {
+            if (!bEngineContent || Rule.Rule->IncludesEngineContent())
+            {
+                Rule.Evaluate(Context, IssuesPerAsset[Index]);
+            }
+        }
+
+        // Issues of object rules were produced while loading
+        IssuesPerAsset[Index].Append(MoveTemp(ObjectIssuesPerAsset[Index]));
+        ObjectIssuesPerAsset[Index].Reset();
+    }
+
+    virtual void EvaluateObject(const UObject* Object, TArray<FOptimizationIssue>& OutIssues) const override
+    {
+        check(IsInGameThread());
+
+        const ObjectType* TypedObject = Cast<ObjectType>(Object);
+        if (!TypedObject) return;
+
+        MetricsType ObjectMetrics;
+        FOptimizationAssetMetrics::ComputeFromObject(TypedObject, ObjectMetrics);
+
+        // Objects used by a level are reported even if they are engine content. Rules only need
+        // the names: gathering tags would run the plugin's own tag hook and compute the metrics again.
+        const FAssetData AssetData(Object, FAssetData::ECreationFlags::SkipAssetRegistryTagsGathering);
+        const FOptimizationRuleContext Context(AssetData, Analyzer, &ObjectMetrics, Object);
+        for (const FProfiledRule& Rule : MetadataRules)
+        {
+            Rule.Evaluate(Context, OutIssues);
+        }
+        for (const FProfiledRule& Rule : ObjectRules)
+        {
+            Rule.Evaluate(Context, OutIssues);
+        }
+    }
+
+    virtual void EvaluatePass() override
+    {
+        const FOptimizationPassContext Context(Assets, Analyzer, Metrics.GetData());
+        for (const FProfiledRule& Rule : PassRules)
+        {
+            Rule.EvaluatePass(Context, TrailingIssues);
+        }
+    }
+
+    virtual void SaveMetrics(int32 Index, TArray<uint8>& OutBytes) const override
+    {
+        MetricsType Copy = Metrics[Index];
+        FMemoryWriter Writer(OutBytes);
+        Writer << Copy;
+    }
+
+    virtual bool RestoreMetrics(int32 Index, const TArray<uint8>& Bytes) override
+    {
+        FMemoryReader Reader(Bytes);
+        Reader << Metrics[Index];
+        if (Reader.IsError())
+        {
+            Metrics[Index] = MetricsType();
+            return false;
+        }
+
+        Sources[Index] = EOptimizationMetricsSource::CachedMetrics;
+        return true;
+    }
+
+    virtual bool AreCachedDependenciesCurrent(const TArray<uint8>& Bytes) const override
+    {
+        if constexpr (!FOptimizationAssetMetrics::HasDependencies<MetricsType>())
+        {
+            return true;
+        }
+        else
+        {
+            MetricsType Cached;
+            FMemoryReader Reader(Bytes);
+            Reader << Cached;
+            return !Reader.IsError() && FOptimizationAssetMetrics::AreDependenciesCurrent(Cached);
+        }
+    }
+
+    virtual bool RequiresLoadedObjects() const override
+    {
+        return ObjectRules.Num() > 0;
+    }
+
+    virtual bool HasPassRules() const override
+    {
+        return PassRules.Num() > 0;
+    }
+
+    virtual bool IncludesEngineContent() const override
+    {
+        return bIncludesEngineContent;
+    }
+
+protected:
+    virtual void OnAssetsSet() override
+    {
+        Metrics.SetNum(Assets.Num());
+        ObjectIssuesPerAsset.SetNum(Assets.Num());
+    }
+
+private:
+    // A rule and the profile counter its cost goes to
+    struct FProfiledRule
+    {
+        TSharedRef<IOptimizationRule> Rule;
+        FOptimizationProfileCounter* Counter;
+
+        void Evaluate(const FOptimizationRuleContext& Context, TArray<FOptimizationIssue>& OutIssues) const
+        {
+            OPTIMIZATION_PROFILE_SCOPE(RuleScope, *Counter, 1);
+
+            const int32 FirstNewIssue = OutIssues.Num();
+            Rule->Evaluate(Context, OutIssues);
+            StampIssues(FirstNewIssue, OutIssues, RuleScope);
+        }
+
+        void EvaluatePass(const FOptimizationPassContext& Context, TArray<FOptimizationIssue>& OutIssues) const
+        {
+            OPTIMIZATION_PROFILE_SCOPE(RuleScope, *Counter, Context.Assets.Num());
+
+            const int32 FirstNewIssue = OutIssues.Num();
+            Rule->EvaluatePass(Context, OutIssues);
+            StampIssues(FirstNewIssue, OutIssues, RuleScope);
+        }
+
+        // Issues carry the rule's name, their memory goes to its profile counter
+        void StampIssues(int32 FirstNewIssue, TArray<FOptimizationIssue>& OutIssues, FOptimizationProfileScope& RuleScope) const
+        {
+            const FName RuleId = Rule->GetName();
+            for (int32 IssueIndex = FirstNewIssue; IssueIndex < OutIssues.Num(); ++IssueIndex)
+            {
+                OutIssues[IssueIndex].RuleId = RuleId;
+                RuleScope.AddBytes(FOptimizationScanProfile::GetAllocatedSize(OutIssues[IssueIndex]));
+            }
+        }
+    };
+
+    const UOptimizationAnalyzer& Analyzer;
+    TArray<FProfiledRule> MetadataRules;
+    TArray<FProfiledRule> ObjectRules;
+    TArray<FProfiledRule> PassRules;
+    bool bIncludesEngineContent = false;
+
+    TArray<MetricsType> Metrics;
+    TArray<TArray<FOptimizationIssue>> ObjectIssuesPerAsset;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+
+struct FOptimizationFrameSample;
+
+// Frame time, draw call and memory history of the stats sampler, one lane per series.
+//
+// Samples are folded into one min/max bucket per pixel column as they arrive, so a
+// paint only walks the columns (not the up to 18 minutes of frames behind them) and
+// each series is drawn as a single line list.
+class SOptimizationFrameGraph : public SLeafWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SOptimizationFrameGraph)
+        : _HistorySeconds(600.0f)
+        , _TargetFrameMS(16.67f)
+        {}
+        // Time span across the width of the graph
+        SLATE_ARGUMENT(float, HistorySeconds)
+        // Drawn as a reference line in the frame time lane
+        SLATE_ARGUMENT(float, TargetFrameMS)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+
+    virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+    virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+        FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+    virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+    enum ESeries
+    {
+        FrameTime,
+        DrawCalls,
+        Memory,
+        NumSeries
+    };
+
+    // Min and max of every series over the frames of one pixel column
+    struct FColumn
+    {
+        int64 Bucket = INDEX_NONE;
+        float Min[NumSeries];
+        float Max[NumSeries];
+    };
+
+    // Width changed: new bucket size, history folded again from what the sampler still has
+    void Rebuild(int32 NumColumns);
+
+    // Folds the samples recorded since the last call
+    void ConsumeNewSamples();
+    void AddSample(const FOptimizationFrameSample& Sample);
+
+    float HistorySeconds = 600.0f;
+    float TargetFrameMS = 16.67f;
+
+    // Ring of columns, slot = bucket % Num
+    TArray<FColumn> Columns;
+    double BucketSeconds = 1.0;
+
+    // Position in the sampler's history
+    uint64 Cursor = 0;
+    TArray<FOptimizationFrameSample> ReadBuffer;
+
+    float LatestValues[NumSeries] = {};
+};
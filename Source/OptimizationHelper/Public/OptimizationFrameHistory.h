@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include <atomic>
+
+// Timings of one frame, in milliseconds
+struct FOptimizationFrameSample
+{
+    double EndTime = 0.0;   // FPlatformTime::Seconds() when the frame ended
+    float DeltaMS = 0.0f;
+    float GameThreadMS = 0.0f;
+    float RenderThreadMS = 0.0f;
+    float RHIThreadMS = 0.0f;
+
+    // Renderer counters of the frame (0 without a renderer)
+    int32 DrawCalls = 0;
+    int32 PrimitivesDrawn = 0;
+
+    // Process memory, refreshed by the sampler a few times per second (not every frame)
+    float UsedMemoryMB = 0.0f;
+};
+
+struct FOptimizationPercentiles
+{
+    float P50 = 0.0f;
+    float P95 = 0.0f;
+    float P99 = 0.0f;
+    float Max = 0.0f;
+};
+
+// Frame time distribution over a rolling window
+struct FOptimizationFrameTimeSummary
+{
+    static constexpr int32 MaxHitchThresholds = 4;
+
+    int32 NumFrames = 0;
+    float WindowSeconds = 0.0f; // Time the frames in the window add up to
+    float AverageFPS = 0.0f;
+
+    FOptimizationPercentiles Delta;
+    FOptimizationPercentiles GameThread;
+    FOptimizationPercentiles RenderThread;
+    FOptimizationPercentiles RHIThread;
+
+    // Frames whose delta is above each threshold (same order as the thresholds passed in)
+    int32 NumHitchThresholds = 0;
+    TStaticArray<float, MaxHitchThresholds> HitchThresholdsMS;
+    TStaticArray<int32, MaxHitchThresholds> HitchCounts;
+};
+
+// The last frames' timings in a fixed ring (filled by FOptimizationStatsSampler).
+//
+// One producer and any number of readers. Nothing is locked and nothing is allocated
+// after construction: the producer writes a slot and then publishes the new count,
+// readers copy what they need and drop the samples the producer may have overwritten
+// meanwhile.
+class OPTIMIZATIONHELPER_API FOptimizationFrameHistory
+{
+public:
+    // ~18 minutes at 120 fps, power of two so the slot is a mask
+    static constexpr int32 Capacity = 131072;
+
+    // Most frames a summary window can hold (~68 seconds at 120 fps)
+    static constexpr int32 SummaryCapacity = 8192;
+
+    // Producer side, one thread only
+    void Push(const FOptimizationFrameSample& Sample);
+
+    // Copies up to MaxSamples of the newest samples, oldest first. Returns how many were copied.
+    int32 CopyLatest(FOptimizationFrameSample* OutSamples, int32 MaxSamples) const;
+
+    // Copies up to MaxSamples recorded since InOutCursor (skipping those already overwritten),
+    // oldest first, and moves the cursor past them. Returns how many were copied.
+    int32 CopySince(uint64& InOutCursor, FOptimizationFrameSample* OutSamples, int32 MaxSamples) const;
+
+    uint64 GetNumRecorded() const { return NumPushed.load(std::memory_order_acquire); }
+
+    // Percentiles and hitch counts of the frames that ended in the last WindowSeconds
+    // (the newest SummaryCapacity frames at most).
+    // Uses scratch space owned by the history, so only one thread (the game thread) may call it.
+    void ComputeSummary(float WindowSeconds, TConstArrayView<float> HitchThresholdsMS, FOptimizationFrameTimeSummary& OutSummary);
+
+private:
+    // Copies Num samples from index Begin, minus the ones overwritten during the copy
+    int32 CopyRange(uint64 Begin, int32 Num, FOptimizationFrameSample* OutSamples) const;
+
+    // Sorts the values in place
+    static FOptimizationPercentiles ComputePercentiles(float* Values, int32 Num);
+
+    TStaticArray<FOptimizationFrameSample, Capacity> Samples;
+    std::atomic<uint64> NumPushed { 0 };
+
+    // For ComputeSummary
+    TStaticArray<FOptimizationFrameSample, SummaryCapacity> ScratchSamples;
+    TStaticArray<float, SummaryCapacity> ScratchValues;
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OptimizationAnalyzer.h"
+
+// Issues stored column by column, for lists with hundreds of thousands of rows.
+//
+// Text is not stored per issue. Numbers are cut out of Title / Description /
+// SuggestedFix and kept in a parameter column, the asset name is replaced by a
+// marker, and what is left is interned ("Mesh has {n} triangles (threshold: {n})"
+// is stored once for all meshes). The text of a row is put back together only
+// when it is shown or exported.
+//
+// Rules keep reporting plain FOptimizationIssue text instead of a format id and
+// parameters: the same struct is what Blueprints, the commandlet's reports, the
+// result cache and the legacy checks consume, and those strings live only until
+// the chunk is added here. Encoding is lossless (numbers print back with the
+// digits they were written with, anything ambiguous stays verbatim), so the table
+// never shows text a rule did not write.
+class OPTIMIZATIONHELPER_API FOptimizationIssueTable
+{
+public:
+    // Returns the row index
+    int32 Add(const FOptimizationIssue& Issue);
+    void Reset();
+
+    int32 Num() const { return Severities.Num(); }
+
+    EOptimizationSeverity GetSeverity(int32 Row) const { return Severities[Row]; }
+    EOptimizationCategory GetCategory(int32 Row) const { return Categories[Row]; }
+    float GetImpact(int32 Row) const { return Impacts[Row]; }
+    float GetSavingsMB(int32 Row) const { return SavingsMB[Row]; }
+    FName GetRuleId(int32 Row) const { return RuleIds[Row]; }
+    FName GetAssetPath(int32 Row) const { return AssetPaths[Row]; }
+
+    // Formatted on demand
+    FString GetTitle(int32 Row) const;
+    FString GetDescription(int32 Row) const;
+    FString GetSuggestedFix(int32 Row) const;
+    FOptimizationIssue GetIssue(int32 Row) const;
+
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    // One text column of one row: interned template plus its numbers
+    struct FEncodedText
+    {
+        int32 TemplateId = INDEX_NONE;
+        int32 FirstParam = 0;
+        int32 NumParams = 0;    // INDEX_NONE: template is the text as is
+    };
+
+    FEncodedText Encode(const FString& Text, const FString& AssetName);
+    FString Decode(const FEncodedText& Encoded, int32 Row) const;
+
+    // Short name of the row's asset ("SM_Rock" of "/Game/Props/SM_Rock.SM_Rock")
+    static FString GetAssetName(FName AssetPath);
+
+    TArray<EOptimizationSeverity> Severities;
+    TArray<EOptimizationCategory> Categories;
+    TArray<float> Impacts;
+    TArray<float> SavingsMB;
+    TArray<FName> RuleIds;
+    TArray<FName> AssetPaths;
+    TArray<FEncodedText> Titles;
+    TArray<FEncodedText> Descriptions;
+    TArray<FEncodedText> SuggestedFixes;
+
+    // Numbers cut out of the text, with the digits after the decimal point they were printed with
+    TArray<double> ParamValues;
+    TArray<uint8> ParamDecimals;
+
+    // FString compares and hashes ignoring case; "SM_Rock" and "SM_ROCK" are two templates
+    struct FCaseSensitiveKeyFuncs : DefaultKeyFuncs<FString>
+    {
+        static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+        static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+    };
+
+    // Element ids are stable, nothing is ever removed until Reset
+    TSet<FString, FCaseSensitiveKeyFuncs> Templates;
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+
+class UMaterial;
+
+// Known-expensive patterns of a material's expression graph (material functions included)
+enum class EOptimizationMaterialPattern : uint8
+{
+    DependentTextureRead,   // UVs computed from another texture sample
+    Noise,                  // Noise / Vector Noise evaluated per pixel
+    SceneTexture,           // Scene Texture / Scene Depth lookups outside post process materials
+    SceneColor,             // Needs a copy of the scene color
+    CustomHLSL,             // Custom nodes of FOptimizationMaterialGraph::BigCustomNodeLines lines or more
+    PixelDepthOffset,       // Pixel Depth Offset connected, turns off early depth test
+
+    Num
+};
+
+// How often a pattern occurs and what it costs, in estimated extra pixel shader instructions
+struct FOptimizationMaterialPatternCost
+{
+    int32 Count = 0;
+    int32 Cost = 0;
+
+    friend FArchive& operator<<(FArchive& Ar, FOptimizationMaterialPatternCost& PatternCost)
+    {
+        return Ar << PatternCost.Count << PatternCost.Cost;
+    }
+};
+
+struct FOptimizationMaterialGraphCost
+{
+    // Of everything the analysis looks at, 0 = not analyzed
+    uint64 GraphHash = 0;
+    FOptimizationMaterialPatternCost Patterns[(int32)EOptimizationMaterialPattern::Num];
+
+    // Packages of the material functions the graph calls, with their saved hash when it was
+    // analyzed. The material's own package doesn't change when a function is edited.
+    TMap<FName, FIoHash> FunctionPackages;
+
+    const FOptimizationMaterialPatternCost& Get(EOptimizationMaterialPattern Pattern) const { return Patterns[(int32)Pattern]; }
+    int32 GetTotalCost() const;
+
+    friend FArchive& operator<<(FArchive& Ar, FOptimizationMaterialGraphCost& GraphCost)
+    {
+        Ar << GraphCost.GraphHash;
+        for (FOptimizationMaterialPatternCost& PatternCost : GraphCost.Patterns)
+        {
+            Ar << PatternCost;
+        }
+        return Ar << GraphCost.FunctionPackages;
+    }
+};
+
+// Walks the expression graph of a loaded material. Results are kept per graph hash: hashing
+// the graph is a single pass over the expressions, the pattern search only runs for graphs
+// not seen before (re-scans, materials saved without graph changes, duplicated materials).
+class OPTIMIZATIONHELPER_API FOptimizationMaterialGraph
+{
+public:
+    static constexpr int32 BigCustomNodeLines = 15;
+
+    // Graph costs kept at most (a few hundred bytes each), the cache is emptied when full
+    static constexpr int32 MaxCachedGraphs = 8192;
+
+    // Game thread only, reads editor-only data
+    static void Analyze(const UMaterial* Material, FOptimizationMaterialGraphCost& OutCost);
+
+    // Connections, expression classes and the settings the patterns depend on (xxHash64 of
+    // names and values, stable across sessions). Also returns the called function packages.
+    static uint64 CalcGraphHash(const UMaterial* Material, TSet<FName>* OutFunctionPackages = nullptr);
+
+    // None of the called functions was saved since the cost was computed. Any thread.
+    static bool AreFunctionsCurrent(const FOptimizationMaterialGraphCost& Cost);
+
+    static const TCHAR* GetPatternName(EOptimizationMaterialPattern Pattern);
+
+    static void ResetCache();
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Draw calls and primitives the renderer submitted in its last completed frame
+struct FOptimizationRenderCounters
+{
+    int32 DrawCalls = 0;
+    int32 PrimitivesDrawn = 0;
+
+    // Per pass split, only filled when bHasPassBreakdown
+    bool bHasPassBreakdown = false;
+    int32 BasePassDrawCalls = 0;
+    int32 ShadowDepthDrawCalls = 0;
+    int32 TranslucencyDrawCalls = 0;
+};
+
+namespace OptimizationRenderStats
+{
+    // False with -nullrhi or before the RHI is up; nothing is rendered then, callers fall back to scene estimates
+    bool HasRenderCounters();
+
+    // Reads the RHI counters (summed over GPUs). Returns false when HasRenderCounters() is false.
+    bool ReadRenderCounters(FOptimizationRenderCounters& OutCounters);
+
+    // Only the totals, without the per pass split (which looks categories up by name).
+    // Reads two global arrays and nothing else, cheap enough for every frame.
+    bool ReadDrawCounters(int32& OutDrawCalls, int32& OutPrimitivesDrawn);
+}
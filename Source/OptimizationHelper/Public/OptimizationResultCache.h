@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+#include "OptimizationAnalyzer.h"
+
+// Forward declarations
+struct FAssetData;
+class UPackage;
+class FObjectPostSaveContext;
+
+// What the cache knows about one asset
+struct FOptimizationCachedAsset
+{
+    // Extracted metrics, serialized by the pass that produced them
+    TArray<uint8> Metrics;
+
+    // Only valid for the rule set / thresholds the cache was written with
+    TArray<FOptimizationIssue> Issues;
+    bool bHasIssues = false;
+};
+
+// Results of already evaluated assets, keyed by package name and the package's
+// saved hash. Asset registry and save events mark packages dirty, so a repeated
+// project scan only re-evaluates what changed since the last run.
+// The cache is kept in Saved/OptimizationHelper/ so it survives editor restarts.
+// Game thread only.
+class FOptimizationResultCache
+{
+public:
+    FOptimizationResultCache();
+    ~FOptimizationResultCache();
+
+    // Returns the entry when the asset's package hasn't changed, nullptr otherwise
+    const FOptimizationCachedAsset* Find(const FAssetData& AssetData) const;
+    void Store(const FAssetData& AssetData, TArray<uint8>&& Metrics, const TArray<FOptimizationIssue>& Issues);
+
+    // Rule output depends on these. A different hash keeps the metrics but drops the issues.
+    void SetSettingsHash(uint32 InSettingsHash);
+
+    // Issues of every cached asset, as of the last scan (not validated against the registry)
+    void GetAllIssues(TArray<FOptimizationIssue>& OutIssues) const;
+
+    void Reset();
+
+    // Binary file under Saved/OptimizationHelper/
+    bool LoadFromDisk();
+    bool SaveToDisk();
+    static FString GetCacheFilePath();
+
+    int32 GetNumPackages() const { return Packages.Num(); }
+    int32 GetNumDirtyPackages() const { return DirtyPackages.Num(); }
+
+    // Bump when a rule's output changes for the same metrics and thresholds
+    static constexpr int32 RuleSetVersion = 3;
+
+    // Bump when the file layout changes
+    static constexpr int32 FileFormatVersion = 8;
+
+private:
+    struct FPackageEntry
+    {
+        FIoHash SavedHash;
+        TMap<FName, FOptimizationCachedAsset> Assets;
+    };
+
+    // Asset registry / package events
+    void OnAssetAdded(const FAssetData& AssetData);
+    void OnAssetRemoved(const FAssetData& AssetData);
+    void OnAssetUpdated(const FAssetData& AssetData);
+    void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+    void OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext ObjectSaveContext);
+
+    void MarkDirty(FName PackageName);
+    void DropIssues();
+
+    // Same code path for reading and writing the file
+    void Serialize(FArchive& Ar);
+    static void SerializePackage(FArchive& Ar, FName& PackageName, FPackageEntry& Entry);
+
+    static FIoHash GetSavedHash(FName PackageName);
+
+    TMap<FName, FPackageEntry> Packages;
+
+    // Packages changed since their entry was stored
+    TSet<FName> DirtyPackages;
+
+    uint32 SettingsHash = 0;
+
+    // Something changed since the file was last written
+    bool bModified = false;
+};
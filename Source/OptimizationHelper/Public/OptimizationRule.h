@@ -0,0 +1,143 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "OptimizationAnalyzer.h"
+
+// What a rule needs to look at an asset
+enum class EOptimizationRuleInput : uint8
+{
+    Metadata,       // Registry tags / extracted metrics only, evaluated on worker threads
+    LoadedObject,   // The loaded UObject, evaluated on the game thread (forces the asset to load)
+    AllAssets       // Metrics of every asset of the class at once, evaluated once the whole pass is
+};
+
+// Everything a rule gets for one asset
+struct FOptimizationRuleContext
+{
+    FOptimizationRuleContext(const FAssetData& InAssetData, const UOptimizationAnalyzer& InAnalyzer, const void* InMetrics, const UObject* InObject)
+        : AssetData(InAssetData)
+        , Analyzer(InAnalyzer)
+        , Metrics(InMetrics)
+        , Object(InObject)
+    {
+    }
+
+    const FAssetData& AssetData;
+
+    // Thresholds (MaxTrianglesPerMesh etc.)
+    const UOptimizationAnalyzer& Analyzer;
+
+    // Metrics struct of the asset class, see OptimizationAssetMetrics.h
+    const void* Metrics;
+
+    // Only set for LoadedObject rules and the level scan
+    const UObject* Object;
+
+    template <typename MetricsType>
+    const MetricsType& GetMetrics() const
+    {
+        check(Metrics);
+        return *static_cast<const MetricsType*>(Metrics);
+    }
+};
+
+// Everything a pass-wide (AllAssets) rule gets: all assets of the class and their metrics.
+// Assets whose metrics couldn't be obtained have default-constructed ones.
+struct FOptimizationPassContext
+{
+    FOptimizationPassContext(TConstArrayView<FAssetData> InAssets, const UOptimizationAnalyzer& InAnalyzer, const void* InMetrics)
+        : Assets(InAssets)
+        , Analyzer(InAnalyzer)
+        , Metrics(InMetrics)
+    {
+    }
+
+    TConstArrayView<FAssetData> Assets;
+    const UOptimizationAnalyzer& Analyzer;
+
+    // Array of the class's metrics struct, one per asset
+    const void* Metrics;
+
+    template <typename MetricsType>
+    TConstArrayView<MetricsType> GetMetrics() const
+    {
+        check(Metrics);
+        return TConstArrayView<MetricsType>(static_cast<const MetricsType*>(Metrics), Assets.Num());
+    }
+};
+
+// One check, e.g. "high poly mesh". Rules are registered in FOptimizationRuleRegistry;
+// the analyzer queries every asset class once and runs all of its rules in the same pass.
+class IOptimizationRule
+{
+public:
+    virtual ~IOptimizationRule() = default;
+
+    // Unique name, e.g. "Mesh.HighPoly"
+    virtual FName GetName() const = 0;
+
+    // Class of the assets the rule checks
+    virtual UClass* GetAssetClass() const = 0;
+
+    virtual EOptimizationRuleInput GetInput() const { return EOptimizationRuleInput::Metadata; }
+
+    // Metrics struct the rule reads (FOptimizationMeshMetrics::GetTypeName() etc.), nullptr if none
+    virtual const TCHAR* GetMetricsTypeName() const { return nullptr; }
+
+    // /Engine/ content is skipped in project scans unless a rule asks for it
+    virtual bool IncludesEngineContent() const { return false; }
+
+    // Bump when the rule's output changes, so cached results are re-evaluated
+    virtual int32 GetVersion() const { return 1; }
+
+    // Metadata rules run on any thread, LoadedObject rules on the game thread
+    virtual void Evaluate(const FOptimizationRuleContext& Context, TArray<FOptimizationIssue>& OutIssues) const = 0;
+
+    // AllAssets rules only, once per pass. The issues follow those of the assets.
+    virtual void EvaluatePass(const FOptimizationPassContext& Context, TArray<FOptimizationIssue>& OutIssues) const {}
+};
+
+// Base for rules reading one of the built-in metrics structs
+template <typename MetricsType>
+class TOptimizationMetricsRule : public IOptimizationRule
+{
+public:
+    virtual const TCHAR* GetMetricsTypeName() const override
+    {
+        return MetricsType::GetTypeName();
+    }
+
+    virtual void Evaluate(const FOptimizationRuleContext& Context, TArray<FOptimizationIssue>& OutIssues) const override
+    {
+        EvaluateMetrics(Context, Context.GetMetrics<MetricsType>(), OutIssues);
+    }
+
+protected:
+    virtual void EvaluateMetrics(const FOptimizationRuleContext& Context, const MetricsType& Metrics, TArray<FOptimizationIssue>& OutIssues) const = 0;
+};
+
+// Base for rules that compare the assets of a class with each other (e.g. instances per master material)
+template <typename MetricsType>
+class TOptimizationPassRule : public IOptimizationRule
+{
+public:
+    virtual EOptimizationRuleInput GetInput() const override { return EOptimizationRuleInput::AllAssets; }
+
+    virtual const TCHAR* GetMetricsTypeName() const override
+    {
+        return MetricsType::GetTypeName();
+    }
+
+    virtual void Evaluate(const FOptimizationRuleContext& Context, TArray<FOptimizationIssue>& OutIssues) const override
+    {
+    }
+
+    virtual void EvaluatePass(const FOptimizationPassContext& Context, TArray<FOptimizationIssue>& OutIssues) const override
+    {
+        EvaluateAllMetrics(Context, Context.GetMetrics<MetricsType>(), OutIssues);
+    }
+
+protected:
+    virtual void EvaluateAllMetrics(const FOptimizationPassContext& Context, TConstArrayView<MetricsType> Metrics, TArray<FOptimizationIssue>& OutIssues) const = 0;
+};
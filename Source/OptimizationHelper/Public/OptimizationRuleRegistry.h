@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OptimizationRule.h"
+
+// All rules the analyzer runs. Other modules can add their own:
+//
+//   FOptimizationRuleRegistry::Get().RegisterRule(MakeShared<FMyStudioRule>());
+//
+// Register and unregister on the game thread (e.g. in StartupModule / ShutdownModule).
+class OPTIMIZATIONHELPER_API FOptimizationRuleRegistry
+{
+public:
+    static FOptimizationRuleRegistry& Get();
+
+    // A rule with the same name is replaced
+    void RegisterRule(const TSharedRef<IOptimizationRule>& Rule);
+    void UnregisterRule(FName RuleName);
+
+    const TArray<TSharedRef<IOptimizationRule>>& GetRules() const { return Rules; }
+
+    // Asset classes with at least one rule, in registration order
+    TArray<UClass*> GetAssetClasses() const;
+
+    // Rules registered for exactly this class, in registration order
+    TArray<TSharedRef<IOptimizationRule>> GetRulesForClass(const UClass* AssetClass) const;
+
+    // Changes when rules are added, removed or bump their version
+    uint32 GetRuleSetHash() const;
+
+    // Rules shipped with the plugin (OptimizationBuiltinRules.cpp)
+    void RegisterBuiltinRules();
+    void UnregisterBuiltinRules();
+
+private:
+    TArray<TSharedRef<IOptimizationRule>> Rules;
+    TArray<FName> BuiltinRuleNames;
+};
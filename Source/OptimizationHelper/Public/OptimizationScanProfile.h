@@ -0,0 +1,143 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/PlatformTime.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include <atomic>
+
+struct FOptimizationIssue;
+
+enum class EOptimizationProfileKind : uint8
+{
+    Phase,  // Registry query, load, evaluate, UI population...
+    Rule    // One IOptimizationRule
+};
+
+// Totals of one phase or rule. Updated from any thread.
+struct FOptimizationProfileCounter
+{
+    FOptimizationProfileCounter(FName InName, EOptimizationProfileKind InKind)
+        : Name(InName)
+        , Kind(InKind)
+        , TraceName(InName.ToString())
+    {
+    }
+
+    const FName Name;
+    const EOptimizationProfileKind Kind;
+
+    // Shown in Unreal Insights
+    const FString TraceName;
+
+    std::atomic<uint64> Cycles { 0 };
+    std::atomic<int64> Calls { 0 };
+    std::atomic<int64> Assets { 0 };
+    std::atomic<int64> BytesAllocated { 0 };
+
+    // For costs that don't fit a scope (e.g. async loads spanning several frames)
+    void Add(uint64 InCycles, int64 InAssets, int64 InBytes)
+    {
+        Cycles.fetch_add(InCycles, std::memory_order_relaxed);
+        Calls.fetch_add(1, std::memory_order_relaxed);
+        Assets.fetch_add(InAssets, std::memory_order_relaxed);
+        BytesAllocated.fetch_add(InBytes, std::memory_order_relaxed);
+    }
+};
+
+// One row of the profile
+struct FOptimizationProfileEntry
+{
+    FName Name;
+    EOptimizationProfileKind Kind = EOptimizationProfileKind::Phase;
+    double Seconds = 0.0;
+    int64 Calls = 0;
+    int64 Assets = 0;
+    int64 BytesAllocated = 0;
+
+    double GetAssetsPerSecond() const
+    {
+        return Seconds > 0.0 ? Assets / Seconds : 0.0;
+    }
+};
+
+// Where a scan spends its time: every phase and every rule, accumulated over one scan.
+// Times are summed across threads, so rules evaluated on workers can add up to more
+// than the wall time of the scan. Phases include the rules they run.
+class OPTIMIZATIONHELPER_API FOptimizationScanProfile
+{
+public:
+    // Phase names
+    static const FName RegistryQuery;
+    static const FName ReadMetadata;
+    static const FName Load;
+    static const FName ComputeMetrics;
+    static const FName Evaluate;
+    static const FName Publish;
+    static const FName LevelActors;
+    static const FName UIPopulation;
+
+    // Counters are never freed, the reference stays valid across Reset()
+    FOptimizationProfileCounter& FindOrAddCounter(FName Name, EOptimizationProfileKind Kind);
+
+    // Zeroes all counters and restarts the wall clock (when a scan starts)
+    void Reset();
+
+    // Stops the wall clock (when a scan finishes)
+    void MarkFinished();
+
+    double GetWallSeconds() const;
+
+    // Counters that were hit, most expensive first
+    TArray<FOptimizationProfileEntry> GetEntries() const;
+
+    bool SaveToCSV(const FString& FilePath) const;
+
+    // Issues are what rules allocate per asset; the strings dominate
+    static int64 GetAllocatedSize(const FOptimizationIssue& Issue);
+
+private:
+    mutable FCriticalSection CountersLock;
+    TArray<TUniquePtr<FOptimizationProfileCounter>> Counters;
+
+    double StartTime = 0.0;
+    double EndTime = 0.0;
+};
+
+// Times a scope into a counter and emits a matching Unreal Insights event
+class FOptimizationProfileScope
+{
+public:
+    explicit FOptimizationProfileScope(FOptimizationProfileCounter& InCounter, int64 NumAssets = 1)
+        : Counter(InCounter)
+        , StartCycles(FPlatformTime::Cycles64())
+    {
+        Counter.Assets.fetch_add(NumAssets, std::memory_order_relaxed);
+    }
+
+    ~FOptimizationProfileScope()
+    {
+        Counter.Cycles.fetch_add(FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
+        Counter.Calls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // When the number of assets is only known at the end of the scope
+    void AddAssets(int64 NumAssets)
+    {
+        Counter.Assets.fetch_add(NumAssets, std::memory_order_relaxed);
+    }
+
+    void AddBytes(int64 Bytes)
+    {
+        Counter.BytesAllocated.fetch_add(Bytes, std::memory_order_relaxed);
+    }
+
+private:
+    FOptimizationProfileCounter& Counter;
+    const uint64 StartCycles;
+};
+
+// Profile scope plus CPU trace event named after the counter
+#define OPTIMIZATION_PROFILE_SCOPE(ScopeName, Counter, NumAssets) \
+    TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*(Counter).TraceName); \
+    FOptimizationProfileScope ScopeName(Counter, NumAssets)
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtr.h"
+
+class AActor;
+class UActorComponent;
+class UPrimitiveComponent;
+class ULevel;
+class UWorld;
+
+// Counters of one walk over the editor world
+struct FOptimizationSceneStats
+{
+    int32 ActorCount = 0;
+    int32 DrawCalls = 0;
+    int32 PrimitivesDrawn = 0;
+    int32 Triangles = 0;
+
+    // What one primitive component adds (LOD 0 sections and triangles, skeletal and landscape estimates).
+    // Shared by the full traversal and the incremental cache so both count the same way.
+    void AddComponent(const UPrimitiveComponent& PrimComp, bool bOwnerIsLandscape);
+
+    // Landscape actors are recognized by class name; cache the answer per class
+    static bool IsLandscapeClass(const UClass* ActorClass, TMap<const UClass*, bool>& Cache);
+};
+
+// Running totals of the scene stats, updated from engine events instead of walking the world.
+//
+// Every primitive component has one row (structure of arrays, rows are recycled through a
+// free list so indices stay stable). Spawned/destroyed actors, render state changes
+// (visibility, mesh swaps, hiding), editor edits, undo/redo, World Partition loads and
+// streamed levels only mark what changed; GetStats applies those changes, so an update
+// costs O(changes). Only a new world is walked in full.
+// A few rows are re-validated per update to catch components that went away silently.
+class FOptimizationSceneStatsCache
+{
+public:
+    FOptimizationSceneStatsCache();
+    ~FOptimizationSceneStatsCache();
+
+    // Totals for the world; the first call (or a new world) builds the rows once
+    const FOptimizationSceneStats& GetStats(UWorld* World);
+
+    int32 GetNumRows() const { return RowComponents.Num() - FreeRows.Num(); }
+
+    // Rows re-validated per GetStats call
+    static constexpr int32 AuditRowsPerUpdate = 256;
+
+private:
+    void BindWorld(UWorld* World);
+    void UnbindWorld();
+    void Rebuild();
+
+    // Event handlers, they only record what changed
+    void OnActorSpawned(AActor* Actor);
+    void OnActorDestroyed(AActor* Actor);
+    void OnRenderStateDirty(UActorComponent& Component);
+    void OnObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& Event);
+    void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+    void OnLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+    void OnObjectTransacted(UObject* Object, const class FTransactionObjectEvent& Event);
+    void OnLoadedActorAdded(AActor& Actor);
+    void OnLoadedActorRemoved(AActor& Actor);
+
+    void ApplyPendingChanges();
+    void AuditRows();
+
+    // Re-reads every component of the actor
+    void UpdateActor(AActor* Actor);
+    void RemoveActor(FObjectKey ActorKey);
+
+    // Re-reads one component, adds a row if it is new
+    void UpdateComponent(UPrimitiveComponent* Component);
+
+    int32 AllocateRow(UPrimitiveComponent* Component, FObjectKey OwnerKey);
+    void FreeRow(int32 Row);
+    void SetRowStats(int32 Row, const FOptimizationSceneStats& Stats);
+    bool IsInBoundWorld(const UObject* Object) const;
+
+    // One row per primitive component (keys stay usable after the component is gone)
+    TArray<FObjectKey> RowComponents;
+    TArray<FObjectKey> RowOwners;
+    TArray<int32> RowDrawCalls;
+    TArray<int32> RowTriangles;
+    TArray<uint8> RowPrimitives;
+    TArray<int32> FreeRows;
+
+    TMap<FObjectKey, int32> ComponentRows;
+    TMultiMap<FObjectKey, int32> ActorRows;
+    TSet<FObjectKey> KnownActors;
+
+    // Recorded by the event handlers, applied in GetStats
+    TSet<TWeakObjectPtr<AActor>> DirtyActors;
+    TSet<TWeakObjectPtr<UPrimitiveComponent>> DirtyComponents;
+    bool bNeedsRebuild = true;
+
+    FOptimizationSceneStats Totals;
+    TMap<const UClass*, bool> LandscapeClasses;
+    int32 AuditCursor = 0;
+
+    TWeakObjectPtr<UWorld> BoundWorld;
+    FDelegateHandle ActorSpawnedHandle;
+    FDelegateHandle ActorDestroyedHandle;
+    FDelegateHandle RenderStateDirtyHandle;
+    FDelegateHandle PropertyChangedHandle;
+    FDelegateHandle LevelAddedHandle;
+    FDelegateHandle LevelRemovedHandle;
+    FDelegateHandle ObjectTransactedHandle;
+    FDelegateHandle LoadedActorAddedHandle;
+    FDelegateHandle LoadedActorRemovedHandle;
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UMaterial;
+struct FOptimizationMaterialMetrics;
+
+// Statistics of a material's compiled shaders, as the material editor's Stats panel shows them,
+// for the shader platform the editor renders with (GMaxRHIFeatureLevel, high quality).
+// Shaders compile in the background after a material is loaded; nothing here waits for
+// them except FinishCompilation. Without a rendering RHI (-nullrhi) nothing is compiled and
+// Read always fails.
+class OPTIMIZATIONHELPER_API FOptimizationShaderStats
+{
+public:
+    // Fills the shader fields of the metrics from the compiled shader map. Returns false and
+    // leaves them at 0 while the shaders are still compiling or when they failed to compile.
+    static bool Read(const UMaterial* Material, FOptimizationMaterialMetrics& OutMetrics);
+
+    // The material's shader map for the editor platform is still being compiled
+    static bool IsCompiling(const UMaterial* Material);
+
+    // Blocks until all given materials are compiled, as one request to the shader compiling manager
+    static void FinishCompilation(const TArray<const UMaterial*>& Materials);
+};
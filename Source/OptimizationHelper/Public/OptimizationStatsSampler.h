@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/CircularQueue.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/Runnable.h"
+#include "OptimizationFrameHistory.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+
+// Samples frame stats for as long as the editor runs, whether or not a monitor is open.
+//
+// The game thread only takes the sample at the end of each frame and pushes it into a
+// fixed single-producer/single-consumer queue. The sampler thread drains the queue and
+// hands each sample to the consumers: the frame history the monitor reads, and a CSV
+// capture when one is running. Displaying the stats costs nothing while no monitor is
+// visible, and a slow consumer never stalls the game thread (samples are dropped instead).
+class OPTIMIZATIONHELPER_API FOptimizationStatsSampler : public FRunnable
+{
+public:
+    static FOptimizationStatsSampler& Get();
+
+    // Module startup / shutdown (game thread)
+    void StartSampling();
+    void StopSampling();
+    bool IsSampling() const { return EndFrameHandle.IsValid(); }
+
+    // Newest samples; the history is only written by the sampler thread
+    FOptimizationFrameHistory& GetHistory() { return History; }
+
+    // Writes every sample to a CSV file until StopCapture
+    bool StartCapture(const FString& FilePath);
+    void StopCapture();
+    bool IsCapturing() const;
+
+    // Samples lost because the queue was full
+    uint64 GetNumDropped() const { return NumDropped.load(std::memory_order_relaxed); }
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    FOptimizationStatsSampler();
+
+    // Producer, game thread
+    void OnEndFrame();
+
+    // Consumer, sampler thread (or the game thread when there are no threads)
+    void DrainQueue();
+
+    // Reading process memory isn't free on every platform, it is refreshed at this rate
+    static constexpr double MemoryRefreshSeconds = 0.1;
+    double LastMemoryTime = 0.0;
+    float UsedMemoryMB = 0.0f;
+
+    // A few seconds of frames, in case the sampler thread is starved
+    static constexpr uint32 QueueCapacity = 512;
+
+    TCircularQueue<FOptimizationFrameSample> Queue;
+    FOptimizationFrameHistory History;
+
+    FRunnableThread* Thread = nullptr;
+    FEvent* WakeEvent = nullptr;
+    std::atomic<bool> bStopRequested { false };
+    std::atomic<uint64> NumDropped { 0 };
+    FDelegateHandle EndFrameHandle;
+
+    // Taken by the consumer once per drained batch, not per frame
+    mutable FCriticalSection CaptureLock;
+    TUniquePtr<FArchive> CaptureFile;
+};
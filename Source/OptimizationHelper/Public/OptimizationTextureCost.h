@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PixelFormat.h"
+
+struct FOptimizationTextureMetrics;
+
+// GPU memory of a texture from its format, size, mips and LOD settings, without loading it
+class OPTIMIZATIONHELPER_API FOptimizationTextureCost
+{
+public:
+    // Bytes of mips [FirstMip, NumMips) in the format's blocks (BC: 4x4 texels in 8 or 16 bytes).
+    // NumMips <= 0 means the full chain.
+    static int64 CalcBytes(EPixelFormat Format, int32 SizeX, int32 SizeY, int32 NumSlices, int32 NumMips, int32 FirstMip = 0);
+
+    // What the texture takes once the texture's and its group's LOD bias drop the top mips
+    static int64 CalcResidentBytes(const FOptimizationTextureMetrics& Metrics);
+
+    // Same, with the top mips also dropped until the larger side is at most MaxDimension
+    static int64 CalcResidentBytesAtMaxSize(const FOptimizationTextureMetrics& Metrics, int32 MaxDimension);
+
+    // Least the texture would keep in memory if it streamed with a full mip chain: the smallest
+    // mips, which the streamer never drops (UTexture2D::GetStaticMinTextureResidentMipCount)
+    static int64 CalcMinStreamedBytes(const FOptimizationTextureMetrics& Metrics);
+
+    // Pool memory a texture that can't stream now would give back at most once it can
+    static int64 CalcStreamingSavings(const FOptimizationTextureMetrics& Metrics);
+
+    // Virtual texturing loads only the visible tiles of a mip where streaming loads all of it;
+    // at most that is the top resident mip
+    static int64 CalcVirtualTextureSavings(const FOptimizationTextureMetrics& Metrics);
+
+    // Mips the LOD bias of the texture and its texture group drop (active device profile)
+    static int32 GetLODBias(const FOptimizationTextureMetrics& Metrics);
+
+    // "PF_DXT1" style names, as GPixelFormats and the "Format" registry tag use them
+    static EPixelFormat FindPixelFormat(const FString& Name);
+    static const TCHAR* GetPixelFormatName(EPixelFormat Format);
+
+    static int32 GetFullMipCount(int32 SizeX, int32 SizeY);
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/UObjectArray.h"
+#include <atomic>
+
+class UTexture;
+
+enum class EOptimizationTextureKind : uint8
+{
+    Texture2D,
+    Virtual,        // Virtual textured 2D, memory lives in the VT physical pools
+    Cube,
+    Array,
+    Volume,
+    RenderTarget,
+    Other,
+    Num
+};
+
+// Memory of the textures that are loaded and have a render resource. Nothing is loaded to measure it.
+// Virtual textures are left out of ResidentBytes / WantedBytes: their pages live in the shared VT
+// physical pools, whose size is set by the project, not by the textures. They are only counted
+// per kind, where ResidentBytesByKind holds the engine's size estimate for them, not pool memory.
+struct FOptimizationTextureMemoryStats
+{
+    // Mips in memory now
+    int64 ResidentBytes = 0;
+
+    // Mips the streamer asked for; differs from resident while textures stream in or out
+    int64 WantedBytes = 0;
+
+    int32 NumTextures = 0;
+    int32 NumStreaming = 0;
+
+    int64 ResidentBytesByKind[(int32)EOptimizationTextureKind::Num] = {};
+    int32 NumTexturesByKind[(int32)EOptimizationTextureKind::Num] = {};
+
+    float GetResidentMB() const { return ResidentBytes / (1024.0f * 1024.0f); }
+    float GetWantedMB() const { return WantedBytes / (1024.0f * 1024.0f); }
+
+    static const TCHAR* GetKindName(EOptimizationTextureKind Kind);
+};
+
+// Running texture memory totals, kept up to date instead of rescanning every texture.
+//
+// Texture objects are picked up when they are created (object array listener) and dropped
+// when they are destroyed, one row each. Rows of textures that are streaming or are
+// render targets (which resize) are measured on every update; the others are re-measured
+// a few at a time, which catches resources recreated without an event.
+// Sizes are the engine's own (CalcTextureMemorySizeEnum) at the mip counts the streaming
+// state reports.
+class FOptimizationTextureMemoryTracker
+    : public FUObjectArray::FUObjectCreateListener
+    , public FUObjectArray::FUObjectDeleteListener
+{
+public:
+    FOptimizationTextureMemoryTracker();
+    virtual ~FOptimizationTextureMemoryTracker();
+
+    // Game thread. The first call measures every loaded texture once.
+    const FOptimizationTextureMemoryStats& GetStats();
+
+    // Rows re-measured per update, on top of the streaming ones
+    static constexpr int32 AuditRowsPerUpdate = 512;
+
+    // FUObjectCreateListener / FUObjectDeleteListener, any thread
+    virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override;
+    virtual void NotifyUObjectDeleted(const UObjectBase* Object, int32 Index) override;
+    virtual void OnUObjectArrayShutdown() override;
+
+private:
+    struct FMeasure
+    {
+        int64 ResidentBytes = 0;
+        int64 WantedBytes = 0;
+        EOptimizationTextureKind Kind = EOptimizationTextureKind::Other;
+        bool bHasResource = false;
+        bool bVolatile = false;     // Streaming or resizable, measured every update
+    };
+
+    static FMeasure Measure(UTexture* Texture);
+    static EOptimizationTextureKind GetKind(const UTexture* Texture);
+
+    void RemoveListeners();
+    void Rebuild();
+    void ApplyPendingEvents();
+    void UpdatePendingCreates();
+    void UpdateVolatileRows();
+    void AuditRows();
+
+    void AddTexture(UTexture* Texture, int32 ObjectIndex);
+    void RemoveObjectIndex(int32 ObjectIndex);
+    void UpdateRow(int32 Row);
+    void SetRowMeasure(int32 Row, const FMeasure& NewMeasure);
+
+    void SetTracked(int32 ObjectIndex, bool bTracked);
+    bool IsTracked(int32 ObjectIndex) const;
+
+    // One row per tracked texture
+    TArray<TWeakObjectPtr<UTexture>> RowTextures;
+    TArray<int32> RowObjectIndices;
+    TArray<FMeasure> RowMeasures;
+    TArray<int32> FreeRows;
+    TMap<int32, int32> ObjectIndexRows;
+    TSet<int32> VolatileRows;
+
+    // Created textures wait here until loading has finished with them
+    TSet<int32> PendingCreates;
+
+    // Recorded by the listeners (loading and GC threads), applied in GetStats
+    struct FObjectEvent
+    {
+        int32 ObjectIndex;
+        bool bCreated;
+    };
+    FCriticalSection EventsLock;
+    TArray<FObjectEvent> PendingEvents;
+
+    // One bit per object index, lets the delete listener skip non-textures without a lock
+    TUniquePtr<std::atomic<uint32>[]> TrackedBits;
+    int32 NumTrackedWords = 0;
+
+    FOptimizationTextureMemoryStats Totals;
+    bool bNeedsRebuild = true;
+    bool bListening = false;
+    int32 AuditCursor = 0;
+};
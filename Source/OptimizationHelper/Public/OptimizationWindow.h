@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
 #include "OptimizationAnalyzer.h"
+#include "OptimizationIssueTable.h"
+#include "UObject/StrongObjectPtr.h"
 #include "Widgets/Views/SListView.h"
 #include <Widgets/Notifications/SProgressBar.h>
 
@@ -11,6 +13,46 @@ template <typename NumericType>
 class SSpinBox;
 
 class SPerformanceMonitorWidget;
+class FOptimizationAnalysisJob;
+struct FOptimizationProfileEntry;
+
+// Row of the window's issue table. The list binds to row indices instead of
+// shared pointers: 4 bytes per row, text is built only for visible rows.
+struct FOptimizationIssueRow
+{
+    int32 Index = INDEX_NONE;
+
+    bool operator==(const FOptimizationIssueRow& Other) const { return Index == Other.Index; }
+    friend uint32 GetTypeHash(const FOptimizationIssueRow& Row) { return ::GetTypeHash(Row.Index); }
+};
+
+template <>
+struct TIsValidListItem<FOptimizationIssueRow>
+{
+    enum { Value = true };
+};
+
+template <>
+struct TListTypeTraits<FOptimizationIssueRow>
+{
+public:
+    typedef FOptimizationIssueRow NullableType;
+
+    using MapKeyFuncs = TDefaultMapHashableKeyFuncs<FOptimizationIssueRow, TSharedRef<ITableRow>, false>;
+    using MapKeyFuncsSparse = TDefaultMapHashableKeyFuncs<FOptimizationIssueRow, FSparseItemInfo, false>;
+    using SetKeyFuncs = DefaultKeyFuncs<FOptimizationIssueRow>;
+
+    template <typename U>
+    static void AddReferencedObjects(FReferenceCollector&, TArray<FOptimizationIssueRow>&, TSet<FOptimizationIssueRow>&, TMap<const U*, FOptimizationIssueRow>&) {}
+
+    static bool IsPtrValid(const FOptimizationIssueRow& InRow) { return InRow.Index != INDEX_NONE; }
+    static void ResetPtr(FOptimizationIssueRow& InRow) { InRow.Index = INDEX_NONE; }
+    static FOptimizationIssueRow MakeNullPtr() { return FOptimizationIssueRow(); }
+    static FOptimizationIssueRow NullableItemTypeConvertToItemType(const FOptimizationIssueRow& InRow) { return InRow; }
+    static FString DebugDump(FOptimizationIssueRow InRow) { return FString::Printf(TEXT("Row %d"), InRow.Index); }
+
+    class SerializerType {};
+};
 
 class SOptimizationWindow : public SCompoundWidget
 {
@@ -40,8 +82,20 @@ private:
     // Button handlers
     FReply OnAnalyzeClicked();
     FReply OnAnalyzeCurrentLevelClicked();
+    FReply OnCancelClicked();
     FReply OnExportClicked();
 
+    // Background analysis
+    void StartAnalysisJob(const TSharedRef<FOptimizationAnalysisJob>& Job, bool bInSortWhenFinished);
+    EActiveTimerReturnType OnAnalysisTimer(double InCurrentTime, float InDeltaTime);
+    void OnAnalysisFinished();
+    bool IsAnalysisRunning() const;
+    bool CanStartAnalysis() const;
+
+    // Results of the last session, read from the analysis cache when the window opens
+    void ShowCachedResults();
+    void SortIssues();
+
     // Filter handlers
     FReply OnFilterAll();
     FReply OnFilterCritical();
@@ -53,21 +107,36 @@ private:
     FReply OnFilterMaterials();
 
     void ApplyFilter();
+    bool PassesFilter(int32 Row) const;
+    void UpdateFilterStatus();
+
+    // Adds issues to the table (and to the list if they pass the current filter)
+    void AddIssues(TArray<FOptimizationIssue>& NewIssues);
 
     // List generation
     TSharedRef<ITableRow> OnGenerateIssueRow(
-        TSharedPtr<FOptimizationIssue> Issue,
+        FOptimizationIssueRow Row,
         const TSharedRef<STableViewBase>& OwnerTable
     );
 
     // Export functionality
     void ExportToCSV(const FString& FilePath);
 
+    // Scan Profile panel (time per phase and per rule of the last scan)
+    TSharedRef<SWidget> CreateScanProfilePanel();
+    void RefreshScanProfile();
+    TSharedRef<ITableRow> OnGenerateProfileRow(
+        TSharedPtr<FOptimizationProfileEntry> Entry,
+        const TSharedRef<STableViewBase>& OwnerTable
+    );
+
     // Settings handlers
     void OnMaxTrianglesChanged(float NewValue);
     void OnMaxTextureSizeChanged(float NewValue);
     void OnMaxBlueprintNodesChanged(float NewValue);
     void OnMaxTextureSamplesChanged(float NewValue);
+    void OnMetadataOnlyScanChanged(ECheckBoxState NewState);
+    ECheckBoxState IsMetadataOnlyScanChecked() const;
 
     void UpdateProgress(const FText& CurrentTask, float Progress);
 
@@ -75,10 +144,10 @@ private:
 
     TSharedPtr<SBox> ContentSwitcher;
     TSharedPtr<SPerformanceMonitorWidget> PerformanceMonitor;
-    TArray<TSharedPtr<FOptimizationIssue>> Issues;
-    TArray<TSharedPtr<FOptimizationIssue>> AllIssues;
-    TArray<TSharedPtr<FOptimizationIssue>> FilteredIssues;
-    TSharedPtr<SListView<TSharedPtr<FOptimizationIssue>>> IssueListView;
+    FOptimizationIssueTable IssueTable;
+    TArray<FOptimizationIssueRow> AllRows;       // Display order (sorted after a project scan)
+    TArray<FOptimizationIssueRow> FilteredRows;  // What the list shows
+    TSharedPtr<SListView<FOptimizationIssueRow>> IssueListView;
     TSharedPtr<STextBlock> StatusText;
     TSharedPtr<STextBlock> ProgressText; 
     TSharedPtr<SProgressBar> ProgressBar;
@@ -86,6 +155,9 @@ private:
     TSharedPtr<SSpinBox<float>> MaxTextureSizeSpinBox;
     TSharedPtr<SSpinBox<float>> MaxBlueprintNodesSpinBox;
     TSharedPtr<SSpinBox<float>> MaxTextureSamplesSpinBox;
+    TArray<TSharedPtr<FOptimizationProfileEntry>> ProfileEntries;
+    TSharedPtr<SListView<TSharedPtr<FOptimizationProfileEntry>>> ProfileListView;
+    TSharedPtr<STextBlock> ProfileSummaryText;
 
     // Filter state
     enum class EFilterType
@@ -102,7 +174,10 @@ private:
     EFilterType CurrentFilter;
 
     // Logic
-    UOptimizationAnalyzer* Analyzer;
+    // Kept alive across runs so its result cache survives between scans
+    TStrongObjectPtr<UOptimizationAnalyzer> Analyzer;
+    TSharedPtr<FOptimizationAnalysisJob> ActiveJob;
+    bool bSortWhenFinished = false;
 };
 
 class FOptimizationWindow
@@ -2,12 +2,20 @@
 
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
+#include "OptimizationFrameHistory.h"
 
 class SPerformanceMonitorWidget : public SCompoundWidget
 {
 public:
-    SLATE_BEGIN_ARGS(SPerformanceMonitorWidget) {}
+    SLATE_BEGIN_ARGS(SPerformanceMonitorWidget)
+        : _WindowSeconds(5.0f)
+        , _HitchThresholdsMS({ 33.3f, 50.0f, 100.0f })
+        {}
         SLATE_ARGUMENT(class UOptimizationAnalyzer*, Analyzer)
+        // Rolling window the percentiles are computed over
+        SLATE_ARGUMENT(float, WindowSeconds)
+        // Frames longer than these count as hitches (up to 4 thresholds)
+        SLATE_ARGUMENT(TArray<float>, HitchThresholdsMS)
     SLATE_END_ARGS()
 
     void Construct(const FArguments& InArgs);
@@ -19,6 +27,9 @@ private:
     // UI elements
     TSharedPtr<STextBlock> FPSText;
     TSharedPtr<STextBlock> FrameTimeText;
+    TSharedPtr<STextBlock> PercentilesText;
+    TSharedPtr<STextBlock> ThreadTimesText;
+    TSharedPtr<STextBlock> HitchesText;
     TSharedPtr<STextBlock> DrawCallsText;
     TSharedPtr<STextBlock> TrianglesText;
     TSharedPtr<STextBlock> MemoryText;
@@ -28,19 +39,29 @@ private:
     float UpdateInterval = 0.5f;  // Update every 0.5 seconds
     float TimeSinceLastUpdate = 0.0f;
 
+    // Summary of the sampler's frame history, recomputed on each update
+    FOptimizationFrameTimeSummary FrameSummary;
+    float WindowSeconds = 5.0f;
+    TArray<float> HitchThresholdsMS;
+
     // Cached stats
     float CurrentFPS = 0.0f;
     float CurrentFrameTime = 0.0f;
     int32 CurrentDrawCalls = 0;
+    bool bDrawCallsFromRenderer = false;
+    FString DrawCallsTooltip;
     int32 CurrentTriangles = 0;
     float CurrentMemoryMB = 0.0f;
     int32 CurrentStreamingTextures = 0;
+    float CurrentTextureMemoryMB = 0.0f;
+    float CurrentTextureWantedMB = 0.0f;
 
     // Reference to analyzer
     class UOptimizationAnalyzer* Analyzer = nullptr;
 
     // Helper functions
     void UpdateStats();
+    FReply OnToggleCapture();
     FLinearColor GetFPSColor(float FPS) const;
     FLinearColor GetFrameTimeColor(float MS) const;
 };
\ No newline at end of file